@@ -326,6 +326,16 @@ typedef uint16_t ByteCodeRegisterIndex;
 #define STRING_SUB_STRING_MIN_VIEW_LENGTH 32
 #endif
 
+// substring shorter than 1/RATE of its parent, which is longer than MIN_PARENT_LENGTH,
+// does not keep the parent alive (see CompactableStringView)
+#ifndef STRING_SUB_STRING_COMPACTABLE_VIEW_MIN_PARENT_LENGTH
+#define STRING_SUB_STRING_COMPACTABLE_VIEW_MIN_PARENT_LENGTH 1024 * 64
+#endif
+
+#ifndef STRING_SUB_STRING_COMPACTABLE_VIEW_MAX_LENGTH_RATE
+#define STRING_SUB_STRING_COMPACTABLE_VIEW_MAX_LENGTH_RATE 8
+#endif
+
 #ifndef STRING_BUILDER_INLINE_STORAGE_MAX
 #define STRING_BUILDER_INLINE_STORAGE_MAX 24
 #endif
@@ -334,6 +344,19 @@ typedef uint16_t ByteCodeRegisterIndex;
 #define FUNCTION_OBJECT_BYTECODE_SIZE_MAX 1024 * 1024 * 2
 #endif
 
+#ifndef REGEXP_CACHE_MAX_ENTRY_COUNT
+#define REGEXP_CACHE_MAX_ENTRY_COUNT 256
+#endif
+
+#ifndef REGEXP_CACHE_MAX_ESTIMATED_BYTES
+#define REGEXP_CACHE_MAX_ESTIMATED_BYTES 1024 * 1024 * 2
+#endif
+
+// rough memory use of a compiled pattern (YarrPattern and its bytecode) per character of its source
+#ifndef REGEXP_CACHE_ESTIMATED_BYTES_PER_SOURCE_CHARACTER
+#define REGEXP_CACHE_ESTIMATED_BYTES_PER_SOURCE_CHARACTER 96
+#endif
+
 
 #ifndef ROPE_STRING_MIN_LENGTH
 #define ROPE_STRING_MIN_LENGTH 24
@@ -26,6 +26,7 @@
 #include "parser/ScriptParser.h"
 #include "parser/CodeBlock.h"
 #include "runtime/Context.h"
+#include "runtime/ContextSnapshot.h"
 #include "runtime/ExecutionContext.h"
 #include "runtime/FunctionObject.h"
 #include "runtime/Value.h"
@@ -65,6 +66,7 @@ namespace Escargot {
 
 DEFINE_CAST(VMInstance);
 DEFINE_CAST(Context);
+DEFINE_CAST(ContextSnapshot);
 DEFINE_CAST(SandBox);
 DEFINE_CAST(ExecutionState);
 DEFINE_CAST(String);
@@ -459,6 +461,23 @@ void VMInstanceRef::clearCachesRelatedWithContext()
     imp->globalSymbolRegistry().clear();
 }
 
+VMInstanceRef::RegExpCacheStatistics VMInstanceRef::regexpCacheStatistics()
+{
+    RegExpCache::Statistics stat = toImpl(this)->m_regexpCache.statistics();
+    RegExpCacheStatistics result;
+    result.entryCount = stat.m_entryCount;
+    result.estimatedBytes = stat.m_estimatedBytes;
+    result.hitCount = stat.m_hitCount;
+    result.missCount = stat.m_missCount;
+    result.evictionCount = stat.m_evictionCount;
+    return result;
+}
+
+void VMInstanceRef::setRegExpCacheLimit(size_t maxEntryCount, size_t maxEstimatedBytes)
+{
+    toImpl(this)->m_regexpCache.setLimit(maxEntryCount, maxEstimatedBytes);
+}
+
 bool VMInstanceRef::addRoot(VMInstanceRef* instanceRef, ValueRef* ptr)
 {
     auto value = SmallValue::fromPayload(ptr);
@@ -502,6 +521,17 @@ ValueRef* VMInstanceRef::drainJobQueue()
     return toRef(imp->drainJobQueue());
 }
 
+VMInstanceRef::DrainJobQueueResult VMInstanceRef::drainJobQueue(size_t maxJobCount, uint64_t timeBudget)
+{
+    VMInstance::DrainJobQueueResult result = toImpl(this)->drainJobQueue(maxJobCount, timeBudget);
+    DrainJobQueueResult ret;
+    ret.error = toRef(result.error);
+    ret.executedJobCount = result.executedJobCount;
+    ret.remainingJobCount = result.remainingJobCount;
+    ret.elapsedTime = result.elapsedTime;
+    return ret;
+}
+
 void VMInstanceRef::setNewPromiseJobListener(NewPromiseJobListener l)
 {
     VMInstance* imp = toImpl(this);
@@ -519,20 +549,31 @@ ContextRef* ContextRef::create(VMInstanceRef* vminstanceref)
     return toRef(new Context(vminstance));
 }
 
+ContextRef* ContextRef::create(VMInstanceRef* vminstanceref, ContextSnapshotRef* snapshotref)
+{
+    VMInstance* vminstance = toImpl(vminstanceref);
+    ContextSnapshot* snapshot = toImpl(snapshotref);
+    RELEASE_ASSERT(snapshot->vmInstance() == vminstance);
+    return toRef(new Context(vminstance, snapshot));
+}
+
+ContextSnapshotRef* ContextSnapshotRef::create(VMInstanceRef* vminstanceref)
+{
+    return toRef(ContextSnapshot::create(toImpl(vminstanceref)));
+}
+
+void ContextSnapshotRef::destroy()
+{
+    ContextSnapshot* imp = toImpl(this);
+    delete imp;
+}
+
 void ContextRef::clearRelatedQueuedPromiseJobs()
 {
     Context* imp = toImpl(this);
 #ifdef ESCARGOT_ENABLE_PROMISE
     DefaultJobQueue* jobQueue = DefaultJobQueue::get(imp->vmInstance()->jobQueue());
-    std::list<Job*, gc_allocator<Job*>>& impl = jobQueue->impl();
-    auto iter = impl.begin();
-    while (iter != impl.end()) {
-        if ((*iter)->relatedContext() == imp) {
-            iter = impl.erase(iter);
-        } else {
-            iter++;
-        }
-    }
+    jobQueue->removeJobsOf(imp);
 #endif
 }
 
@@ -1060,6 +1101,11 @@ FunctionObjectRef* GlobalObjectRef::jsonParse()
     return toRef(toImpl(this)->jsonParse());
 }
 
+std::string GlobalObjectRef::jsonStringifyToUTF8(ExecutionStateRef* state, ValueRef* value)
+{
+    return toImpl(this)->jsonStringifyToUTF8(*toImpl(state), toImpl(value));
+}
+
 
 #if ESCARGOT_ENABLE_PROMISE
 FunctionObjectRef* GlobalObjectRef::promise()
@@ -1982,6 +2028,43 @@ ScriptParserRef::ScriptParserResult ScriptParserRef::parse(StringRef* script, St
     return ScriptParserRef::ScriptParserResult(toRef(result.m_script), StringRef::emptyString());
 }
 
+ScriptParserRef::ScriptParserResult ScriptParserRef::parseWithCodeCache(StringRef* script, StringRef* fileName, const char* cacheFilePath)
+{
+    auto result = toImpl(this)->parseWithCodeCache(toImpl(script), toImpl(fileName), cacheFilePath);
+    if (result.m_error) {
+        return ScriptParserRef::ScriptParserResult(nullptr, toRef(result.m_error->message));
+    }
+    return ScriptParserRef::ScriptParserResult(toRef(result.m_script), StringRef::emptyString());
+}
+
+ScriptParserRef::ScriptParserResultVector ScriptParserRef::parseWithCodeCache(const CodeCacheSourceVector& sources, size_t workerCount, CodeCacheStatistics* statistics)
+{
+    ScriptParser::CodeCacheSourceVector sourcesImpl(sources.size());
+    for (size_t i = 0; i < sources.size(); i++) {
+        sourcesImpl[i].script = toImpl(sources[i].script);
+        sourcesImpl[i].fileName = toImpl(sources[i].fileName);
+        sourcesImpl[i].cacheFilePath = sources[i].cacheFilePath;
+    }
+
+    ScriptParser::CodeCacheStatistics statisticsImpl;
+    auto results = toImpl(this)->parseWithCodeCache(sourcesImpl, workerCount, &statisticsImpl);
+    if (statistics) {
+        statistics->preScannedTokenCount = statisticsImpl.m_preScannedTokenCount;
+        statistics->replayedTokenCount = statisticsImpl.m_replayedTokenCount;
+        statistics->missedTokenCount = statisticsImpl.m_missedTokenCount;
+    }
+    ScriptParserResultVector ret;
+    ret.reserve(results.size());
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i].m_error) {
+            ret.push_back(ScriptParserRef::ScriptParserResult(nullptr, toRef(results[i].m_error->message)));
+        } else {
+            ret.push_back(ScriptParserRef::ScriptParserResult(toRef(results[i].m_script), StringRef::emptyString()));
+        }
+    }
+    return ret;
+}
+
 ValueRef* ScriptRef::execute(ExecutionStateRef* state)
 {
     return toRef(toImpl(this)->execute(*toImpl(state)));
@@ -39,6 +39,7 @@
 namespace Escargot {
 
 class VMInstanceRef;
+class ContextSnapshotRef;
 class StringRef;
 class SymbolRef;
 class ValueRef;
@@ -243,6 +244,21 @@ public:
     void destroy();
 
     void clearCachesRelatedWithContext();
+
+    // compiled RegExp patterns are cached in VMInstance and shared between Contexts
+    struct RegExpCacheStatistics {
+        size_t entryCount;
+        size_t estimatedBytes; // estimated from length of pattern sources, not measured memory use
+        size_t hitCount;
+        size_t missCount;
+        size_t evictionCount;
+    };
+    RegExpCacheStatistics regexpCacheStatistics();
+    // least recently used patterns are dropped from the cache to keep its entry count and estimated size in these limits
+    // this caps the cache only. memory of a dropped pattern is not released by dropping it,
+    // because its Yarr bytecode is allocated from the BumpPointerAllocator of Context
+    void setRegExpCacheLimit(size_t maxEntryCount, size_t maxEstimatedBytes);
+
     bool addRoot(VMInstanceRef* instanceRef, ValueRef* ptr);
     bool removeRoot(VMInstanceRef* instanceRef, ValueRef* ptr);
 
@@ -255,14 +271,35 @@ public:
     // if thres is no job or no error, returns EmptyValue
     ValueRef* drainJobQueue();
 
+    struct DrainJobQueueResult {
+        ValueRef* error; // EmptyValue if there was no error
+        size_t executedJobCount;
+        size_t remainingJobCount;
+        uint64_t elapsedTime; // in microseconds
+    };
+    // runs jobs until the queue is empty, an error occurs, maxJobCount jobs are executed or timeBudget(microseconds) is spent.
+    // 0 means no limit. embedder can call this repeatedly between other tasks
+    DrainJobQueueResult drainJobQueue(size_t maxJobCount, uint64_t timeBudget);
+
     typedef void (*NewPromiseJobListener)(ExecutionStateRef* state, JobRef* job);
     void setNewPromiseJobListener(NewPromiseJobListener l);
 #endif
 };
 
+// ContextSnapshot holds builtins installed once, and copies them into new Contexts.
+// Creating a Context from snapshot is cheaper than installing every builtin again.
+// Snapshot can be used only with Contexts of the VMInstance it is created from
+class EXPORT ContextSnapshotRef {
+public:
+    // returns nullptr if builtins of this build cannot be copied
+    static ContextSnapshotRef* create(VMInstanceRef* vmInstance);
+    void destroy();
+};
+
 class EXPORT ContextRef {
 public:
     static ContextRef* create(VMInstanceRef* vmInstance);
+    static ContextRef* create(VMInstanceRef* vmInstance, ContextSnapshotRef* snapshot);
     void clearRelatedQueuedPromiseJobs();
     void destroy();
 
@@ -580,6 +617,8 @@ public:
     ObjectRef* json();
     FunctionObjectRef* jsonStringify();
     FunctionObjectRef* jsonParse();
+    // JSON.stringify(value) as UTF-8 bytes. returns empty string if the result is undefined
+    std::string jsonStringifyToUTF8(ExecutionStateRef* state, ValueRef* value);
 
 #if ESCARGOT_ENABLE_PROMISE
     FunctionObjectRef* promise();
@@ -907,6 +946,28 @@ public:
     };
 
     ScriptParserResult parse(StringRef* script, StringRef* fileName);
+    // reuses the global code stored in cacheFilePath if it was made from the same script by this build,
+    // otherwise parses script and (re)writes cacheFilePath
+    ScriptParserResult parseWithCodeCache(StringRef* script, StringRef* fileName, const char* cacheFilePath);
+
+    struct CodeCacheSource {
+        StringRef* script;
+        StringRef* fileName;
+        const char* cacheFilePath; // can be nullptr
+    };
+    // vectors are allocated in GC heap, so scripts are kept alive until the embedder runs them
+    typedef std::vector<CodeCacheSource, GCUtil::gc_malloc_allocator<CodeCacheSource>> CodeCacheSourceVector;
+    typedef std::vector<ScriptParserResult, GCUtil::gc_malloc_allocator<ScriptParserResult>> ScriptParserResultVector;
+    // same as calling parseWithCodeCache for each source, but cache files are read and validated on workerCount threads,
+    // and sources without valid caches are pre-scanned into tokens there. workers do not touch GC heap.
+    // loading and parsing are done on calling thread in order of sources
+    struct CodeCacheStatistics {
+        size_t preScannedTokenCount;
+        size_t replayedTokenCount; // pre-scanned tokens used by parser instead of scanning sources again
+        size_t missedTokenCount; // lookups of parser which found no usable pre-scanned token
+    };
+    // statistics can be nullptr
+    ScriptParserResultVector parseWithCodeCache(const CodeCacheSourceVector& sources, size_t workerCount, CodeCacheStatistics* statistics = nullptr);
 };
 
 class EXPORT ScriptRef {
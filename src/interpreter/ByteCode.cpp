@@ -173,12 +173,25 @@ void* EnumerateObjectData::operator new(size_t size)
     static GC_descr descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(EnumerateObjectData)] = { 0 };
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectData, m_hiddenClassChain));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectData, m_keyData));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectData, m_object));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectData, m_keys));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(EnumerateObjectData));
         typeInited = true;
     }
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
+
+void* EnumerateObjectKeys::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(EnumerateObjectKeys)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectKeys, m_hiddenClassChain));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectKeys, m_keys));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(EnumerateObjectKeys));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
 }
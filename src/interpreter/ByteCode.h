@@ -96,6 +96,7 @@ class Node;
     F(JumpIfFalse, 0, 0)                              \
     F(JumpIfRelation, 0, 0)                           \
     F(JumpIfEqual, 0, 0)                              \
+    F(SwitchJumpTable, 0, 0)                          \
     F(CallFunction, -1, 0)                            \
     F(CallFunctionWithReceiver, -1, 0)                \
     F(CallFunctionWithSpreadElement, -1, 0)           \
@@ -255,6 +256,27 @@ public:
 #endif
 };
 
+// position of binding found by LoadByName/StoreByName
+// environments of same bytecode have same shape, except records which have dynamic bindings
+struct ByNameCache {
+    ByNameCache()
+        : m_hopCount(SIZE_MAX)
+        , m_slotIndex(SIZE_MAX)
+    {
+    }
+
+    void reset()
+    {
+        m_hopCount = SIZE_MAX;
+        m_slotIndex = SIZE_MAX;
+    }
+
+    // number of outer environments to skip. SIZE_MAX means empty cache
+    size_t m_hopCount;
+    // index of binding in the record. SIZE_MAX means lookup by name (global environment)
+    size_t m_slotIndex;
+};
+
 class LoadByName : public ByteCode {
 public:
     LoadByName(const ByteCodeLOC& loc, const size_t registerIndex, const AtomicString& name)
@@ -265,6 +287,7 @@ public:
     }
     ByteCodeRegisterIndex m_registerIndex;
     AtomicString m_name;
+    ByNameCache m_cache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -284,6 +307,7 @@ public:
     }
     ByteCodeRegisterIndex m_registerIndex;
     AtomicString m_name;
+    ByNameCache m_cache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -682,53 +706,34 @@ public:
     }
 };
 
-typedef std::vector<ObjectStructureChainItem, std::allocator<ObjectStructureChainItem>> ObjectStructureChain;
 typedef std::vector<ObjectStructureChainItem, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<ObjectStructureChainItem>> ObjectStructureChainGC;
 typedef Vector<ObjectStructureChainItem, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureChainItem>, 200> ObjectStructureChainWithGC;
 
-struct GetObjectInlineCacheData {
-    GetObjectInlineCacheData()
-    {
-        m_cachedIndex = SIZE_MAX;
-    }
-
-    GetObjectInlineCacheData(const GetObjectInlineCacheData& src)
-    {
-        m_cachedhiddenClassChain = src.m_cachedhiddenClassChain;
-        m_cachedIndex = src.m_cachedIndex;
-    }
-
-    GetObjectInlineCacheData(GetObjectInlineCacheData&& src)
-    {
-        m_cachedhiddenClassChain = std::move(src.m_cachedhiddenClassChain);
-        m_cachedIndex = src.m_cachedIndex;
-    }
+#define GET_OBJECT_INLINE_CACHE_ENTRY_COUNT 4
 
-    GetObjectInlineCacheData& operator=(const GetObjectInlineCacheData& src)
-    {
-        if (&src == this)
-            return *this;
-
-        m_cachedhiddenClassChain = src.m_cachedhiddenClassChain;
-        m_cachedIndex = src.m_cachedIndex;
-        return *this;
-    }
-
-    ObjectStructureChain m_cachedhiddenClassChain;
+// property is own property of receiver if m_prototypeStructure is nullptr
+// otherwise property is in the prototype of receiver,
+// or is absent when m_cachedIndex is SIZE_MAX (prototype of prototype is null)
+struct GetObjectInlineCacheEntry {
+    ObjectStructure* m_structure;
+    ObjectStructure* m_prototypeStructure;
     size_t m_cachedIndex;
 };
 
-typedef std::vector<GetObjectInlineCacheData, std::allocator<GetObjectInlineCacheData>> GetObjectInlineCacheDataVector;
-
+// lookups which do not fit into entries (deeper prototype chain, or too many structures)
+// go to the ObjectStructureLookupCache of VMInstance
 struct GetObjectInlineCache {
     GetObjectInlineCache()
+        : m_executeCount(0)
+        , m_entryCount(0)
+        , m_isMegamorphic(false)
     {
-        m_cacheMissCount = m_executeCount = 0;
     }
 
-    GetObjectInlineCacheDataVector m_cache;
+    GetObjectInlineCacheEntry m_entries[GET_OBJECT_INLINE_CACHE_ENTRY_COUNT];
     uint16_t m_executeCount;
-    uint16_t m_cacheMissCount;
+    uint8_t m_entryCount;
+    bool m_isMegamorphic;
 };
 
 class GetObjectPreComputedCase : public ByteCode {
@@ -1339,6 +1344,118 @@ public:
 #endif
 };
 
+#define SWITCH_JUMP_TABLE_MIN_CASE_COUNT 4
+// int32 table is used when (max - min + 1) <= count * SWITCH_JUMP_TABLE_MAX_INT32_HOLE_RATE
+#define SWITCH_JUMP_TABLE_MAX_INT32_HOLE_RATE 2
+
+// case positions of switch statement whose tests are all int32 literals in a dense range or all string literals
+// positions are relative to the start of bytecode, SIZE_MAX means there is no matching case
+class SwitchJumpTableData : public gc {
+public:
+    SwitchJumpTableData(bool isStringTable, int32_t minimum)
+        : m_isStringTable(isStringTable)
+        , m_minimum(minimum)
+    {
+    }
+
+    size_t findPosition(const Value& v)
+    {
+        if (m_isStringTable) {
+            if (v.isString()) {
+                return findStringPosition(v.asString());
+            }
+        } else if (v.isInt32()) {
+            return findInt32Position(v.asInt32());
+        } else if (v.isNumber()) {
+            // -0 and integral doubles are equal to int32 cases
+            double d = v.asNumber();
+            if (d >= std::numeric_limits<int32_t>::min() && d <= std::numeric_limits<int32_t>::max() && (double)(int32_t)d == d) {
+                return findInt32Position((int32_t)d);
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    size_t findInt32Position(int32_t v)
+    {
+        ASSERT(!m_isStringTable);
+        size_t idx = (size_t)((int64_t)v - (int64_t)m_minimum);
+        if (idx < m_positions.size()) {
+            return m_positions[idx];
+        }
+        return SIZE_MAX;
+    }
+
+    size_t findStringPosition(String* str)
+    {
+        ASSERT(m_isStringTable);
+        size_t mask = m_keys.size() - 1;
+        size_t hash = str->hashValue();
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            String* key = m_keys[i];
+            if (!key) {
+                return SIZE_MAX;
+            }
+            if (key->hashValue() == hash && key->equals(str)) {
+                return m_positions[i];
+            }
+        }
+    }
+
+    // first insertion wins like strict equal tests of switch
+    void addInt32(int32_t v, size_t position)
+    {
+        size_t idx = (size_t)((int64_t)v - (int64_t)m_minimum);
+        if (m_positions[idx] == SIZE_MAX) {
+            m_positions[idx] = position;
+        }
+    }
+
+    void addString(String* str, size_t position)
+    {
+        size_t mask = m_keys.size() - 1;
+        size_t hash = str->hashValue();
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            if (!m_keys[i]) {
+                m_keys[i] = str;
+                m_positions[i] = position;
+                return;
+            }
+            if (m_keys[i]->equals(str)) {
+                return;
+            }
+        }
+    }
+
+    bool m_isStringTable;
+    int32_t m_minimum;
+    // int32 table: position for (m_minimum + index)
+    // string table: open addressing hash table which has power of two size. empty slot has nullptr key
+    Vector<size_t, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<size_t>> m_positions;
+    Vector<String*, GCUtil::gc_malloc_ignore_off_page_allocator<String*>> m_keys;
+};
+
+// jumps to the case matched in m_table, or to the next bytecode
+class SwitchJumpTable : public ByteCode {
+public:
+    SwitchJumpTable(const ByteCodeLOC& loc, const size_t registerIndex, SwitchJumpTableData* table)
+        : ByteCode(Opcode::SwitchJumpTableOpcode, loc)
+        , m_registerIndex(registerIndex)
+        , m_table(table)
+    {
+    }
+
+    ByteCodeRegisterIndex m_registerIndex;
+    SwitchJumpTableData* m_table;
+
+#ifndef NDEBUG
+    void dump(const char* byteCodeStart)
+    {
+        printf("switch jump table (%s) r%d", m_table->m_isStringTable ? "string" : "int32", (int)m_registerIndex);
+    }
+#endif
+};
+
 class CallFunction : public ByteCode {
 public:
     CallFunction(const ByteCodeLOC& loc, const size_t calleeIndex, const size_t argumentsStartIndex, const size_t argumentCount, const size_t resultIndex)
@@ -1655,20 +1772,38 @@ public:
 #endif
 };
 
+// keys of for-in, with structures of the object and its prototype chain when the keys are collected
+// it can be cached in ObjectStructure of the object (ObjectStructure::m_enumerationCache)
+// and shared by for-in over other objects. so it should not be modified after creation
+// structures are shared between Contexts, so it should not refer objects (e.g. prototype objects).
+// it would keep the Context of the objects alive
+class EnumerateObjectKeys : public gc {
+public:
+    EnumerateObjectKeys()
+    {
+    }
+
+    ObjectStructureChainWithGC m_hiddenClassChain;
+    SmallValueVector m_keys;
+
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+};
+
 class EnumerateObjectData : public PointerValue {
 public:
     EnumerateObjectData()
     {
+        m_keyData = nullptr;
         m_object = nullptr;
         m_originalLength = 0;
         m_idx = 0;
     }
 
-    ObjectStructureChainWithGC m_hiddenClassChain;
+    EnumerateObjectKeys* m_keyData;
     Object* m_object;
     uint64_t m_originalLength;
     size_t m_idx;
-    SmallValueVector m_keys;
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
@@ -1936,11 +2071,6 @@ public:
     {
         GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
             ByteCodeBlock* self = (ByteCodeBlock*)obj;
-            for (size_t i = 0; i < self->m_getObjectCodePositions.size(); i++) {
-                GetObjectInlineCacheDataVector().swap(((GetObjectPreComputedCase*)((size_t)self->m_code.data() + self->m_getObjectCodePositions[i]))->m_inlineCache.m_cache);
-            }
-            std::vector<size_t>().swap(self->m_getObjectCodePositions);
-
             self->m_numeralLiteralData.clear();
             self->m_code.clear();
             if (self->m_locData)
@@ -2007,7 +2137,6 @@ public:
         siz += m_locData ? (m_locData->size() * sizeof(std::pair<size_t, size_t>)) : 0;
         siz += m_literalData.size() * sizeof(size_t);
         siz += m_objectStructuresInUse->size() * sizeof(size_t);
-        siz += m_getObjectCodePositions.size() * sizeof(size_t);
         return siz;
     }
 
@@ -2028,8 +2157,6 @@ public:
     ByteCodeLOCData* m_locData;
     InterpretedCodeBlock* m_codeBlock;
 
-    std::vector<size_t> m_getObjectCodePositions;
-
     void* operator new(size_t size);
 };
 } // namespace Escargot
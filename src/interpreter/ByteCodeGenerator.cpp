@@ -240,8 +240,6 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
 
     block->m_code.shrinkToFit();
 
-    block->m_getObjectCodePositions = std::move(ctx.m_getObjectCodePositions);
-
     {
         ByteCodeRegisterIndex stackBase = REGULAR_REGISTER_LIMIT;
         ByteCodeRegisterIndex stackBaseWillBe = block->m_requiredRegisterFileSizeInValueSize;
@@ -497,6 +495,11 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                 assignStackIndexIfNeeded(cd->m_registerIndex1, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case SwitchJumpTableOpcode: {
+                SwitchJumpTable* cd = (SwitchJumpTable*)currentCode;
+                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
             case ThrowOperationOpcode: {
                 ThrowOperation* cd = (ThrowOperation*)currentCode;
                 assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -41,6 +41,10 @@
 #include "runtime/ProxyObject.h"
 #endif
 
+#if ESCARGOT_ENABLE_TYPEDARRAY
+#include "runtime/TypedArrayObject.h"
+#endif
+
 namespace Escargot {
 
 #define ADD_PROGRAM_COUNTER(CodeType) programCounter += sizeof(CodeType);
@@ -55,6 +59,26 @@ ALWAYS_INLINE size_t resolveProgramCounter(char* codeBuffer, const size_t progra
     return programCounter - (size_t)codeBuffer;
 }
 
+// returns environment which has the binding of `cache`, or nullptr if cache cannot be used
+ALWAYS_INLINE LexicalEnvironment* lookupByNameCache(LexicalEnvironment* env, const ByNameCache& cache)
+{
+    size_t hopCount = cache.m_hopCount;
+    if (hopCount == SIZE_MAX) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < hopCount; i++) {
+        if (UNLIKELY(env->record()->hasDynamicBindings())) {
+            return nullptr;
+        }
+        env = env->outerEnvironment();
+        ASSERT(env);
+    }
+    if (UNLIKELY(env->record()->hasDynamicBindings())) {
+        return nullptr;
+    }
+    return env;
+}
+
 Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile)
 {
 #if defined(COMPILER_GCC)
@@ -408,7 +432,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                     if (LIKELY(arr->isFastModeArray())) {
                         uint32_t idx = property.tryToUseAsArrayIndex(state);
                         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < arr->getArrayLength(state))) {
-                            const Value& v = arr->m_fastModeData[idx];
+                            const Value& v = arr->getFastModeElement(idx);
                             if (LIKELY(!v.isEmpty())) {
                                 registerFile[code->m_storeRegisterIndex] = v;
                                 ADD_PROGRAM_COUNTER(GetObject);
@@ -417,6 +441,12 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                         }
                     }
                 }
+#if ESCARGOT_ENABLE_TYPEDARRAY
+                if (willBeObject.isObject() && TypedArrayFastAccess::getElement(willBeObject.asPointerValue(), property, registerFile[code->m_storeRegisterIndex])) {
+                    ADD_PROGRAM_COUNTER(GetObject);
+                    NEXT_INSTRUCTION();
+                }
+#endif
                 JUMP_INSTRUCTION(GetObjectOpcodeSlowCase);
             }
 
@@ -440,12 +470,18 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                                     JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
                                 }
                             }
-                            arr->m_fastModeData[idx] = registerFile[code->m_loadRegisterIndex];
+                            arr->setFastModeElement(state, idx, registerFile[code->m_loadRegisterIndex]);
                             ADD_PROGRAM_COUNTER(SetObjectOperation);
                             NEXT_INSTRUCTION();
                         }
                     }
                 }
+#if ESCARGOT_ENABLE_TYPEDARRAY
+                if (willBeObject.isObject() && TypedArrayFastAccess::setElement(state, willBeObject.asPointerValue(), property, registerFile[code->m_loadRegisterIndex])) {
+                    ADD_PROGRAM_COUNTER(SetObjectOperation);
+                    NEXT_INSTRUCTION();
+                }
+#endif
                 JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
             }
 
@@ -527,6 +563,19 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 NEXT_INSTRUCTION();
             }
 
+            DEFINE_OPCODE(SwitchJumpTable)
+                :
+            {
+                SwitchJumpTable* code = (SwitchJumpTable*)programCounter;
+                size_t position = code->m_table->findPosition(registerFile[code->m_registerIndex]);
+                if (position == SIZE_MAX) {
+                    ADD_PROGRAM_COUNTER(SwitchJumpTable);
+                } else {
+                    programCounter = jumpTo(codeBuffer, position);
+                }
+                NEXT_INSTRUCTION();
+            }
+
             DEFINE_OPCODE(JumpIfTrue)
                 :
             {
@@ -558,7 +607,15 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
             {
                 CallFunction* code = (CallFunction*)programCounter;
                 const Value& callee = registerFile[code->m_calleeIndex];
-                registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                if (UNLIKELY(state.hasRareData() && state.rareData()->m_handlerFrameDepth)) {
+                    Value result = callFunctionInHandlerFrame(state, callee, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                    if (UNLIKELY(state.rareData()->m_hasPendingException)) {
+                        return returnExceptionToTryOperation(state, result, ec, byteCodeBlock, programCounter);
+                    }
+                    registerFile[code->m_resultIndex] = result;
+                } else {
+                    registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                }
                 ADD_PROGRAM_COUNTER(CallFunction);
                 NEXT_INSTRUCTION();
             }
@@ -569,7 +626,15 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 CallFunctionWithReceiver* code = (CallFunctionWithReceiver*)programCounter;
                 const Value& callee = registerFile[code->m_calleeIndex];
                 const Value& receiver = registerFile[code->m_receiverIndex];
-                registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                if (UNLIKELY(state.hasRareData() && state.rareData()->m_handlerFrameDepth)) {
+                    Value result = callFunctionInHandlerFrame(state, callee, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                    if (UNLIKELY(state.rareData()->m_hasPendingException)) {
+                        return returnExceptionToTryOperation(state, result, ec, byteCodeBlock, programCounter);
+                    }
+                    registerFile[code->m_resultIndex] = result;
+                } else {
+                    registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                }
                 ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
                 NEXT_INSTRUCTION();
             }
@@ -784,7 +849,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                     size_t end = code->m_count + code->m_baseIndex;
                     for (size_t i = 0; i < code->m_count; i++) {
                         if (LIKELY(code->m_loadRegisterIndexs[i] != REGISTER_LIMIT)) {
-                            arr->m_fastModeData[i + code->m_baseIndex] = registerFile[code->m_loadRegisterIndexs[i]];
+                            arr->setFastModeElement(state, i + code->m_baseIndex, registerFile[code->m_loadRegisterIndexs[i]]);
                         }
                     }
                 } else {
@@ -913,7 +978,16 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 LoadByName* code = (LoadByName*)programCounter;
-                registerFile[code->m_registerIndex] = loadByName(state, ec->lexicalEnvironment(), code->m_name);
+                LexicalEnvironment* env = lookupByNameCache(ec->lexicalEnvironment(), code->m_cache);
+                if (LIKELY(env != nullptr)) {
+                    if (LIKELY(code->m_cache.m_slotIndex != SIZE_MAX)) {
+                        registerFile[code->m_registerIndex] = env->record()->getBindingValue(state, code->m_cache.m_slotIndex);
+                    } else {
+                        registerFile[code->m_registerIndex] = loadByName(state, env, code->m_name);
+                    }
+                } else {
+                    registerFile[code->m_registerIndex] = loadByNameSlowCase(state, ec->lexicalEnvironment(), code->m_name, code->m_cache);
+                }
                 ADD_PROGRAM_COUNTER(LoadByName);
                 NEXT_INSTRUCTION();
             }
@@ -922,7 +996,16 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 StoreByName* code = (StoreByName*)programCounter;
-                storeByName(state, ec->lexicalEnvironment(), code->m_name, registerFile[code->m_registerIndex]);
+                LexicalEnvironment* env = lookupByNameCache(ec->lexicalEnvironment(), code->m_cache);
+                if (LIKELY(env != nullptr)) {
+                    if (LIKELY(code->m_cache.m_slotIndex != SIZE_MAX)) {
+                        env->record()->setMutableBindingByIndex(state, code->m_cache.m_slotIndex, code->m_name, registerFile[code->m_registerIndex]);
+                    } else {
+                        storeByName(state, env, code->m_name, registerFile[code->m_registerIndex]);
+                    }
+                } else {
+                    storeByNameSlowCase(state, ec->lexicalEnvironment(), code->m_name, registerFile[code->m_registerIndex], code->m_cache);
+                }
                 ADD_PROGRAM_COUNTER(StoreByName);
                 NEXT_INSTRUCTION();
             }
@@ -1011,6 +1094,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                             programCounter = jumpTo(codeBuffer, pos);
                         }
                     } else if (record->reason() == ControlFlowRecord::NeedsThrow) {
+                        if (state.rareData()->m_handlerFrameDepth) {
+                            return returnExceptionToTryOperation(state, record->value(), ec, byteCodeBlock, programCounter);
+                        }
                         state.context()->throwException(state, record->value());
                     } else if (record->reason() == ControlFlowRecord::NeedsReturn) {
                         record->m_count--;
@@ -1031,6 +1117,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 ThrowOperation* code = (ThrowOperation*)programCounter;
+                if (state.hasRareData() && state.rareData()->m_handlerFrameDepth) {
+                    return returnExceptionToTryOperation(state, registerFile[code->m_registerIndex], ec, byteCodeBlock, programCounter);
+                }
                 state.context()->throwException(state, registerFile[code->m_registerIndex]);
             }
 
@@ -1076,8 +1165,8 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 EnumerateObjectData* data = (EnumerateObjectData*)registerFile[code->m_registerIndex].asPointerValue();
                 bool shouldUpdateEnumerateObjectData = false;
                 Object* obj = data->m_object;
-                for (size_t i = 0; i < data->m_hiddenClassChain.size(); i++) {
-                    auto hc = data->m_hiddenClassChain[i];
+                for (size_t i = 0; i < data->m_keyData->m_hiddenClassChain.size(); i++) {
+                    auto hc = data->m_keyData->m_hiddenClassChain[i];
                     ObjectStructureChainItem testItem;
                     testItem.m_objectStructure = obj->structure();
                     if (hc != testItem) {
@@ -1104,7 +1193,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                     data = (EnumerateObjectData*)registerFile[code->m_registerIndex].asPointerValue();
                 }
 
-                if (data->m_keys.size() <= data->m_idx) {
+                if (data->m_keyData->m_keys.size() <= data->m_idx) {
                     programCounter = jumpTo(codeBuffer, code->m_forInEndPosition);
                 } else {
                     ADD_PROGRAM_COUNTER(CheckIfKeyIsLast);
@@ -1118,7 +1207,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 EnumerateObjectKey* code = (EnumerateObjectKey*)programCounter;
                 EnumerateObjectData* data = (EnumerateObjectData*)registerFile[code->m_dataRegisterIndex].asPointerValue();
                 data->m_idx++;
-                registerFile[code->m_registerIndex] = Value(data->m_keys[data->m_idx - 1]).toString(state);
+                registerFile[code->m_registerIndex] = Value(data->m_keyData->m_keys[data->m_idx - 1]).toString(state);
                 ADD_PROGRAM_COUNTER(EnumerateObjectKey);
                 NEXT_INSTRUCTION();
             }
@@ -1325,18 +1414,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
             DEFINE_DEFAULT
 
         } catch (const Value& v) {
-            if (ec->isOnGoingClassConstruction()) {
-                ec->setOnGoingClassConstruction(false);
-                ec->m_lexicalEnvironment = ec->lexicalEnvironment()->outerEnvironment();
-            }
-
-            if (ec->isOnGoingSuperCall()) {
-                ec->setOnGoingSuperCall(false);
-            }
-
-            if (byteCodeBlock->m_codeBlock->isInterpretedCodeBlock() && byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr) {
-                byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlock = byteCodeBlock;
-            }
+            leaveFrameByException(ec, byteCodeBlock);
             processException(state, v, ec, programCounter);
         }
     }
@@ -1409,6 +1487,52 @@ NEVER_INLINE void ByteCodeInterpreter::storeByName(ExecutionState& state, Lexica
     o->setThrowsExceptionWhenStrictMode(state, name, value, o);
 }
 
+// fills `cache` while walking environments. records with dynamic bindings are walked without cache
+NEVER_INLINE Value ByteCodeInterpreter::loadByNameSlowCase(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, ByNameCache& cache)
+{
+    cache.reset();
+    for (size_t hopCount = 0; env; hopCount++, env = env->outerEnvironment()) {
+        EnvironmentRecord* record = env->record();
+        if (UNLIKELY(record->hasDynamicBindings())) {
+            break;
+        }
+        if (record->isGlobalEnvironmentRecord()) {
+            cache.m_hopCount = hopCount;
+            break;
+        }
+        auto result = record->hasBinding(state, name);
+        if (result.m_index != SIZE_MAX) {
+            cache.m_hopCount = hopCount;
+            cache.m_slotIndex = result.m_index;
+            return record->getBindingValue(state, result.m_index);
+        }
+    }
+    return loadByName(state, env, name);
+}
+
+NEVER_INLINE void ByteCodeInterpreter::storeByNameSlowCase(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, const Value& value, ByNameCache& cache)
+{
+    cache.reset();
+    for (size_t hopCount = 0; env; hopCount++, env = env->outerEnvironment()) {
+        EnvironmentRecord* record = env->record();
+        if (UNLIKELY(record->hasDynamicBindings())) {
+            break;
+        }
+        if (record->isGlobalEnvironmentRecord()) {
+            cache.m_hopCount = hopCount;
+            break;
+        }
+        auto result = record->hasBinding(state, name);
+        if (result.m_index != SIZE_MAX) {
+            cache.m_hopCount = hopCount;
+            cache.m_slotIndex = result.m_index;
+            record->setMutableBindingByIndex(state, result.m_index, name, value);
+            return;
+        }
+    }
+    storeByName(state, env, name, value);
+}
+
 NEVER_INLINE Value ByteCodeInterpreter::plusSlowCase(ExecutionState& state, const Value& left, const Value& right)
 {
     Value ret(Value::ForceUninitialized);
@@ -1633,94 +1757,82 @@ NEVER_INLINE bool ByteCodeInterpreter::abstractRelationalComparisonOrEqualSlowCa
 
 ALWAYS_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperation(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name, GetObjectInlineCache& inlineCache, ByteCodeBlock* block)
 {
-    Object* orgObj = obj;
-    const size_t cacheFillCount = inlineCache.m_cache.size();
-    GetObjectInlineCacheData* cacheData = inlineCache.m_cache.data();
-    unsigned currentCacheIndex = 0;
-TestCache:
-    for (; currentCacheIndex < cacheFillCount; currentCacheIndex++) {
-        obj = orgObj;
-        GetObjectInlineCacheData& data = cacheData[currentCacheIndex];
-        const size_t cSiz = data.m_cachedhiddenClassChain.size() - 1;
-        ObjectStructureChainItem* cachedHiddenClassChain = data.m_cachedhiddenClassChain.data();
-        size_t cachedIndex = data.m_cachedIndex;
-        size_t i;
-        for (i = 0; i < cSiz; i++) {
-            if (cachedHiddenClassChain[i].m_objectStructure != obj->structure()) {
-                currentCacheIndex++;
-                goto TestCache;
-            }
-            Object* protoObject = obj->getPrototypeObject(state);
-            if (protoObject != nullptr) {
-                obj = protoObject;
-            } else {
-                currentCacheIndex++;
-                goto TestCache;
-            }
+    ObjectStructure* structure = obj->structure();
+    const size_t entryCount = inlineCache.m_entryCount;
+    for (size_t i = 0; i < entryCount; i++) {
+        const GetObjectInlineCacheEntry& entry = inlineCache.m_entries[i];
+        if (entry.m_structure != structure) {
+            continue;
         }
 
-        if (LIKELY(cachedHiddenClassChain[cSiz].m_objectStructure == obj->structure())) {
-            if (LIKELY(data.m_cachedIndex != SIZE_MAX)) {
-                return obj->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
-            } else {
+        if (LIKELY(entry.m_prototypeStructure == nullptr)) {
+            return obj->getOwnPropertyUtilForObject(state, entry.m_cachedIndex, receiver);
+        }
+
+        Object* protoObject = obj->getPrototypeObject(state);
+        if (LIKELY(protoObject != nullptr && protoObject->structure() == entry.m_prototypeStructure)) {
+            if (LIKELY(entry.m_cachedIndex != SIZE_MAX)) {
+                return protoObject->getOwnPropertyUtilForObject(state, entry.m_cachedIndex, receiver);
+            } else if (protoObject->getPrototypeObject(state) == nullptr) {
                 return Value();
             }
         }
     }
 
-    return getObjectPrecomputedCaseOperationCacheMiss(state, orgObj, receiver, name, inlineCache, block);
+    return getObjectPrecomputedCaseOperationCacheMiss(state, obj, receiver, name, inlineCache, block);
 }
 
 NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name, GetObjectInlineCache& inlineCache, ByteCodeBlock* block)
 {
-    const int maxCacheMissCount = 16;
     const int minCacheFillCount = 3;
-    const size_t maxCacheCount = 10;
     // cache miss.
-    inlineCache.m_executeCount++;
-    if (inlineCache.m_executeCount <= minCacheFillCount) {
-        return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
-    }
-
-    if (inlineCache.m_cache.size())
-        inlineCache.m_cacheMissCount++;
-
-    if (inlineCache.m_cache.size() > maxCacheCount) {
-        return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
-    }
-
-    if (UNLIKELY(!obj->isInlineCacheable())) {
+    if (inlineCache.m_executeCount < minCacheFillCount) {
+        inlineCache.m_executeCount++;
         return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
     }
 
-    Object* orgObj = obj;
-    inlineCache.m_cache.insert(inlineCache.m_cache.begin(), GetObjectInlineCacheData());
-
-    ObjectStructureChain* cachedHiddenClassChain = &inlineCache.m_cache[0].m_cachedhiddenClassChain;
-
-    ObjectStructureChainItem newItem;
+    // find the holder of property through the lookup cache of VMInstance
+    ObjectStructureLookupCache& lookupCache = state.context()->vmInstance()->structureLookupCache();
+    Object* holder = obj;
+    size_t depth = 0;
+    size_t idx;
     while (true) {
-        newItem.m_objectStructure = obj->structure();
-
-        cachedHiddenClassChain->push_back(newItem);
-        size_t idx = obj->structure()->findProperty(state, name);
-
-        if (!obj->structure()->isProtectedByTransitionTable()) {
-            block->m_objectStructuresInUse->insert(obj->structure());
+        if (UNLIKELY(!holder->isInlineCacheable())) {
+            return holder->get(state, ObjectPropertyName(state, name)).value(state, receiver);
         }
-
+        idx = lookupCache.findProperty(holder->structure(), name);
         if (idx != SIZE_MAX) {
-            inlineCache.m_cache[0].m_cachedIndex = idx;
             break;
         }
-        obj = obj->getPrototypeObject(state);
-        if (!obj) {
+        Object* protoObject = holder->getPrototypeObject(state);
+        if (!protoObject) {
             break;
         }
+        holder = protoObject;
+        depth++;
     }
 
-    if (inlineCache.m_cache[0].m_cachedIndex != SIZE_MAX) {
-        return obj->getOwnPropertyUtilForObject(state, inlineCache.m_cache[0].m_cachedIndex, receiver);
+    // own property, or property (or absence of it) on the prototype fits into an entry
+    if (!inlineCache.m_isMegamorphic && (depth == 1 || (depth == 0 && idx != SIZE_MAX))) {
+        if (inlineCache.m_entryCount < GET_OBJECT_INLINE_CACHE_ENTRY_COUNT) {
+            GetObjectInlineCacheEntry& entry = inlineCache.m_entries[inlineCache.m_entryCount++];
+            entry.m_structure = obj->structure();
+            entry.m_prototypeStructure = depth ? holder->structure() : nullptr;
+            entry.m_cachedIndex = idx;
+
+            if (!obj->structure()->isProtectedByTransitionTable()) {
+                block->m_objectStructuresInUse->insert(obj->structure());
+            }
+            if (depth && !holder->structure()->isProtectedByTransitionTable()) {
+                block->m_objectStructuresInUse->insert(holder->structure());
+            }
+        } else {
+            inlineCache.m_isMegamorphic = true;
+        }
+    }
+
+    if (idx != SIZE_MAX) {
+        return holder->getOwnPropertyUtilForObject(state, idx, receiver);
     } else {
         return Value();
     }
@@ -1850,6 +1962,27 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
     }
 }
 
+// keys of these objects come only from their structure
+static ALWAYS_INLINE bool canUseEnumerationCache(Object* obj)
+{
+    size_t tag = *((size_t*)obj);
+    return tag == g_objectTag || tag == g_functionObjectTag;
+}
+
+bool ByteCodeInterpreter::checkEnumerationCache(ExecutionState& state, Object* obj, EnumerateObjectKeys* keyData)
+{
+    // keys of objects in the chain come only from their structures,
+    // so same structures in the chain mean same keys even if prototype objects are different
+    size_t len = keyData->m_hiddenClassChain.size();
+    for (size_t i = 1; i < len; i++) {
+        obj = obj->getPrototypeObject(state);
+        if (!obj || !canUseEnumerationCache(obj) || obj->structure() != keyData->m_hiddenClassChain[i].m_objectStructure) {
+            return false;
+        }
+    }
+    return obj->getPrototypeObject(state) == nullptr;
+}
+
 NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(ExecutionState& state, Object* obj)
 {
     EnumerateObjectData* data = new EnumerateObjectData();
@@ -1857,6 +1990,19 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
     data->m_originalLength = 0;
     if (obj->isArrayObject())
         data->m_originalLength = obj->length(state);
+
+    // for-in over objects of same shape reuses keys cached in the structure
+    bool canUseCache = canUseEnumerationCache(obj);
+    if (canUseCache) {
+        EnumerateObjectKeys* cache = obj->structure()->m_enumerationCache;
+        if (cache && checkEnumerationCache(state, obj, cache)) {
+            data->m_keyData = cache;
+            return data;
+        }
+    }
+
+    EnumerateObjectKeys* keyData = new EnumerateObjectKeys();
+    data->m_keyData = keyData;
     Value target = data->m_object;
 
     size_t ownKeyCount = 0;
@@ -1873,7 +2019,7 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
     ObjectStructureChainItem newItem;
     newItem.m_objectStructure = target.asObject()->structure();
 
-    data->m_hiddenClassChain.push_back(newItem);
+    keyData->m_hiddenClassChain.push_back(newItem);
 
     std::unordered_set<String*, std::hash<String*>, std::equal_to<String*>, GCUtil::gc_malloc_ignore_off_page_allocator<String*>> keyStringSet;
 
@@ -1891,19 +2037,22 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
                                            &shouldSearchProto);
         }
         newItem.m_objectStructure = target.asObject()->structure();
-        data->m_hiddenClassChain.push_back(newItem);
+        keyData->m_hiddenClassChain.push_back(newItem);
+        if (canUseCache) {
+            canUseCache = canUseEnumerationCache(target.asObject());
+        }
         target = target.asObject()->getPrototype(state);
     }
 
     target = obj;
     struct EData {
         std::unordered_set<String*, std::hash<String*>, std::equal_to<String*>, GCUtil::gc_malloc_ignore_off_page_allocator<String*>>* keyStringSet;
-        EnumerateObjectData* data;
+        EnumerateObjectKeys* keyData;
         Object* obj;
         size_t* idx;
     } eData;
 
-    eData.data = data;
+    eData.keyData = keyData;
     eData.keyStringSet = &keyStringSet;
     eData.obj = obj;
 
@@ -1916,7 +2065,7 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
                     auto iter = eData->keyStringSet->find(key);
                     if (iter == eData->keyStringSet->end()) {
                         eData->keyStringSet->insert(key);
-                        eData->data->m_keys.pushBack(name.toPlainValue(state));
+                        eData->keyData->m_keys.pushBack(name.toPlainValue(state));
                     }
                 } else if (self == eData->obj) {
                     // 12.6.4 The values of [[Enumerable]] attributes are not considered
@@ -1933,11 +2082,11 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
     } else {
         size_t idx = 0;
         eData.idx = &idx;
-        data->m_keys.resizeWithUninitializedValues(ownKeyCount);
+        keyData->m_keys.resizeWithUninitializedValues(ownKeyCount);
         target.asObject()->enumeration(state, [](ExecutionState& state, Object* self, const ObjectPropertyName& name, const ObjectStructurePropertyDescriptor& desc, void* data) -> bool {
             if (desc.isEnumerable()) {
                 EData* eData = (EData*)data;
-                eData->data->m_keys[(*eData->idx)++] = name.toPlainValue(state);
+                eData->keyData->m_keys[(*eData->idx)++] = name.toPlainValue(state);
             }
             return true;
         },
@@ -1945,6 +2094,10 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
         ASSERT(ownKeyCount == idx);
     }
 
+    if (canUseCache) {
+        obj->structure()->m_enumerationCache = keyData;
+    }
+
     if (obj->rareData()) {
         obj->rareData()->m_shouldUpdateEnumerateObjectData = false;
     }
@@ -1954,13 +2107,15 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
 NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::updateEnumerateObjectData(ExecutionState& state, EnumerateObjectData* data)
 {
     EnumerateObjectData* newData = executeEnumerateObject(state, data->m_object);
+    SmallValueVector& keys = data->m_keyData->m_keys;
     std::vector<Value, GCUtil::gc_malloc_ignore_off_page_allocator<Value>> oldKeys;
-    if (data->m_keys.size()) {
-        oldKeys.insert(oldKeys.end(), &data->m_keys[0], &data->m_keys[data->m_keys.size() - 1] + 1);
+    if (keys.size()) {
+        oldKeys.insert(oldKeys.end(), &keys[0], &keys[keys.size() - 1] + 1);
     }
     std::vector<Value, GCUtil::gc_malloc_ignore_off_page_allocator<Value>> differenceKeys;
-    for (size_t i = 0; i < newData->m_keys.size(); i++) {
-        const Value& key = newData->m_keys[i];
+    SmallValueVector& newKeys = newData->m_keyData->m_keys;
+    for (size_t i = 0; i < newKeys.size(); i++) {
+        const Value& key = newKeys[i];
         // If a property that has not yet been visited during enumeration is deleted, then it will not be visited.
         if (std::find(oldKeys.begin(), oldKeys.begin() + data->m_idx, key) == oldKeys.begin() + data->m_idx && std::find(oldKeys.begin() + data->m_idx, oldKeys.end(), key) != oldKeys.end()) {
             // If new properties are added to the object being enumerated during enumeration,
@@ -1968,13 +2123,15 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::updateEnumerateObjectData
             differenceKeys.push_back(key);
         }
     }
-    data = newData;
-    data->m_keys.clear();
-    data->m_keys.resizeWithUninitializedValues(differenceKeys.size());
+    // key data of newData can be shared with enumeration cache
+    EnumerateObjectKeys* keyData = new EnumerateObjectKeys();
+    keyData->m_hiddenClassChain = newData->m_keyData->m_hiddenClassChain;
+    keyData->m_keys.resizeWithUninitializedValues(differenceKeys.size());
     for (size_t i = 0; i < differenceKeys.size(); i++) {
-        data->m_keys[i] = differenceKeys[i];
+        keyData->m_keys[i] = differenceKeys[i];
     }
-    return data;
+    newData->m_keyData = keyData;
+    return newData;
 }
 
 ALWAYS_INLINE Object* ByteCodeInterpreter::fastToObject(ExecutionState& state, const Value& obj)
@@ -2074,52 +2231,86 @@ NEVER_INLINE void ByteCodeInterpreter::setGlobalObjectSlowCase(ExecutionState& s
 NEVER_INLINE size_t ByteCodeInterpreter::tryOperation(ExecutionState& state, TryOperation* code, ExecutionContext* ec, LexicalEnvironment* env, size_t programCounter, ByteCodeBlock* byteCodeBlock, Value* registerFile)
 {
     char* codeBuffer = byteCodeBlock->m_code.data();
+    ExecutionStateRareData* rareData = state.ensureRareData();
+    if (!rareData->m_controlFlowRecord) {
+        rareData->m_controlFlowRecord = new ControlFlowRecordVector();
+    }
+    rareData->m_controlFlowRecord->pushBack(nullptr);
+
+    // exceptions thrown by bytecode of try body or of interpreted functions called from it are returned with m_hasPendingException
+    // C++ exception reaches here only when it is thrown from runtime, native functions or with bodies
+    Value exception;
+    bool hasException = false;
+    rareData->m_handlerFrameDepth++;
     try {
-        if (!state.ensureRareData()->m_controlFlowRecord) {
-            state.ensureRareData()->m_controlFlowRecord = new ControlFlowRecordVector();
-        }
-        state.ensureRareData()->m_controlFlowRecord->pushBack(nullptr);
         size_t newPc = programCounter + sizeof(TryOperation);
         clearStack<386>();
-        interpret(state, byteCodeBlock, resolveProgramCounter(codeBuffer, newPc), registerFile);
-        programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
+        Value result = interpret(state, byteCodeBlock, resolveProgramCounter(codeBuffer, newPc), registerFile);
+        if (UNLIKELY(rareData->m_hasPendingException)) {
+            rareData->m_hasPendingException = false;
+            exception = result;
+            hasException = true;
+        }
     } catch (const Value& val) {
-        state.context()->m_sandBoxStack.back()->fillStackDataIntoErrorObject(val);
+        exception = val;
+        hasException = true;
+    }
+    rareData->m_handlerFrameDepth--;
+
+    if (LIKELY(!hasException)) {
+        return jumpTo(codeBuffer, code->m_tryCatchEndPosition);
+    }
+
+    state.context()->m_sandBoxStack.back()->fillStackDataIntoErrorObject(exception);
 
 #ifndef NDEBUG
-        if (getenv("DUMP_ERROR_IN_TRY_CATCH") && strlen(getenv("DUMP_ERROR_IN_TRY_CATCH"))) {
-            ErrorObject::StackTraceData* data = ErrorObject::StackTraceData::create(state.context()->m_sandBoxStack.back());
-            StringBuilder builder;
-            builder.appendString("Caught error in try-catch block\n");
-            data->buildStackTrace(state.context(), builder);
-            ESCARGOT_LOG_ERROR("%s\n", builder.finalize()->toUTF8StringData().data());
-        }
+    if (getenv("DUMP_ERROR_IN_TRY_CATCH") && strlen(getenv("DUMP_ERROR_IN_TRY_CATCH"))) {
+        ErrorObject::StackTraceData* data = ErrorObject::StackTraceData::create(state.context()->m_sandBoxStack.back());
+        StringBuilder builder;
+        builder.appendString("Caught error in try-catch block\n");
+        data->buildStackTrace(state.context(), builder);
+        ESCARGOT_LOG_ERROR("%s\n", builder.finalize()->toUTF8StringData().data());
+    }
 #endif
 
-        state.context()->m_sandBoxStack.back()->m_stackTraceData.clear();
-        if (code->m_hasCatch == false) {
-            state.rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
-            programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
-        } else {
-            // setup new env
-            EnvironmentRecord* newRecord = new DeclarativeEnvironmentRecordNotIndexedForCatch();
-            newRecord->createBinding(state, code->m_catchVariableName);
-            newRecord->setMutableBinding(state, code->m_catchVariableName, val);
-            LexicalEnvironment* newEnv = new LexicalEnvironment(newRecord, env);
-            ExecutionContext* newEc = new ExecutionContext(state.context(), state.executionContext(), newEnv, state.inStrictMode());
-            try {
-                ExecutionState newState(&state, newEc);
-                newState.ensureRareData()->m_controlFlowRecord = state.rareData()->m_controlFlowRecord;
-                clearStack<386>();
-                interpret(newState, byteCodeBlock, code->m_catchPosition, registerFile);
-                programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
-            } catch (const Value& val) {
-                state.rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
-                programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
-            }
+    state.context()->m_sandBoxStack.back()->m_stackTraceData.clear();
+    if (code->m_hasCatch == false) {
+        rareData->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, exception);
+        return jumpTo(codeBuffer, code->m_tryCatchEndPosition);
+    }
+
+    // setup new env
+    // if there is no closure or eval, nothing can refer catch scope after catch body ends
+    InterpretedCodeBlock* codeBlock = byteCodeBlock->m_codeBlock->asInterpretedCodeBlock();
+    EnvironmentRecord* newRecord;
+    LexicalEnvironment* newEnv;
+    ExecutionContext* newEc;
+    if (codeBlock->childBlocks().size() == 0 && !codeBlock->hasEvalWithYield()) {
+        newRecord = new (alloca(sizeof(DeclarativeEnvironmentRecordNotIndexedForCatch))) DeclarativeEnvironmentRecordNotIndexedForCatch();
+        newEnv = new (alloca(sizeof(LexicalEnvironment))) LexicalEnvironment(newRecord, env);
+        newEc = new (alloca(sizeof(ExecutionContext))) ExecutionContext(state.context(), state.executionContext(), newEnv, state.inStrictMode());
+    } else {
+        newRecord = new DeclarativeEnvironmentRecordNotIndexedForCatch();
+        newEnv = new LexicalEnvironment(newRecord, env);
+        newEc = new ExecutionContext(state.context(), state.executionContext(), newEnv, state.inStrictMode());
+    }
+    newRecord->createBinding(state, code->m_catchVariableName);
+    newRecord->setMutableBinding(state, code->m_catchVariableName, exception);
+
+    ExecutionState newState(&state, newEc);
+    ExecutionStateRareData* newRareData = newState.ensureRareData();
+    newRareData->m_controlFlowRecord = rareData->m_controlFlowRecord;
+    newRareData->m_handlerFrameDepth = 1;
+    try {
+        clearStack<386>();
+        Value result = interpret(newState, byteCodeBlock, code->m_catchPosition, registerFile);
+        if (UNLIKELY(newRareData->m_hasPendingException)) {
+            rareData->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, result);
         }
+    } catch (const Value& val) {
+        rareData->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
     }
-    return programCounter;
+    return jumpTo(codeBuffer, code->m_tryCatchEndPosition);
 }
 
 class EvalCodeBlockWithFlagSetter {
@@ -2529,7 +2720,49 @@ ALWAYS_INLINE Value ByteCodeInterpreter::decrementOperation(ExecutionState& stat
     }
 }
 
-NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, const Value& value, ExecutionContext* ecInput, size_t programCounter)
+NEVER_INLINE void ByteCodeInterpreter::leaveFrameByException(ExecutionContext* ec, ByteCodeBlock* byteCodeBlock)
+{
+    if (ec->isOnGoingClassConstruction()) {
+        ec->setOnGoingClassConstruction(false);
+        ec->m_lexicalEnvironment = ec->lexicalEnvironment()->outerEnvironment();
+    }
+
+    if (ec->isOnGoingSuperCall()) {
+        ec->setOnGoingSuperCall(false);
+    }
+
+    if (byteCodeBlock->m_codeBlock->isInterpretedCodeBlock() && byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr) {
+        byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlock = byteCodeBlock;
+    }
+}
+
+NEVER_INLINE Value ByteCodeInterpreter::callFunctionInHandlerFrame(ExecutionState& state, const Value& callee, const Value& receiver, const size_t argc, Value* argv)
+{
+    // an exception thrown by bytecode of interpreted callee is returned with m_hasPendingException,
+    // so it reaches tryOperation without C++ unwinding. native functions still throw it
+    if (LIKELY(callee.isObject() && callee.asPointerValue()->hasTag(g_functionObjectTag))) {
+        return callee.asFunction()->processCall(state, receiver, argc, argv, false, true);
+    }
+    return FunctionObject::call(state, callee, receiver, argc, argv);
+}
+
+NEVER_INLINE Value ByteCodeInterpreter::returnExceptionToTryOperation(ExecutionState& state, const Value& value, ExecutionContext* ec, ByteCodeBlock* byteCodeBlock, size_t programCounter)
+{
+    ASSERT(state.rareData()->m_handlerFrameDepth);
+    leaveFrameByException(ec, byteCodeBlock);
+    pushStackTraceData(state, ec, programCounter);
+    state.context()->m_sandBoxStack.back()->m_exception = value;
+    state.rareData()->m_hasPendingException = true;
+    return value;
+}
+
+NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, const Value& value, ExecutionContext* ec, size_t programCounter)
+{
+    pushStackTraceData(state, ec, programCounter);
+    state.context()->m_sandBoxStack.back()->throwException(state, value);
+}
+
+void ByteCodeInterpreter::pushStackTraceData(ExecutionState& state, ExecutionContext* ecInput, size_t programCounter)
 {
     ASSERT(state.context()->m_sandBoxStack.size());
     SandBox* sb = state.context()->m_sandBoxStack.back();
@@ -2598,6 +2831,5 @@ NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, c
             sb->m_stackTraceData.pushBack(std::make_pair(ec, data));
         }
     }
-    sb->throwException(state, value);
 }
 }
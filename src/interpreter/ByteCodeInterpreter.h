@@ -33,6 +33,8 @@ class LexicalEnvironment;
 struct GetObjectInlineCache;
 struct SetObjectInlineCache;
 struct EnumerateObjectData;
+class EnumerateObjectKeys;
+struct ByNameCache;
 class GetGlobalObject;
 class SetGlobalObject;
 class CallFunctionInWithScope;
@@ -54,6 +56,8 @@ public:
     static Value loadByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, bool throwException = true);
     static EnvironmentRecord* getBindedEnvironmentRecordByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, Value& bindedValue, bool throwException = true);
     static void storeByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, const Value& value);
+    static Value loadByNameSlowCase(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, ByNameCache& cache);
+    static void storeByNameSlowCase(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, const Value& value, ByNameCache& cache);
     static Value plusSlowCase(ExecutionState& state, const Value& a, const Value& b);
     static Value modOperation(ExecutionState& state, const Value& left, const Value& right);
     static Object* newOperation(ExecutionState& state, const Value& callee, size_t argc, Value* argv);
@@ -74,6 +78,7 @@ public:
 
     static EnumerateObjectData* executeEnumerateObject(ExecutionState& state, Object* obj);
     static EnumerateObjectData* updateEnumerateObjectData(ExecutionState& state, EnumerateObjectData* data);
+    static bool checkEnumerationCache(ExecutionState& state, Object* obj, EnumerateObjectKeys* keyData);
 
     static Object* fastToObject(ExecutionState& state, const Value& obj);
 
@@ -96,7 +101,11 @@ public:
     static Value incrementOperation(ExecutionState& state, const Value& value);
     static Value decrementOperation(ExecutionState& state, const Value& value);
 
+    static void leaveFrameByException(ExecutionContext* ec, ByteCodeBlock* byteCodeBlock);
+    static Value callFunctionInHandlerFrame(ExecutionState& state, const Value& callee, const Value& receiver, const size_t argc, Value* argv);
+    static Value returnExceptionToTryOperation(ExecutionState& state, const Value& value, ExecutionContext* ec, ByteCodeBlock* byteCodeBlock, size_t programCounter);
     static void processException(ExecutionState& state, const Value& value, ExecutionContext* ec, size_t programCounter);
+    static void pushStackTraceData(ExecutionState& state, ExecutionContext* ec, size_t programCounter);
 };
 }
 
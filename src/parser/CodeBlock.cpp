@@ -366,6 +366,25 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringV
     }
 }
 
+InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, InterpretedCodeBlock* parentBlock)
+    : m_script(script)
+    , m_sourceElementStart(1, 1, 0)
+    , m_shouldReparseArguments(false)
+    , m_identifierOnStackCount(0)
+    , m_identifierOnHeapCount(0)
+    , m_parentCodeBlock(parentBlock)
+#ifndef NDEBUG
+    , m_locStart(SIZE_MAX, SIZE_MAX, SIZE_MAX)
+    , m_locEnd(SIZE_MAX, SIZE_MAX, SIZE_MAX)
+    , m_scopeContext(nullptr)
+#endif
+{
+    m_context = ctx;
+    m_byteCodeBlock = nullptr;
+    m_parameterCount = 0;
+    m_hasCallNativeFunctionCode = false;
+}
+
 bool InterpretedCodeBlock::needToStoreThisValue()
 {
     return hasName(m_context->staticStrings().stringThis);
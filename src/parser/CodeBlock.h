@@ -91,6 +91,7 @@ class InterpretedCodeBlock;
 class CodeBlock : public gc {
     friend class Script;
     friend class ScriptParser;
+    friend class CodeCache;
     friend class ByteCodeGenerator;
     friend class FunctionObject;
     friend class InterpretedCodeBlock;
@@ -343,6 +344,7 @@ protected:
 class InterpretedCodeBlock : public CodeBlock {
     friend class Script;
     friend class ScriptParser;
+    friend class CodeCache;
     friend class ByteCodeGenerator;
     friend class FunctionObject;
     friend class ByteCodeInterpreter;
@@ -597,6 +599,8 @@ protected:
     InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ASTScopeContext* scopeCtx, ExtendedNodeLOC sourceElementStart);
     // init function codeBlock
     InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ASTScopeContext* scopeCtx, ExtendedNodeLOC sourceElementStart, InterpretedCodeBlock* parentBlock);
+    // init codeBlock from code cache. CodeCache fills the other fields
+    InterpretedCodeBlock(Context* ctx, Script* script, InterpretedCodeBlock* parentBlock);
 
     Script* m_script;
     StringView m_paramsSrc; // function parameters elements src
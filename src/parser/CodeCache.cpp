@@ -0,0 +1,1206 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "CodeCache.h"
+#include "runtime/Context.h"
+#include "interpreter/ByteCode.h"
+#include "parser/CodeBlock.h"
+#include "parser/Script.h"
+
+namespace Escargot {
+
+#define CODE_CACHE_MAGIC 0x43435345 // "ESCC"
+#define CODE_CACHE_HASH_OFFSET 0xcbf29ce484222325ULL
+#define CODE_CACHE_HASH_PRIME 0x100000001b3ULL
+#define CODE_CACHE_NO_INDEX SIZE_MAX
+
+static const uint8_t byteCodeLengths[] = {
+#define ITER_BYTE_CODE(code, pushCount, popCount) \
+    (uint8_t)sizeof(code),
+
+    FOR_EACH_BYTECODE_OP(ITER_BYTE_CODE)
+#undef ITER_BYTE_CODE
+};
+
+#define FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(F)  \
+    F(m_isConstructor)                          \
+    F(m_isStrict)                               \
+    F(m_isFunctionNameSaveOnHeap)               \
+    F(m_isFunctionNameExplicitlyDeclared)       \
+    F(m_canUseIndexedVariableStorage)           \
+    F(m_canAllocateEnvironmentOnStack)          \
+    F(m_needsComplexParameterCopy)              \
+    F(m_hasEval)                                \
+    F(m_hasWith)                                \
+    F(m_hasSuper)                               \
+    F(m_hasCatch)                               \
+    F(m_hasYield)                               \
+    F(m_inCatch)                                \
+    F(m_inWith)                                 \
+    F(m_usesArgumentsObject)                    \
+    F(m_isFunctionExpression)                   \
+    F(m_isFunctionDeclaration)                  \
+    F(m_isFunctionDeclarationWithSpecialBinding) \
+    F(m_isArrowFunctionExpression)              \
+    F(m_isClassConstructor)                     \
+    F(m_isInWithScope)                          \
+    F(m_isEvalCodeInFunction)                   \
+    F(m_isBindedFunction)                       \
+    F(m_needsVirtualIDOperation)                \
+    F(m_needToLoadThisValue)                    \
+    F(m_hasRestElement)
+
+enum CodeCacheValueKind : uint8_t {
+    CodeCacheEmptyValue,
+    CodeCacheUndefinedValue,
+    CodeCacheNullValue,
+    CodeCacheTrueValue,
+    CodeCacheFalseValue,
+    CodeCacheInt32Value,
+    CodeCacheDoubleValue,
+    CodeCacheStringValue,
+};
+
+enum CodeCacheStringFlag : uint8_t {
+    CodeCacheStringIsAtomic = 1,
+    CodeCacheStringIs8Bit = 1 << 1,
+};
+
+struct CodeCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t layoutHash;
+    uint64_t sourceHash;
+    uint64_t sourceLength;
+    uint64_t payloadHash;
+    uint64_t payloadLength;
+};
+
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t length)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ p[i]) * CODE_CACHE_HASH_PRIME;
+    }
+    return hash;
+}
+
+// opcode stream is stored in its in-memory layout, so cache is only valid for the same build
+static uint64_t layoutHash()
+{
+    size_t layout[] = { sizeof(size_t), sizeof(Value), sizeof(ByteCodeLOC), sizeof(ByteCode), (size_t)OpcodeKindEnd, (size_t)REGISTER_LIMIT };
+    uint64_t hash = hashBytes(CODE_CACHE_HASH_OFFSET, layout, sizeof(layout));
+    return hashBytes(hash, byteCodeLengths, sizeof(byteCodeLengths));
+}
+
+template <typename T>
+static void putIndex(T& field, size_t idx)
+{
+    COMPILE_ASSERT(sizeof(T) >= sizeof(size_t), "");
+    memset((void*)&field, 0, sizeof(T));
+    memcpy((void*)&field, &idx, sizeof(size_t));
+}
+
+template <typename T>
+static size_t getIndex(const T& field)
+{
+    size_t idx;
+    memcpy(&idx, (const void*)&field, sizeof(size_t));
+    return idx;
+}
+
+class CodeCacheWriter {
+public:
+    template <typename T>
+    void put(const T& value)
+    {
+        putBytes(&value, sizeof(T));
+    }
+
+    void putBytes(const void* src, size_t length)
+    {
+        const char* p = (const char*)src;
+        m_data.insert(m_data.end(), p, p + length);
+    }
+
+    CodeCacheData m_data;
+};
+
+class CodeCacheReader {
+public:
+    CodeCacheReader(const char* data, size_t length)
+        : m_data(data)
+        , m_length(length)
+        , m_position(0)
+        , m_hasError(false)
+    {
+    }
+
+    template <typename T>
+    T get()
+    {
+        T value;
+        const char* src = getBytes(sizeof(T));
+        if (src) {
+            memcpy((void*)&value, src, sizeof(T));
+        } else {
+            memset((void*)&value, 0, sizeof(T));
+        }
+        return value;
+    }
+
+    const char* getBytes(size_t length)
+    {
+        if (m_hasError || length > m_length - m_position) {
+            m_hasError = true;
+            return nullptr;
+        }
+        const char* src = m_data + m_position;
+        m_position += length;
+        return src;
+    }
+
+    // every element takes at least one byte, so count cannot be bigger than remaining bytes
+    bool isValidCount(size_t count) const
+    {
+        return count <= m_length - m_position;
+    }
+
+    bool isEnd() const
+    {
+        return m_position == m_length;
+    }
+
+    void setError()
+    {
+        m_hasError = true;
+    }
+
+    bool hasError() const
+    {
+        return m_hasError;
+    }
+
+private:
+    const char* m_data;
+    size_t m_length;
+    size_t m_position;
+    bool m_hasError;
+};
+
+class CodeCache::Encoder {
+public:
+    Encoder(Script* script)
+        : m_source(script->topCodeBlock()->src().string())
+        , m_isValid(true)
+    {
+        // index 0 is reserved for String::emptyString, which default AtomicString points
+        m_strings.push_back(std::make_pair(String::emptyString, true));
+        m_stringIndexes[String::emptyString] = 0;
+#if defined(COMPILER_GCC)
+        for (size_t i = 0; i < OpcodeKindEnd; i++) {
+            m_opcodeOfAddress[g_opcodeTable.m_table[i]] = (Opcode)i;
+        }
+#endif
+    }
+
+    bool encode(Script* script, CodeCacheData& data)
+    {
+        InterpretedCodeBlock* topCodeBlock = script->topCodeBlock();
+        encodeCodeBlock(topCodeBlock);
+        encodeByteCodeBlock(topCodeBlock->byteCodeBlock());
+        if (!m_isValid) {
+            return false;
+        }
+
+        CodeCacheWriter payload;
+        payload.put<uint32_t>(m_strings.size());
+        for (size_t i = 1; i < m_strings.size(); i++) {
+            const StringBufferAccessData& buffer = m_strings[i].first->bufferAccessData();
+            uint8_t flags = (m_strings[i].second ? CodeCacheStringIsAtomic : 0) | (buffer.has8BitContent ? CodeCacheStringIs8Bit : 0);
+            payload.put<uint8_t>(flags);
+            payload.put<uint64_t>(buffer.length);
+            payload.putBytes(buffer.buffer, buffer.length * (buffer.has8BitContent ? sizeof(LChar) : sizeof(char16_t)));
+        }
+        payload.putBytes(m_codeBlockData.m_data.data(), m_codeBlockData.m_data.size());
+        payload.putBytes(m_byteCodeData.m_data.data(), m_byteCodeData.m_data.size());
+
+        CodeCacheHeader header;
+        header.magic = CODE_CACHE_MAGIC;
+        header.version = ESCARGOT_CODE_CACHE_VERSION;
+        header.layoutHash = layoutHash();
+        header.sourceHash = CodeCache::sourceHash(m_source);
+        header.sourceLength = m_source->length();
+        header.payloadHash = hashBytes(CODE_CACHE_HASH_OFFSET, payload.m_data.data(), payload.m_data.size());
+        header.payloadLength = payload.m_data.size();
+
+        data.clear();
+        data.reserve(sizeof(CodeCacheHeader) + payload.m_data.size());
+        data.insert(data.end(), (const char*)&header, (const char*)&header + sizeof(CodeCacheHeader));
+        data.insert(data.end(), payload.m_data.begin(), payload.m_data.end());
+        return true;
+    }
+
+private:
+    size_t stringIndex(String* str, bool isAtomic)
+    {
+        auto iter = m_stringIndexes.find(str);
+        if (iter != m_stringIndexes.end()) {
+            m_strings[iter->second].second |= isAtomic;
+            return iter->second;
+        }
+        size_t idx = m_strings.size();
+        m_strings.push_back(std::make_pair(str, isAtomic));
+        m_stringIndexes[str] = idx;
+        return idx;
+    }
+
+    void encodeField(AtomicString& name)
+    {
+        putIndex(name, stringIndex(name.string(), true));
+    }
+
+    void encodeField(PropertyName& name)
+    {
+        // property names in bytecode are made from identifiers
+        if (!name.hasAtomicString()) {
+            m_isValid = false;
+            return;
+        }
+        putIndex(name, stringIndex(name.plainString(), true));
+    }
+
+    void encodeField(String*& str)
+    {
+        putIndex(str, str ? stringIndex(str, false) : CODE_CACHE_NO_INDEX);
+    }
+
+    template <typename CodeBlockType>
+    void encodeField(CodeBlockType*& cb)
+    {
+        if (!cb) {
+            putIndex(cb, CODE_CACHE_NO_INDEX);
+            return;
+        }
+        auto iter = m_codeBlockIndexes.find((CodeBlock*)cb);
+        if (iter == m_codeBlockIndexes.end()) {
+            m_isValid = false;
+            return;
+        }
+        putIndex(cb, iter->second);
+    }
+
+    void encodeValue(CodeCacheWriter& w, const Value& v)
+    {
+        if (v.isEmpty()) {
+            w.put<uint8_t>(CodeCacheEmptyValue);
+        } else if (v.isUndefined()) {
+            w.put<uint8_t>(CodeCacheUndefinedValue);
+        } else if (v.isNull()) {
+            w.put<uint8_t>(CodeCacheNullValue);
+        } else if (v.isBoolean()) {
+            w.put<uint8_t>(v.asBoolean() ? CodeCacheTrueValue : CodeCacheFalseValue);
+        } else if (v.isInt32()) {
+            w.put<uint8_t>(CodeCacheInt32Value);
+            w.put<int32_t>(v.asInt32());
+        } else if (v.isNumber()) {
+            w.put<uint8_t>(CodeCacheDoubleValue);
+            w.put<uint64_t>(bitwise_cast<uint64_t>(v.asNumber()));
+        } else if (v.isString()) {
+            w.put<uint8_t>(CodeCacheStringValue);
+            w.put<uint32_t>(stringIndex(v.asString(), false));
+        } else {
+            m_isValid = false;
+        }
+    }
+
+    void encodeSourceRange(const StringView& src)
+    {
+        if (src.string() != m_source) {
+            m_isValid = false;
+            return;
+        }
+        m_codeBlockData.put<uint64_t>(src.start());
+        m_codeBlockData.put<uint64_t>(src.end());
+    }
+
+    // code blocks are stored in pre-order, and referred by the order
+    void encodeCodeBlock(InterpretedCodeBlock* cb)
+    {
+        size_t idx = m_codeBlockIndexes.size();
+        m_codeBlockIndexes[cb] = idx;
+
+        CodeCacheWriter& w = m_codeBlockData;
+        uint32_t flags = 0;
+        uint32_t bit = 0;
+#define WRITE_FLAG(name) \
+    flags |= (uint32_t)cb->name << bit++;
+        FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(WRITE_FLAG)
+#undef WRITE_FLAG
+        w.put<uint32_t>(flags);
+        w.put<uint16_t>(cb->m_parameterCount);
+        w.put<uint32_t>(stringIndex(cb->m_functionName.string(), true));
+
+        encodeSourceRange(cb->m_src);
+        w.put<uint8_t>(cb->m_shouldReparseArguments);
+        if (cb->m_shouldReparseArguments) {
+            encodeSourceRange(cb->m_paramsSrc);
+        }
+        w.put<uint64_t>(cb->m_sourceElementStart.line);
+        w.put<uint64_t>(cb->m_sourceElementStart.column);
+        w.put<uint64_t>(cb->m_sourceElementStart.index);
+
+        w.put<uint16_t>(cb->m_identifierOnStackCount);
+        w.put<uint16_t>(cb->m_identifierOnHeapCount);
+
+        w.put<uint32_t>(cb->m_parametersInfomation.size());
+        for (size_t i = 0; i < cb->m_parametersInfomation.size(); i++) {
+            const InterpretedCodeBlock::FunctionParametersInfo& info = cb->m_parametersInfomation[i];
+            w.put<uint8_t>((info.m_isHeapAllocated ? 1 : 0) | (info.m_isDuplicated ? 2 : 0));
+            w.put<int32_t>(info.m_index);
+            w.put<uint32_t>(stringIndex(info.m_name.string(), true));
+        }
+
+        w.put<uint32_t>(cb->m_identifierInfos.size());
+        for (size_t i = 0; i < cb->m_identifierInfos.size(); i++) {
+            const CodeBlock::IdentifierInfo& info = cb->m_identifierInfos[i];
+            w.put<uint8_t>((info.m_needToAllocateOnStack ? 1 : 0) | (info.m_isMutable ? 2 : 0) | (info.m_isExplicitlyDeclaredOrParameterName ? 4 : 0));
+            w.put<uint64_t>(info.m_indexForIndexedStorage);
+            w.put<uint32_t>(stringIndex(info.m_name.string(), true));
+        }
+
+        w.put<uint32_t>(cb->m_childBlocks.size());
+        for (size_t i = 0; i < cb->m_childBlocks.size(); i++) {
+            encodeCodeBlock(cb->m_childBlocks[i]);
+        }
+    }
+
+    void encodeByteCodeBlock(ByteCodeBlock* block)
+    {
+        if (!block) {
+            m_isValid = false;
+            return;
+        }
+
+        CodeCacheWriter& w = m_byteCodeData;
+        w.put<uint32_t>(block->m_requiredRegisterFileSizeInValueSize);
+        w.put<uint8_t>(block->m_shouldClearStack);
+        w.put<uint32_t>(block->m_numeralLiteralData.size());
+        for (size_t i = 0; i < block->m_numeralLiteralData.size(); i++) {
+            encodeValue(w, block->m_numeralLiteralData[i]);
+        }
+
+        CodeCacheData code(block->m_code.data(), block->m_code.data() + block->m_code.size());
+        size_t codeBase = (size_t)block->m_code.data();
+        CodeCacheWriter literals;
+        size_t literalCount = 0;
+        std::vector<ControlFlowRecord*> records;
+        std::vector<SwitchJumpTableData*> tables;
+
+        size_t position = 0;
+        while (m_isValid && position < code.size()) {
+            ByteCode* currentCode = (ByteCode*)(code.data() + position);
+#if defined(COMPILER_GCC)
+            auto iter = m_opcodeOfAddress.find(currentCode->m_opcodeInAddress);
+            if (iter == m_opcodeOfAddress.end()) {
+                m_isValid = false;
+                break;
+            }
+            Opcode opcode = iter->second;
+            currentCode->m_opcodeInAddress = (void*)(size_t)opcode;
+#else
+            Opcode opcode = currentCode->m_opcode;
+#endif
+
+            switch (opcode) {
+            case LoadLiteralOpcode: {
+                LoadLiteral* cd = (LoadLiteral*)currentCode;
+                encodeValue(literals, cd->m_value);
+                putIndex(cd->m_value, literalCount++);
+                break;
+            }
+            case LoadByNameOpcode: {
+                LoadByName* cd = (LoadByName*)currentCode;
+                cd->m_cache.reset();
+                encodeField(cd->m_name);
+                break;
+            }
+            case StoreByNameOpcode: {
+                StoreByName* cd = (StoreByName*)currentCode;
+                cd->m_cache.reset();
+                encodeField(cd->m_name);
+                break;
+            }
+            case DeclareFunctionDeclarationsOpcode:
+                encodeField(((DeclareFunctionDeclarations*)currentCode)->m_codeBlock);
+                break;
+            case CreateFunctionOpcode:
+                encodeField(((CreateFunction*)currentCode)->m_codeBlock);
+                break;
+            case CreateClassOpcode: {
+                CreateClass* cd = (CreateClass*)currentCode;
+                encodeField(cd->m_name);
+                encodeField(cd->m_codeBlock);
+                break;
+            }
+            case ObjectDefineOwnPropertyWithNameOperationOpcode:
+                encodeField(((ObjectDefineOwnPropertyWithNameOperation*)currentCode)->m_propertyName);
+                break;
+            case GetObjectPreComputedCaseOpcode: {
+                GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
+                memset((void*)&cd->m_inlineCache, 0, sizeof(GetObjectInlineCache));
+                encodeField(cd->m_propertyName);
+                break;
+            }
+            case SetObjectPreComputedCaseOpcode: {
+                SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)currentCode;
+                cd->m_inlineCache = nullptr;
+                encodeField(cd->m_propertyName);
+                break;
+            }
+            case GetGlobalObjectOpcode: {
+                GetGlobalObject* cd = (GetGlobalObject*)currentCode;
+                cd->m_cachedAddress = nullptr;
+                cd->m_cachedStructure = nullptr;
+                encodeField(cd->m_propertyName);
+                break;
+            }
+            case SetGlobalObjectOpcode: {
+                SetGlobalObject* cd = (SetGlobalObject*)currentCode;
+                cd->m_cachedAddress = nullptr;
+                cd->m_cachedStructure = nullptr;
+                encodeField(cd->m_propertyName);
+                break;
+            }
+            case UnaryTypeofOpcode:
+                encodeField(((UnaryTypeof*)currentCode)->m_id);
+                break;
+            case UnaryDeleteOpcode:
+                encodeField(((UnaryDelete*)currentCode)->m_id);
+                break;
+            case TemplateOperationOpcode:
+                encodeField(((TemplateOperation*)currentCode)->m_quasi);
+                break;
+            case JumpOpcode: {
+                Jump* cd = (Jump*)currentCode;
+                cd->m_jumpPosition -= codeBase;
+                break;
+            }
+            case JumpIfTrueOpcode:
+            case JumpIfFalseOpcode:
+            case JumpIfRelationOpcode:
+            case JumpIfEqualOpcode: {
+                JumpByteCode* cd = (JumpByteCode*)currentCode;
+                cd->m_jumpPosition -= codeBase;
+                break;
+            }
+            case JumpComplexCaseOpcode: {
+                JumpComplexCase* cd = (JumpComplexCase*)currentCode;
+                if (cd->m_controlFlowRecord->reason() != ControlFlowRecord::NeedsJump) {
+                    m_isValid = false;
+                    break;
+                }
+                putIndex(cd->m_controlFlowRecord, records.size());
+                records.push_back(((JumpComplexCase*)(block->m_code.data() + position))->m_controlFlowRecord);
+                break;
+            }
+            case SwitchJumpTableOpcode: {
+                SwitchJumpTable* cd = (SwitchJumpTable*)currentCode;
+                putIndex(cd->m_table, tables.size());
+                tables.push_back(((SwitchJumpTable*)(block->m_code.data() + position))->m_table);
+                break;
+            }
+            case CallFunctionInWithScopeOpcode:
+                encodeField(((CallFunctionInWithScope*)currentCode)->m_calleeName);
+                break;
+            case TryOperationOpcode:
+                encodeField(((TryOperation*)currentCode)->m_catchVariableName);
+                break;
+            case ThrowStaticErrorOperationOpcode: {
+                ThrowStaticErrorOperation* cd = (ThrowStaticErrorOperation*)currentCode;
+                String* message = new ASCIIString(cd->m_errorMessage);
+                putIndex(cd->m_errorMessage, stringIndex(message, false));
+                m_allocatedStrings.push_back(message);
+                break;
+            }
+            case LoadRegexpOpcode: {
+                LoadRegexp* cd = (LoadRegexp*)currentCode;
+                encodeField(cd->m_body);
+                encodeField(cd->m_option);
+                break;
+            }
+            default:
+                break;
+            }
+
+            if (opcode >= OpcodeKindEnd) {
+                m_isValid = false;
+                break;
+            }
+            position += byteCodeLengths[opcode];
+        }
+
+        if (position != code.size()) {
+            m_isValid = false;
+        }
+        if (!m_isValid) {
+            return;
+        }
+
+        w.put<uint32_t>(literalCount);
+        w.putBytes(literals.m_data.data(), literals.m_data.size());
+        w.put<uint32_t>(records.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            w.put<uint64_t>(records[i]->wordValue());
+            w.put<uint64_t>(records[i]->count());
+            w.put<uint64_t>(records[i]->outerLimitCount());
+        }
+        w.put<uint32_t>(tables.size());
+        for (size_t i = 0; i < tables.size(); i++) {
+            SwitchJumpTableData* table = tables[i];
+            w.put<uint8_t>(table->m_isStringTable);
+            w.put<int32_t>(table->m_minimum);
+            w.put<uint32_t>(table->m_positions.size());
+            for (size_t j = 0; j < table->m_positions.size(); j++) {
+                w.put<uint64_t>(table->m_positions[j]);
+                if (table->m_isStringTable) {
+                    w.put<uint64_t>(table->m_keys[j] ? stringIndex(table->m_keys[j], false) : CODE_CACHE_NO_INDEX);
+                }
+            }
+        }
+        w.put<uint64_t>(code.size());
+        w.putBytes(code.data(), code.size());
+    }
+
+    String* m_source;
+    bool m_isValid;
+    std::vector<std::pair<String*, bool>> m_strings;
+    std::unordered_map<String*, size_t> m_stringIndexes;
+    // keeps strings made while encoding (m_strings is not scanned by GC)
+    std::vector<String*, gc_allocator<String*>> m_allocatedStrings;
+    std::unordered_map<CodeBlock*, size_t> m_codeBlockIndexes;
+#if defined(COMPILER_GCC)
+    std::unordered_map<void*, Opcode> m_opcodeOfAddress;
+#endif
+    CodeCacheWriter m_codeBlockData;
+    CodeCacheWriter m_byteCodeData;
+};
+
+class CodeCache::Decoder {
+public:
+    Decoder(Context* context, String* source, const char* data, size_t length)
+        : m_context(context)
+        , m_source(source)
+        , m_reader(data, length)
+    {
+    }
+
+    Script* decode(String* fileName)
+    {
+        if (!decodeStrings()) {
+            return nullptr;
+        }
+
+        Script* script = new Script(fileName, new StringView(m_source, 0, m_source->length()));
+        InterpretedCodeBlock* topCodeBlock = decodeCodeBlock(script, nullptr);
+        if (!topCodeBlock) {
+            return nullptr;
+        }
+        ByteCodeBlock* block = decodeByteCodeBlock(topCodeBlock);
+        if (!block || !m_reader.isEnd()) {
+            return nullptr;
+        }
+
+        topCodeBlock->m_byteCodeBlock = block;
+        script->m_topCodeBlock = topCodeBlock;
+        script->m_hasPreparedByteCodeBlock = true;
+        return script;
+    }
+
+private:
+    bool decodeStrings()
+    {
+        size_t count = m_reader.get<uint32_t>();
+        if (!count || !m_reader.isValidCount(count)) {
+            return false;
+        }
+
+        m_strings.resize(count);
+        m_isAtomicString.resize(count);
+        m_strings[0] = String::emptyString;
+        m_isAtomicString[0] = true;
+        for (size_t i = 1; i < count; i++) {
+            uint8_t flags = m_reader.get<uint8_t>();
+            size_t length = m_reader.get<uint64_t>();
+            bool is8Bit = flags & CodeCacheStringIs8Bit;
+            if (!m_reader.isValidCount(length)) {
+                return false;
+            }
+            const char* src = m_reader.getBytes(length * (is8Bit ? sizeof(LChar) : sizeof(char16_t)));
+            if (!src) {
+                return false;
+            }
+
+            String* str;
+            if (is8Bit) {
+                if (isAllASCII(src, length)) {
+                    str = new ASCIIString(src, length);
+                } else {
+                    str = new Latin1String((const LChar*)src, length);
+                }
+            } else {
+                // the source buffer may not be aligned for char16_t
+                std::vector<char16_t> buffer(length);
+                memcpy(buffer.data(), src, length * sizeof(char16_t));
+                str = new UTF16String(buffer.data(), length);
+            }
+
+            m_isAtomicString[i] = flags & CodeCacheStringIsAtomic;
+            if (m_isAtomicString[i]) {
+                str = AtomicString(m_context, str).string();
+            }
+            m_strings[i] = str;
+        }
+        return !m_reader.hasError();
+    }
+
+    String* stringAt(size_t idx)
+    {
+        if (idx >= m_strings.size()) {
+            m_reader.setError();
+            return String::emptyString;
+        }
+        return m_strings[idx];
+    }
+
+    AtomicString atomicStringAt(size_t idx)
+    {
+        if (idx >= m_strings.size() || !m_isAtomicString[idx]) {
+            m_reader.setError();
+            return AtomicString();
+        }
+        return AtomicString::fromPayload(m_strings[idx]);
+    }
+
+    void decodeField(ByteCodeBlock* block, AtomicString& name)
+    {
+        name = atomicStringAt(getIndex(name));
+    }
+
+    void decodeField(ByteCodeBlock* block, PropertyName& name)
+    {
+        name = PropertyName(atomicStringAt(getIndex(name)));
+    }
+
+    void decodeField(ByteCodeBlock* block, String*& str)
+    {
+        size_t idx = getIndex(str);
+        if (idx == CODE_CACHE_NO_INDEX) {
+            str = nullptr;
+            return;
+        }
+        str = stringAt(idx);
+        block->m_literalData.pushBack(str);
+    }
+
+    template <typename CodeBlockType>
+    void decodeField(ByteCodeBlock* block, CodeBlockType*& cb)
+    {
+        size_t idx = getIndex(cb);
+        if (idx == CODE_CACHE_NO_INDEX) {
+            cb = nullptr;
+            return;
+        }
+        if (idx >= m_codeBlocks.size()) {
+            m_reader.setError();
+            cb = nullptr;
+            return;
+        }
+        cb = m_codeBlocks[idx];
+    }
+
+    Value decodeValue()
+    {
+        switch (m_reader.get<uint8_t>()) {
+        case CodeCacheEmptyValue:
+            return Value(Value::EmptyValue);
+        case CodeCacheUndefinedValue:
+            return Value();
+        case CodeCacheNullValue:
+            return Value(Value::Null);
+        case CodeCacheTrueValue:
+            return Value(true);
+        case CodeCacheFalseValue:
+            return Value(false);
+        case CodeCacheInt32Value:
+            return Value(m_reader.get<int32_t>());
+        case CodeCacheDoubleValue:
+            return Value(Value::EncodeAsDouble, bitwise_cast<double>(m_reader.get<uint64_t>()));
+        case CodeCacheStringValue:
+            return Value(stringAt(m_reader.get<uint32_t>()));
+        default:
+            m_reader.setError();
+            return Value();
+        }
+    }
+
+    StringView decodeSourceRange()
+    {
+        size_t start = m_reader.get<uint64_t>();
+        size_t end = m_reader.get<uint64_t>();
+        if (start > end || end > m_source->length()) {
+            m_reader.setError();
+            return StringView();
+        }
+        return StringView(m_source, start, end);
+    }
+
+    InterpretedCodeBlock* decodeCodeBlock(Script* script, InterpretedCodeBlock* parentCodeBlock)
+    {
+        InterpretedCodeBlock* cb = new InterpretedCodeBlock(m_context, script, parentCodeBlock);
+        m_codeBlocks.push_back(cb);
+
+        uint32_t flags = m_reader.get<uint32_t>();
+        uint32_t bit = 0;
+#define READ_FLAG(name) \
+    cb->name = (flags >> bit++) & 1;
+        FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(READ_FLAG)
+#undef READ_FLAG
+        cb->m_parameterCount = m_reader.get<uint16_t>();
+        cb->m_functionName = atomicStringAt(m_reader.get<uint32_t>());
+
+        cb->m_src = decodeSourceRange();
+        cb->m_shouldReparseArguments = m_reader.get<uint8_t>();
+        if (cb->m_shouldReparseArguments) {
+            cb->m_paramsSrc = decodeSourceRange();
+        }
+        cb->m_sourceElementStart.line = m_reader.get<uint64_t>();
+        cb->m_sourceElementStart.column = m_reader.get<uint64_t>();
+        cb->m_sourceElementStart.index = m_reader.get<uint64_t>();
+
+        cb->m_identifierOnStackCount = m_reader.get<uint16_t>();
+        cb->m_identifierOnHeapCount = m_reader.get<uint16_t>();
+
+        size_t parameterCount = m_reader.get<uint32_t>();
+        if (!m_reader.isValidCount(parameterCount)) {
+            return nullptr;
+        }
+        cb->m_parametersInfomation.resizeWithUninitializedValues(parameterCount);
+        for (size_t i = 0; i < parameterCount; i++) {
+            InterpretedCodeBlock::FunctionParametersInfo& info = cb->m_parametersInfomation[i];
+            uint8_t infoFlags = m_reader.get<uint8_t>();
+            info.m_isHeapAllocated = infoFlags & 1;
+            info.m_isDuplicated = infoFlags & 2;
+            info.m_index = m_reader.get<int32_t>();
+            info.m_name = atomicStringAt(m_reader.get<uint32_t>());
+        }
+
+        size_t identifierCount = m_reader.get<uint32_t>();
+        if (!m_reader.isValidCount(identifierCount)) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < identifierCount; i++) {
+            CodeBlock::IdentifierInfo info;
+            uint8_t infoFlags = m_reader.get<uint8_t>();
+            info.m_needToAllocateOnStack = infoFlags & 1;
+            info.m_isMutable = infoFlags & 2;
+            info.m_isExplicitlyDeclaredOrParameterName = infoFlags & 4;
+            info.m_indexForIndexedStorage = m_reader.get<uint64_t>();
+            info.m_name = atomicStringAt(m_reader.get<uint32_t>());
+            cb->m_identifierInfos.push_back(info);
+        }
+
+        size_t childCount = m_reader.get<uint32_t>();
+        if (m_reader.hasError() || !m_reader.isValidCount(childCount)) {
+            return nullptr;
+        }
+        cb->m_childBlocks.resizeWithUninitializedValues(childCount);
+        for (size_t i = 0; i < childCount; i++) {
+            cb->m_childBlocks[i] = decodeCodeBlock(script, cb);
+            if (!cb->m_childBlocks[i]) {
+                return nullptr;
+            }
+        }
+        return cb;
+    }
+
+    ByteCodeBlock* decodeByteCodeBlock(InterpretedCodeBlock* codeBlock)
+    {
+        ByteCodeBlock* block = new ByteCodeBlock(codeBlock);
+        size_t registerFileSize = m_reader.get<uint32_t>();
+        if (registerFileSize >= REGISTER_LIMIT) {
+            return nullptr;
+        }
+        block->m_requiredRegisterFileSizeInValueSize = registerFileSize;
+        block->m_shouldClearStack = m_reader.get<uint8_t>();
+
+        size_t numeralCount = m_reader.get<uint32_t>();
+        if (!m_reader.isValidCount(numeralCount)) {
+            return nullptr;
+        }
+        block->m_numeralLiteralData.resizeWithUninitializedValues(numeralCount);
+        for (size_t i = 0; i < numeralCount; i++) {
+            block->m_numeralLiteralData[i] = decodeValue();
+            // numeral literal data is not scanned by GC
+            if (!block->m_numeralLiteralData[i].isNumber()) {
+                return nullptr;
+            }
+        }
+
+        size_t literalCount = m_reader.get<uint32_t>();
+        if (!m_reader.isValidCount(literalCount)) {
+            return nullptr;
+        }
+        std::vector<Value> literals;
+        for (size_t i = 0; i < literalCount; i++) {
+            literals.push_back(decodeValue());
+        }
+
+        size_t recordCount = m_reader.get<uint32_t>();
+        if (!m_reader.isValidCount(recordCount)) {
+            return nullptr;
+        }
+        std::vector<ControlFlowRecord*> records;
+        for (size_t i = 0; i < recordCount; i++) {
+            size_t wordValue = m_reader.get<uint64_t>();
+            size_t count = m_reader.get<uint64_t>();
+            size_t outerLimitCount = m_reader.get<uint64_t>();
+            ControlFlowRecord* record = new ControlFlowRecord(ControlFlowRecord::ControlFlowReason::NeedsJump, wordValue, count, outerLimitCount);
+            block->m_literalData.pushBack(record);
+            records.push_back(record);
+        }
+
+        size_t tableCount = m_reader.get<uint32_t>();
+        if (!m_reader.isValidCount(tableCount)) {
+            return nullptr;
+        }
+        std::vector<SwitchJumpTableData*> tables;
+        for (size_t i = 0; i < tableCount; i++) {
+            bool isStringTable = m_reader.get<uint8_t>();
+            int32_t minimum = m_reader.get<int32_t>();
+            size_t size = m_reader.get<uint32_t>();
+            if (!m_reader.isValidCount(size) || (isStringTable && (size & (size - 1)))) {
+                return nullptr;
+            }
+            SwitchJumpTableData* table = new SwitchJumpTableData(isStringTable, minimum);
+            table->m_positions.resizeWithUninitializedValues(size);
+            if (isStringTable) {
+                table->m_keys.resize(size, nullptr);
+            }
+            for (size_t j = 0; j < size; j++) {
+                table->m_positions[j] = m_reader.get<uint64_t>();
+                if (isStringTable) {
+                    size_t idx = m_reader.get<uint64_t>();
+                    table->m_keys[j] = idx == CODE_CACHE_NO_INDEX ? nullptr : stringAt(idx);
+                }
+            }
+            block->m_literalData.pushBack(table);
+            tables.push_back(table);
+        }
+
+        size_t codeSize = m_reader.get<uint64_t>();
+        const char* src = m_reader.getBytes(codeSize);
+        if (!src) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < records.size(); i++) {
+            if (records[i]->wordValue() >= codeSize) {
+                return nullptr;
+            }
+        }
+        for (size_t i = 0; i < tables.size(); i++) {
+            for (size_t j = 0; j < tables[i]->m_positions.size(); j++) {
+                size_t pos = tables[i]->m_positions[j];
+                if (pos != SIZE_MAX && pos >= codeSize) {
+                    return nullptr;
+                }
+            }
+        }
+        block->m_code.resizeWithUninitializedValues(codeSize);
+        memcpy(block->m_code.data(), src, codeSize);
+
+        char* code = block->m_code.data();
+        size_t codeBase = (size_t)code;
+        size_t position = 0;
+        while (position < codeSize) {
+            if (codeSize - position < sizeof(ByteCode)) {
+                return nullptr;
+            }
+            ByteCode* currentCode = (ByteCode*)(code + position);
+#if defined(COMPILER_GCC)
+            size_t opcode = (size_t)currentCode->m_opcodeInAddress;
+#else
+            size_t opcode = currentCode->m_opcode;
+#endif
+            if (opcode >= OpcodeKindEnd || codeSize - position < byteCodeLengths[opcode]) {
+                return nullptr;
+            }
+
+            switch (opcode) {
+            case LoadLiteralOpcode: {
+                LoadLiteral* cd = (LoadLiteral*)currentCode;
+                size_t idx = getIndex(cd->m_value);
+                if (idx >= literals.size()) {
+                    return nullptr;
+                }
+                cd->m_value = literals[idx];
+                if (cd->m_value.isPointerValue()) {
+                    block->m_literalData.pushBack(cd->m_value.asPointerValue());
+                }
+                break;
+            }
+            case LoadByNameOpcode:
+                decodeField(block, ((LoadByName*)currentCode)->m_name);
+                break;
+            case StoreByNameOpcode:
+                decodeField(block, ((StoreByName*)currentCode)->m_name);
+                break;
+            case DeclareFunctionDeclarationsOpcode:
+                decodeField(block, ((DeclareFunctionDeclarations*)currentCode)->m_codeBlock);
+                break;
+            case CreateFunctionOpcode:
+                decodeField(block, ((CreateFunction*)currentCode)->m_codeBlock);
+                break;
+            case CreateClassOpcode: {
+                CreateClass* cd = (CreateClass*)currentCode;
+                decodeField(block, cd->m_name);
+                decodeField(block, cd->m_codeBlock);
+                break;
+            }
+            case ObjectDefineOwnPropertyWithNameOperationOpcode:
+                decodeField(block, ((ObjectDefineOwnPropertyWithNameOperation*)currentCode)->m_propertyName);
+                break;
+            case GetObjectPreComputedCaseOpcode: {
+                GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
+                new (&cd->m_inlineCache) GetObjectInlineCache();
+                decodeField(block, cd->m_propertyName);
+                break;
+            }
+            case SetObjectPreComputedCaseOpcode: {
+                SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)currentCode;
+                cd->m_inlineCache = new SetObjectInlineCache();
+                block->m_literalData.pushBack(cd->m_inlineCache);
+                decodeField(block, cd->m_propertyName);
+                break;
+            }
+            case GetGlobalObjectOpcode:
+                decodeField(block, ((GetGlobalObject*)currentCode)->m_propertyName);
+                break;
+            case SetGlobalObjectOpcode:
+                decodeField(block, ((SetGlobalObject*)currentCode)->m_propertyName);
+                break;
+            case UnaryTypeofOpcode:
+                decodeField(block, ((UnaryTypeof*)currentCode)->m_id);
+                break;
+            case UnaryDeleteOpcode:
+                decodeField(block, ((UnaryDelete*)currentCode)->m_id);
+                break;
+            case TemplateOperationOpcode:
+                decodeField(block, ((TemplateOperation*)currentCode)->m_quasi);
+                break;
+            case JumpOpcode: {
+                Jump* cd = (Jump*)currentCode;
+                if (cd->m_jumpPosition >= codeSize) {
+                    return nullptr;
+                }
+                cd->m_jumpPosition += codeBase;
+                break;
+            }
+            case JumpIfTrueOpcode:
+            case JumpIfFalseOpcode:
+            case JumpIfRelationOpcode:
+            case JumpIfEqualOpcode: {
+                JumpByteCode* cd = (JumpByteCode*)currentCode;
+                if (cd->m_jumpPosition >= codeSize) {
+                    return nullptr;
+                }
+                cd->m_jumpPosition += codeBase;
+                break;
+            }
+            case JumpComplexCaseOpcode: {
+                JumpComplexCase* cd = (JumpComplexCase*)currentCode;
+                size_t idx = getIndex(cd->m_controlFlowRecord);
+                if (idx >= records.size()) {
+                    return nullptr;
+                }
+                cd->m_controlFlowRecord = records[idx];
+                break;
+            }
+            case SwitchJumpTableOpcode: {
+                SwitchJumpTable* cd = (SwitchJumpTable*)currentCode;
+                size_t idx = getIndex(cd->m_table);
+                if (idx >= tables.size()) {
+                    return nullptr;
+                }
+                cd->m_table = tables[idx];
+                break;
+            }
+            case CallFunctionInWithScopeOpcode:
+                decodeField(block, ((CallFunctionInWithScope*)currentCode)->m_calleeName);
+                break;
+            case TryOperationOpcode:
+                decodeField(block, ((TryOperation*)currentCode)->m_catchVariableName);
+                break;
+            case ThrowStaticErrorOperationOpcode: {
+                ThrowStaticErrorOperation* cd = (ThrowStaticErrorOperation*)currentCode;
+                String* message = stringAt(getIndex(cd->m_errorMessage));
+                std::string utf8 = message->toNonGCUTF8StringData();
+                char* data = (char*)GC_MALLOC_ATOMIC(utf8.size() + 1);
+                memcpy(data, utf8.data(), utf8.size());
+                data[utf8.size()] = 0;
+                block->m_literalData.pushBack(data);
+                cd->m_errorMessage = data;
+                break;
+            }
+            case LoadRegexpOpcode: {
+                LoadRegexp* cd = (LoadRegexp*)currentCode;
+                decodeField(block, cd->m_body);
+                decodeField(block, cd->m_option);
+                break;
+            }
+            default:
+                break;
+            }
+
+            currentCode->assignOpcodeInAddress();
+            position += byteCodeLengths[opcode];
+        }
+
+        if (m_reader.hasError()) {
+            return nullptr;
+        }
+        return block;
+    }
+
+    Context* m_context;
+    String* m_source;
+    CodeCacheReader m_reader;
+    // GC is disabled while decoding. decoded objects are reachable from the script after that
+    std::vector<String*> m_strings;
+    std::vector<bool> m_isAtomicString;
+    std::vector<InterpretedCodeBlock*> m_codeBlocks;
+};
+
+uint64_t CodeCache::sourceHash(String* source)
+{
+    return sourceHash(source->bufferAccessData());
+}
+
+uint64_t CodeCache::sourceHash(const StringBufferAccessData& buffer)
+{
+    uint64_t hash = CODE_CACHE_HASH_OFFSET;
+    if (buffer.has8BitContent) {
+        const LChar* src = (const LChar*)buffer.buffer;
+        for (size_t i = 0; i < buffer.length; i++) {
+            hash = (hash ^ src[i]) * CODE_CACHE_HASH_PRIME;
+        }
+    } else {
+        const char16_t* src = (const char16_t*)buffer.buffer;
+        for (size_t i = 0; i < buffer.length; i++) {
+            hash = (hash ^ src[i]) * CODE_CACHE_HASH_PRIME;
+        }
+    }
+    return hash;
+}
+
+bool CodeCache::store(Context* context, Script* script, CodeCacheData& data)
+{
+    if (!script->hasPreparedByteCodeBlock()) {
+        return false;
+    }
+    Encoder encoder(script);
+    return encoder.encode(script, data);
+}
+
+Script* CodeCache::load(Context* context, String* source, String* fileName, const char* data, size_t length)
+{
+    if (!isValid(source->bufferAccessData(), data, length)) {
+        return nullptr;
+    }
+    return loadValidData(context, source, fileName, data, length);
+}
+
+bool CodeCache::isValid(const StringBufferAccessData& source, const char* data, size_t length)
+{
+    CodeCacheHeader header;
+    if (length < sizeof(CodeCacheHeader)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(CodeCacheHeader));
+    data += sizeof(CodeCacheHeader);
+    length -= sizeof(CodeCacheHeader);
+
+    if (header.magic != CODE_CACHE_MAGIC || header.version != ESCARGOT_CODE_CACHE_VERSION || header.layoutHash != layoutHash()) {
+        return false;
+    }
+    if (header.sourceLength != source.length || header.sourceHash != sourceHash(source)) {
+        return false;
+    }
+    if (header.payloadLength != length || header.payloadHash != hashBytes(CODE_CACHE_HASH_OFFSET, data, length)) {
+        return false;
+    }
+    return true;
+}
+
+Script* CodeCache::loadValidData(Context* context, String* source, String* fileName, const char* data, size_t length)
+{
+    ASSERT(length >= sizeof(CodeCacheHeader));
+    Decoder decoder(context, source, data + sizeof(CodeCacheHeader), length - sizeof(CodeCacheHeader));
+    return decoder.decode(fileName);
+}
+
+bool CodeCache::readFile(const char* path, CodeCacheData& data)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    bool result = false;
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        long size = ftell(fp);
+        if (size > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+            data.resize(size);
+            result = fread(data.data(), 1, size, fp) == (size_t)size;
+        }
+    }
+    fclose(fp);
+    return result;
+}
+
+bool CodeCache::writeFile(const char* path, const CodeCacheData& data)
+{
+    // write into temporary file first, so other processes never see a partially written cache
+    std::string tempPath = std::string(path) + ".tmp";
+    FILE* fp = fopen(tempPath.data(), "wb");
+    if (!fp) {
+        return false;
+    }
+    bool result = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    result = (fclose(fp) == 0) && result;
+    if (result) {
+        result = rename(tempPath.data(), path) == 0;
+    }
+    if (!result) {
+        remove(tempPath.data());
+    }
+    return result;
+}
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotCodeCache__
+#define __EscargotCodeCache__
+
+namespace Escargot {
+
+class Context;
+class Script;
+class String;
+struct StringBufferAccessData;
+
+// bump this when the cache layout changes
+#define ESCARGOT_CODE_CACHE_VERSION 2
+
+typedef std::vector<char> CodeCacheData;
+
+// Code cache stores the InterpretedCodeBlock tree of a script and the bytecode of its global code.
+// Pointers in the opcode stream (code blocks, strings, atomic strings, jump targets, inline caches)
+// are written as table indexes or relative positions, and re-linked on load.
+// Cache is only valid for the same source and the same engine build.
+// Function bytecode is not stored; it is generated from source on first call as usual.
+class CodeCache {
+public:
+    static uint64_t sourceHash(String* source);
+    static uint64_t sourceHash(const StringBufferAccessData& source);
+
+    // returns false if script cannot be stored (e.g. bytecode of global code is not generated)
+    static bool store(Context* context, Script* script, CodeCacheData& data);
+    // returns nullptr if data is made from other source or by other engine build, or is corrupted
+    // GC should be disabled while loading
+    static Script* load(Context* context, String* source, String* fileName, const char* data, size_t length);
+    // checks data is made from source by this build without touching GC heap, so it can be called from other threads
+    static bool isValid(const StringBufferAccessData& source, const char* data, size_t length);
+    // loads data which passed isValid
+    static Script* loadValidData(Context* context, String* source, String* fileName, const char* data, size_t length);
+
+    static bool readFile(const char* path, CodeCacheData& data);
+    static bool writeFile(const char* path, const CodeCacheData& data);
+
+private:
+    class Encoder;
+    class Decoder;
+};
+}
+
+#endif
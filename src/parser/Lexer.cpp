@@ -43,6 +43,17 @@ const char* Messages::TemplateOctalLiteral = "Octal literals are not allowed in
  * value can represent an invalid octal value. */
 #define NON_OCTAL_VALUE 256
 
+// strings of tokens are only used while parsing, so they are allocated with AST of current parse
+template <typename... Args>
+static ALWAYS_INLINE StringView* newTokenString(Args&&... args)
+{
+    ASTAllocator* allocator = ASTAllocator::current();
+    if (LIKELY(allocator != nullptr)) {
+        return new (allocator->allocate(sizeof(StringView))) StringView(std::forward<Args>(args)...);
+    }
+    return new StringView(std::forward<Args>(args)...);
+}
+
 char EscargotLexer::g_asciiRangeCharMap[128] = {
     0,
     0,
@@ -609,7 +620,7 @@ void Scanner::ScannerResult::constructStringLiteral()
     } else {
         newStr = new UTF16String(stringUTF16.data(), stringUTF16.length());
     }
-    this->valueStringLiteralData = new StringView(newStr, 0, newStr->length());
+    this->valueStringLiteralData = newTokenString(newStr, 0, newStr->length());
 }
 
 Scanner::Scanner(::Escargot::Context* escargotContext, StringView code, ErrorHandler* handler, size_t startLine, size_t startColumn)
@@ -620,52 +631,15 @@ Scanner::Scanner(::Escargot::Context* escargotContext, StringView code, ErrorHan
     , index(0)
     , lineNumber(((length > 0) ? 1 : 0) + startLine)
     , lineStart(startColumn)
+    , preScannedTokens(nullptr)
+    , preScannedTokenCursor(0)
+    , matchedPreScannedToken(nullptr)
 {
     ASSERT(escargotContext != nullptr);
     ASSERT(handler != nullptr);
     // trackComment = false;
 }
 
-void Scanner::skipSingleLineComment(void)
-{
-    while (!this->eof()) {
-        char16_t ch = this->peekChar();
-        ++this->index;
-
-        if (isLineTerminator(ch)) {
-            if (ch == 13 && this->peekChar() == 10) {
-                ++this->index;
-            }
-            ++this->lineNumber;
-            this->lineStart = this->index;
-            // return comments;
-            return;
-        }
-    }
-}
-
-void Scanner::skipMultiLineComment(void)
-{
-    while (!this->eof()) {
-        char16_t ch = this->peekChar();
-        ++this->index;
-
-        if (isLineTerminator(ch)) {
-            if (ch == 0x0D && this->peekChar() == 0x0A) {
-                ++this->index;
-            }
-            ++this->lineNumber;
-            this->lineStart = this->index;
-        } else if (ch == 0x2A && this->peekChar() == 0x2F) {
-            // Block comment ends with '*/'.
-            ++this->index;
-            return;
-        }
-    }
-
-    throwUnexpectedToken();
-}
-
 char32_t Scanner::scanHexEscape(char prefix)
 {
     size_t len = (prefix == 'u') ? 4 : 2;
@@ -731,7 +705,7 @@ StringView* Scanner::getIdentifier()
         }
     }
 
-    return new StringView(this->source, start, this->index);
+    return newTokenString(this->source, start, this->index);
 }
 
 StringView* Scanner::getComplexIdentifier()
@@ -798,7 +772,7 @@ StringView* Scanner::getComplexIdentifier()
     }
 
     String* str = new UTF16String(id.data(), id.length());
-    return new StringView(str, 0, str->length());
+    return newTokenString(str, 0, str->length());
 }
 
 uint16_t Scanner::octalToDecimal(char16_t ch, bool octal)
@@ -826,15 +800,11 @@ uint16_t Scanner::octalToDecimal(char16_t ch, bool octal)
     return octal ? code : NON_OCTAL_VALUE;
 };
 
-void Scanner::scanPunctuator(Scanner::ScannerResult* token, char16_t ch)
+// index is next to ch. returns PunctuatorKindEnd if ch does not start a punctuator
+template <typename Source>
+static ALWAYS_INLINE PunctuatorKind scanPunctuatorKind(const Source& source, size_t& index, char16_t ch)
 {
-    ASSERT(token != nullptr);
-    token->setResult(this, Token::PunctuatorToken, this->lineNumber, this->lineStart, this->index, this->index);
-
     PunctuatorKind kind;
-    // Check for most common single-character punctuators.
-    ++this->index;
-
     switch (ch) {
     case '(':
         kind = LeftParenthesis;
@@ -846,9 +816,9 @@ void Scanner::scanPunctuator(Scanner::ScannerResult* token, char16_t ch)
 
     case '.':
         kind = Period;
-        if (this->peekChar() == '.' && this->source.bufferedCharAt(this->index + 1) == '.') {
+        if (source.bufferedCharAt(index) == '.' && source.bufferedCharAt(index + 1) == '.') {
             // Spread operator "..."
-            this->index += 2;
+            index += 2;
             kind = PeriodPeriodPeriod;
         }
         break;
@@ -882,176 +852,190 @@ void Scanner::scanPunctuator(Scanner::ScannerResult* token, char16_t ch)
         break;
 
     case '>':
-        ch = this->peekChar();
+        ch = source.bufferedCharAt(index);
         kind = RightInequality;
 
         if (ch == '>') {
-            ++this->index;
-            ch = this->peekChar();
+            ++index;
+            ch = source.bufferedCharAt(index);
             kind = RightShift;
 
             if (ch == '>') {
-                ++this->index;
+                ++index;
                 kind = UnsignedRightShift;
 
-                if (this->peekChar() == '=') {
-                    ++this->index;
+                if (source.bufferedCharAt(index) == '=') {
+                    ++index;
                     kind = UnsignedRightShiftEqual;
                 }
             } else if (ch == '=') {
                 kind = RightShiftEqual;
-                ++this->index;
+                ++index;
             }
         } else if (ch == '=') {
             kind = RightInequalityEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '<':
-        ch = this->peekChar();
+        ch = source.bufferedCharAt(index);
         kind = LeftInequality;
 
         if (ch == '<') {
-            ++this->index;
+            ++index;
             kind = LeftShift;
 
-            if (this->peekChar() == '=') {
+            if (source.bufferedCharAt(index) == '=') {
                 kind = LeftShiftEqual;
-                ++this->index;
+                ++index;
             }
         } else if (ch == '=') {
             kind = LeftInequalityEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '=':
-        ch = this->peekChar();
+        ch = source.bufferedCharAt(index);
         kind = Substitution;
 
         if (ch == '=') {
-            ++this->index;
+            ++index;
             kind = Equal;
 
-            if (this->peekChar() == '=') {
+            if (source.bufferedCharAt(index) == '=') {
                 kind = StrictEqual;
-                ++this->index;
+                ++index;
             }
         } else if (ch == '>') {
             kind = Arrow;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '!':
         kind = ExclamationMark;
 
-        if (this->peekChar() == '=') {
-            ++this->index;
+        if (source.bufferedCharAt(index) == '=') {
+            ++index;
             kind = NotEqual;
 
-            if (this->peekChar() == '=') {
+            if (source.bufferedCharAt(index) == '=') {
                 kind = NotStrictEqual;
-                ++this->index;
+                ++index;
             }
         }
         break;
 
     case '&':
-        ch = this->peekChar();
+        ch = source.bufferedCharAt(index);
         kind = BitwiseAnd;
 
         if (ch == '&') {
             kind = LogicalAnd;
-            ++this->index;
+            ++index;
         } else if (ch == '=') {
             kind = BitwiseAndEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '|':
-        ch = this->peekChar();
+        ch = source.bufferedCharAt(index);
         kind = BitwiseOr;
 
         if (ch == '|') {
             kind = LogicalOr;
-            ++this->index;
+            ++index;
         } else if (ch == '=') {
             kind = BitwiseOrEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '^':
         kind = BitwiseXor;
 
-        if (this->peekChar() == '=') {
+        if (source.bufferedCharAt(index) == '=') {
             kind = BitwiseXorEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '+':
-        ch = this->peekChar();
+        ch = source.bufferedCharAt(index);
         kind = Plus;
 
         if (ch == '+') {
             kind = PlusPlus;
-            ++this->index;
+            ++index;
         } else if (ch == '=') {
             kind = PlusEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '-':
-        ch = this->peekChar();
+        ch = source.bufferedCharAt(index);
         kind = Minus;
 
         if (ch == '-') {
             kind = MinusMinus;
-            ++this->index;
+            ++index;
         } else if (ch == '=') {
             kind = MinusEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '*':
         kind = Multiply;
 
-        if (this->peekChar() == '=') {
+        if (source.bufferedCharAt(index) == '=') {
             kind = MultiplyEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '/':
         kind = Divide;
 
-        if (this->peekChar() == '=') {
+        if (source.bufferedCharAt(index) == '=') {
             kind = DivideEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     case '%':
         kind = Mod;
 
-        if (this->peekChar() == '=') {
+        if (source.bufferedCharAt(index) == '=') {
             kind = ModEqual;
-            ++this->index;
+            ++index;
         }
         break;
 
     default:
-        this->throwUnexpectedToken();
         kind = PunctuatorKindEnd;
         break;
     }
 
+    return kind;
+}
+
+void Scanner::scanPunctuator(Scanner::ScannerResult* token, char16_t ch)
+{
+    ASSERT(token != nullptr);
+    token->setResult(this, Token::PunctuatorToken, this->lineNumber, this->lineStart, this->index, this->index);
+
+    // Check for most common single-character punctuators.
+    ++this->index;
+    PunctuatorKind kind = scanPunctuatorKind(this->source, this->index, ch);
+    if (UNLIKELY(kind == PunctuatorKindEnd)) {
+        this->throwUnexpectedToken();
+    }
+
     token->valuePunctuatorKind = kind;
 }
 
@@ -1179,6 +1163,17 @@ bool Scanner::isImplicitOctalLiteral()
     return true;
 }
 
+static double decimalLiteralToDouble(const std::string& number)
+{
+    int length_dummy;
+    double_conversion::StringToDoubleConverter converter(double_conversion::StringToDoubleConverter::ALLOW_HEX
+                                                             | double_conversion::StringToDoubleConverter::ALLOW_LEADING_SPACES
+                                                             | double_conversion::StringToDoubleConverter::ALLOW_TRAILING_SPACES,
+                                                         0.0, double_conversion::Double::NaN(),
+                                                         "Infinity", "NaN");
+    return converter.StringToDouble(number.data(), number.length(), &length_dummy);
+}
+
 void Scanner::scanNumericLiteral(Scanner::ScannerResult* token)
 {
     ASSERT(token != nullptr);
@@ -1263,13 +1258,7 @@ void Scanner::scanNumericLiteral(Scanner::ScannerResult* token)
     }
 
     int length = number.length();
-    int length_dummy;
-    double_conversion::StringToDoubleConverter converter(double_conversion::StringToDoubleConverter::ALLOW_HEX
-                                                             | double_conversion::StringToDoubleConverter::ALLOW_LEADING_SPACES
-                                                             | double_conversion::StringToDoubleConverter::ALLOW_TRAILING_SPACES,
-                                                         0.0, double_conversion::Double::NaN(),
-                                                         "Infinity", "NaN");
-    double ll = converter.StringToDouble(number.data(), length, &length_dummy);
+    double ll = decimalLiteralToDouble(number);
 
     token->setResult(this, Token::NumericLiteralToken, ll, this->lineNumber, this->lineStart, start, this->index);
     if (startChar == '0' && length >= 2 && ll >= 1) {
@@ -1346,13 +1335,13 @@ void Scanner::scanStringLiteral(Scanner::ScannerResult* token)
     }
 
     if (isPlainCase) {
-        StringView* str = new StringView(this->source, start + 1, this->index - 1);
+        StringView* str = newTokenString(this->source, start + 1, this->index - 1);
         token->setResult(this, Token::StringLiteralToken, str, this->lineNumber, this->lineStart, start, this->index, true);
         token->octal = octal;
         token->plain = true;
     } else {
         // build string if needs
-        token->setResult(this, Token::StringLiteralToken, new StringView(), this->lineNumber, this->lineStart, start, this->index, false);
+        token->setResult(this, Token::StringLiteralToken, newTokenString(), this->lineNumber, this->lineStart, start, this->index, false);
         token->octal = octal;
         token->plain = false;
     }
@@ -1772,38 +1761,42 @@ static ALWAYS_INLINE KeywordKind isKeyword(const StringBufferAccessData& data)
     return NotKeyword;
 }
 
+// returns KeywordToken and sets keywordKind if data is a keyword
+static ALWAYS_INLINE Token identifierNameType(const StringBufferAccessData& data, KeywordKind& keywordKind)
+{
+    // There is no keyword or literal with only one character.
+    // Thus, it must be an identifier.
+    if (data.length == 1) {
+        return Token::IdentifierToken;
+    } else if ((keywordKind = isKeyword(data))) {
+        return Token::KeywordToken;
+    } else if (data.length == 4) {
+        if (data.equalsSameLength("null")) {
+            return Token::NullLiteralToken;
+        } else if (data.equalsSameLength("true")) {
+            return Token::BooleanLiteralToken;
+        }
+    } else if (data.length == 5 && data.equalsSameLength("false")) {
+        return Token::BooleanLiteralToken;
+    }
+    return Token::IdentifierToken;
+}
+
 ALWAYS_INLINE void Scanner::scanIdentifier(Scanner::ScannerResult* token, char16_t ch0)
 {
     ASSERT(token != nullptr);
-    Token type;
     const size_t start = this->index;
 
     // Backslash (U+005C) starts an escaped character.
     StringView* id = UNLIKELY(ch0 == 0x5C) ? this->getComplexIdentifier() : this->getIdentifier();
 
-    // There is no keyword or literal with only one character.
-    // Thus, it must be an identifier.
     KeywordKind keywordKind;
-    auto data = id->StringView::bufferAccessData();
-    if (data.length == 1) {
-        type = Token::IdentifierToken;
-    } else if ((keywordKind = isKeyword(data))) {
+    Token type = identifierNameType(id->StringView::bufferAccessData(), keywordKind);
+    if (type == Token::KeywordToken) {
         token->setResult(this, Token::KeywordToken, this->lineNumber, this->lineStart, start, this->index);
         token->valueKeywordKind = keywordKind;
         token->hasKeywordButUseString = false;
         return;
-    } else if (data.length == 4) {
-        if (data.equalsSameLength("null")) {
-            type = Token::NullLiteralToken;
-        } else if (data.equalsSameLength("true")) {
-            type = Token::BooleanLiteralToken;
-        } else {
-            type = Token::IdentifierToken;
-        }
-    } else if (data.length == 5 && data.equalsSameLength("false")) {
-        type = Token::BooleanLiteralToken;
-    } else {
-        type = Token::IdentifierToken;
     }
 
     token->setResult(this, type, id, this->lineNumber, this->lineStart, start, this->index, id->string() == this->source.string());
@@ -1812,6 +1805,10 @@ ALWAYS_INLINE void Scanner::scanIdentifier(Scanner::ScannerResult* token, char16
 void Scanner::lex(Scanner::ScannerResult* token)
 {
     ASSERT(token != nullptr);
+    if (UNLIKELY(this->matchedPreScannedToken != nullptr) && this->lexPreScannedToken(token)) {
+        return;
+    }
+
     if (UNLIKELY(this->eof())) {
         token->setResult(this, Token::EOFToken, this->lineNumber, this->lineStart, this->index, this->index);
         return;
@@ -1858,4 +1855,344 @@ ScanID:
     this->scanIdentifier(token, cp);
     return;
 }
+
+bool Scanner::skipPreScannedComments()
+{
+    const PreScannedToken* token = this->preScannedTokens->find(this->index, this->preScannedTokenCursor);
+    if (!token) {
+        this->preScannedTokens->countMissed();
+        this->matchedPreScannedToken = nullptr;
+        return false;
+    }
+
+    this->index = token->start;
+    if (token->lineBreaks) {
+        this->lineNumber += token->lineBreaks;
+        this->lineStart = token->lineStart;
+    }
+    this->matchedPreScannedToken = token->type != Token::InvalidToken ? token : nullptr;
+    return true;
+}
+
+bool Scanner::lexPreScannedToken(Scanner::ScannerResult* token)
+{
+    const PreScannedToken* preScanned = this->matchedPreScannedToken;
+    this->matchedPreScannedToken = nullptr;
+    // parser can rescan from other position after scanComments (e.g. regular expressions)
+    if (preScanned->start != this->index) {
+        this->preScannedTokens->countMissed();
+        return false;
+    }
+
+    // results are same as the results of scanning the source again
+    switch (preScanned->type) {
+    case Token::EOFToken:
+        ASSERT(this->eof());
+        token->setResult(this, Token::EOFToken, this->lineNumber, this->lineStart, this->index, this->index);
+        break;
+    case Token::PunctuatorToken:
+        // end of punctuators is not updated by scanPunctuator
+        token->setResult(this, Token::PunctuatorToken, this->lineNumber, this->lineStart, preScanned->start, preScanned->start);
+        token->valuePunctuatorKind = preScanned->valuePunctuatorKind;
+        break;
+    case Token::KeywordToken:
+        token->setResult(this, Token::KeywordToken, this->lineNumber, this->lineStart, preScanned->start, preScanned->end);
+        token->valueKeywordKind = preScanned->valueKeywordKind;
+        token->hasKeywordButUseString = false;
+        break;
+    case Token::IdentifierToken:
+    case Token::NullLiteralToken:
+    case Token::BooleanLiteralToken: {
+        StringView* id = newTokenString(this->source, preScanned->start, preScanned->end);
+        token->setResult(this, (Token)preScanned->type, id, this->lineNumber, this->lineStart, preScanned->start, preScanned->end, id->string() == this->source.string());
+        break;
+    }
+    case Token::NumericLiteralToken:
+        token->setResult(this, Token::NumericLiteralToken, preScanned->valueNumber, this->lineNumber, this->lineStart, preScanned->start, preScanned->end);
+        token->startWithZero = preScanned->startWithZero;
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+    this->index = preScanned->end;
+    this->preScannedTokens->countReplayed();
+    return true;
+}
+
+// reads buffer of a source without touching GC heap
+struct PreScanSource {
+    explicit PreScanSource(const StringBufferAccessData& data)
+        : m_data(data)
+    {
+    }
+
+    char16_t bufferedCharAt(size_t idx) const
+    {
+        return m_data.charAt(idx);
+    }
+
+    const StringBufferAccessData& m_data;
+};
+
+// returns false if the identifier should be scanned by Scanner (escaped or surrogate pair characters)
+static bool preScanIdentifier(const PreScanSource& source, size_t length, size_t& index, PreScannedToken& token)
+{
+    const size_t start = index;
+    bool isSimple = true;
+    while (index < length) {
+        const char16_t ch = source.bufferedCharAt(index);
+        if (UNLIKELY(ch == 0x5C || (ch >= 0xD800 && ch < 0xDFFF))) {
+            isSimple = false;
+        } else if (!isIdentifierPart(ch) && index != start) {
+            break;
+        }
+        ++index;
+    }
+    if (!isSimple) {
+        return false;
+    }
+
+    StringBufferAccessData data = source.m_data;
+    data.hasSpecialImpl = false;
+    data.hash = 0;
+    data.length = index - start;
+    if (data.has8BitContent) {
+        data.buffer = ((const LChar*)data.buffer) + start;
+    } else {
+        data.buffer = ((const char16_t*)data.buffer) + start;
+    }
+    KeywordKind keywordKind = NotKeyword;
+    token.type = identifierNameType(data, keywordKind);
+    if (token.type == Token::KeywordToken) {
+        token.valueKeywordKind = keywordKind;
+    }
+    return true;
+}
+
+// returns false if the literal should be scanned by Scanner (e.g. hex, octal, or invalid literals)
+static bool preScanNumericLiteral(const PreScanSource& source, size_t length, size_t& index, PreScannedToken& token)
+{
+    const size_t start = index;
+    const char16_t startChar = source.bufferedCharAt(index);
+    bool isDecimal = true;
+    if (startChar == '0') {
+        const char16_t ch = source.bufferedCharAt(index + 1) | 0x20;
+        isDecimal = !isDecimalDigit(ch) && ch != 'x' && ch != 'b' && ch != 'o';
+    }
+
+    std::string number;
+    while (isDecimal && index < length) {
+        const char16_t ch = source.bufferedCharAt(index);
+        if (isDecimalDigit(ch)) {
+            number += ch;
+            ++index;
+        } else if (ch == '.' && number.find_first_of(".eE") == std::string::npos) {
+            number += ch;
+            ++index;
+        } else if ((ch == 'e' || ch == 'E') && number.find_first_of("eE") == std::string::npos) {
+            number += ch;
+            ++index;
+            const char16_t sign = source.bufferedCharAt(index);
+            if (sign == '+' || sign == '-') {
+                number += sign;
+                ++index;
+            }
+            isDecimal = isDecimalDigit(source.bufferedCharAt(index));
+        } else {
+            break;
+        }
+    }
+
+    if (!isDecimal || isIdentifierStart(source.bufferedCharAt(index))) {
+        index = start;
+        while (index < length && (isIdentifierPart(source.bufferedCharAt(index)) || source.bufferedCharAt(index) == '.')) {
+            ++index;
+        }
+        return false;
+    }
+
+    token.type = Token::NumericLiteralToken;
+    token.valueNumber = decimalLiteralToDouble(number);
+    token.startWithZero = startChar == '0' && number.length() >= 2 && token.valueNumber >= 1;
+    return true;
+}
+
+// index is next to the quote
+static bool skipStringLiteral(const PreScanSource& source, size_t length, size_t& index, char16_t quote)
+{
+    while (index < length) {
+        const char16_t ch = source.bufferedCharAt(index++);
+        if (ch == quote) {
+            return true;
+        } else if (ch == 0x5C) {
+            if (source.bufferedCharAt(index) == 0x0D && source.bufferedCharAt(index + 1) == 0x0A) {
+                ++index;
+            }
+            ++index;
+        } else if (isLineTerminator(ch)) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// index is next to '`' or '}' of a substitution. '${' pushes a substitution into braces
+static bool skipTemplate(const PreScanSource& source, size_t length, size_t& index, std::vector<bool>& braces)
+{
+    while (index < length) {
+        const char16_t ch = source.bufferedCharAt(index++);
+        if (ch == '`') {
+            return true;
+        } else if (ch == '$' && source.bufferedCharAt(index) == '{') {
+            ++index;
+            braces.push_back(true);
+            return true;
+        } else if (ch == 0x5C) {
+            ++index;
+        }
+    }
+    return false;
+}
+
+// index is next to '/'
+static bool skipRegExp(const PreScanSource& source, size_t length, size_t& index)
+{
+    bool inClass = false;
+    while (index < length) {
+        const char16_t ch = source.bufferedCharAt(index++);
+        if (ch == 0x5C) {
+            if (isLineTerminator(source.bufferedCharAt(index))) {
+                return false;
+            }
+            ++index;
+        } else if (isLineTerminator(ch)) {
+            return false;
+        } else if (inClass) {
+            inClass = ch != ']';
+        } else if (ch == '[') {
+            inClass = true;
+        } else if (ch == '/') {
+            while (index < length && isIdentifierPart(source.bufferedCharAt(index))) {
+                ++index;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void PreScannedTokens::scan(const StringBufferAccessData& data)
+{
+    ASSERT(m_tokens.empty());
+    PreScanSource source(data);
+    const size_t length = data.length;
+    size_t index = 0;
+    size_t lineNumber = 0;
+    size_t lineStart = 0;
+    // Scanner does not know whether '/' starts a regular expression, because parser decides it.
+    // so it is guessed from the previous token, and a wrong guess only makes Scanner miss pre-scanned tokens
+    bool regExpAllowed = true;
+    // braces of code are false, and substitutions of template literals are true
+    std::vector<bool> braces;
+
+    while (true) {
+        PreScannedToken token;
+        token.commentStart = index;
+        size_t lineNumberBefore = lineNumber;
+        if (!skipWhiteSpacesAndComments(source, length, index, lineNumber, lineStart)) {
+            return;
+        }
+        token.start = index;
+        token.lineBreaks = lineNumber - lineNumberBefore;
+        token.lineStart = lineStart;
+        token.type = Token::InvalidToken;
+        token.startWithZero = false;
+        token.valueNumber = 0;
+
+        if (index >= length) {
+            token.type = Token::EOFToken;
+            token.end = index;
+            m_tokens.push_back(token);
+            return;
+        }
+
+        // same order as Scanner::lex
+        const char16_t ch = source.bufferedCharAt(index);
+        bool shouldSkipTemplate = false;
+        bool shouldSkipRegExp = false;
+        if (isIdentifierStart(ch) || UNLIKELY(ch >= 0xD800 && ch < 0xDFFF)) {
+            preScanIdentifier(source, length, index, token);
+            regExpAllowed = token.type == Token::KeywordToken && token.valueKeywordKind != ThisKeyword && token.valueKeywordKind != SuperKeyword;
+        } else if (ch == 0x27 || ch == 0x22) {
+            ++index;
+            if (!skipStringLiteral(source, length, index, ch)) {
+                return;
+            }
+            regExpAllowed = false;
+        } else if (isDecimalDigit(ch) || (ch == '.' && isDecimalDigit(source.bufferedCharAt(index + 1)))) {
+            preScanNumericLiteral(source, length, index, token);
+            regExpAllowed = false;
+        } else if (ch == '`') {
+            ++index;
+            size_t depth = braces.size();
+            if (!skipTemplate(source, length, index, braces)) {
+                return;
+            }
+            regExpAllowed = braces.size() != depth;
+        } else {
+            ++index;
+            PunctuatorKind kind = scanPunctuatorKind(source, index, ch);
+            if (kind == PunctuatorKindEnd) {
+                return;
+            }
+            token.type = Token::PunctuatorToken;
+            token.valuePunctuatorKind = kind;
+
+            if (kind == LeftBrace) {
+                braces.push_back(false);
+            } else if (kind == RightBrace && braces.size()) {
+                // parser rescans '}' of a substitution as a template
+                shouldSkipTemplate = braces.back();
+                braces.pop_back();
+            } else if ((kind == Divide || kind == DivideEqual) && regExpAllowed) {
+                // parser rescans '/' as a regular expression
+                shouldSkipRegExp = true;
+            }
+            regExpAllowed = kind != RightParenthesis && kind != RightSquareBracket && kind != RightBrace;
+        }
+
+        token.end = index;
+        m_tokens.push_back(token);
+
+        if (shouldSkipTemplate) {
+            size_t depth = braces.size();
+            if (!skipTemplate(source, length, index, braces)) {
+                return;
+            }
+            regExpAllowed = braces.size() != depth;
+        } else if (shouldSkipRegExp) {
+            index = token.start + 1;
+            if (!skipRegExp(source, length, index)) {
+                return;
+            }
+            regExpAllowed = false;
+        }
+    }
+}
+
+const PreScannedToken* PreScannedTokens::find(size_t commentStart, size_t& cursor) const
+{
+    if (cursor < m_tokens.size() && m_tokens[cursor].commentStart == commentStart) {
+        return &m_tokens[cursor++];
+    }
+
+    auto iter = std::lower_bound(m_tokens.begin(), m_tokens.end(), commentStart, [](const PreScannedToken& token, size_t index) -> bool {
+        return token.commentStart < index;
+    });
+    if (iter == m_tokens.end() || iter->commentStart != commentStart) {
+        return nullptr;
+    }
+    cursor = iter - m_tokens.begin() + 1;
+    return &*iter;
+}
 }
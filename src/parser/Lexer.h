@@ -185,6 +185,179 @@ ALWAYS_INLINE bool isWhiteSpaceOrLineTerminator(char16_t ch)
     return UNLIKELY(ch == 0x2028 || ch == 0x2029 || isWhiteSpaceSlowCase(ch));
 }
 
+// ECMA-262 11.4 Comments
+// these helpers only read the source, so they can be used without a Scanner
+
+template <typename Source>
+void skipSingleLineComment(const Source& source, size_t length, size_t& index, size_t& lineNumber, size_t& lineStart)
+{
+    while (index < length) {
+        char16_t ch = source.bufferedCharAt(index);
+        ++index;
+
+        if (isLineTerminator(ch)) {
+            if (ch == 13 && source.bufferedCharAt(index) == 10) {
+                ++index;
+            }
+            ++lineNumber;
+            lineStart = index;
+            return;
+        }
+    }
+}
+
+// returns false if the comment is not terminated
+template <typename Source>
+bool skipMultiLineComment(const Source& source, size_t length, size_t& index, size_t& lineNumber, size_t& lineStart)
+{
+    while (index < length) {
+        char16_t ch = source.bufferedCharAt(index);
+        ++index;
+
+        if (isLineTerminator(ch)) {
+            if (ch == 0x0D && source.bufferedCharAt(index) == 0x0A) {
+                ++index;
+            }
+            ++lineNumber;
+            lineStart = index;
+        } else if (ch == 0x2A && source.bufferedCharAt(index) == 0x2F) {
+            // Block comment ends with '*/'.
+            ++index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// returns false if a multi-line comment is not terminated
+template <typename Source>
+ALWAYS_INLINE bool skipWhiteSpacesAndComments(const Source& source, size_t length, size_t& index, size_t& lineNumber, size_t& lineStart)
+{
+    bool start = (index == 0);
+    while (LIKELY(index < length)) {
+        char16_t ch = source.bufferedCharAt(index);
+
+        if (isWhiteSpace(ch)) {
+            ++index;
+        } else if (isLineTerminator(ch)) {
+            ++index;
+            if (ch == 0x0D && source.bufferedCharAt(index) == 0x0A) {
+                ++index;
+            }
+            ++lineNumber;
+            lineStart = index;
+            start = true;
+        } else if (ch == 0x2F) { // U+002F is '/'
+            ch = source.bufferedCharAt(index + 1);
+            if (ch == 0x2F) {
+                index += 2;
+                skipSingleLineComment(source, length, index, lineNumber, lineStart);
+                start = true;
+            } else if (ch == 0x2A) { // U+002A is '*'
+                index += 2;
+                if (UNLIKELY(!skipMultiLineComment(source, length, index, lineNumber, lineStart))) {
+                    return false;
+                }
+            } else {
+                break;
+            }
+        } else if (start && ch == 0x2D) { // U+002D is '-'
+            // U+003E is '>'
+            if ((source.bufferedCharAt(index + 1) == 0x2D) && (source.bufferedCharAt(index + 2) == 0x3E)) {
+                // '-->' is a single-line comment
+                index += 3;
+                skipSingleLineComment(source, length, index, lineNumber, lineStart);
+            } else {
+                break;
+            }
+        } else if (ch == 0x3C) { // U+003C is '<'
+            if (length > index + 4) {
+                if (source.bufferedCharAt(index + 1) == '!'
+                    && source.bufferedCharAt(index + 2) == '-'
+                    && source.bufferedCharAt(index + 3) == '-') {
+                    index += 4; // `<!--`
+                    skipSingleLineComment(source, length, index, lineNumber, lineStart);
+                } else {
+                    break;
+                }
+            } else {
+                break;
+            }
+
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+// token of a source which is scanned ahead on a worker thread, without touching GC heap and AtomicStringMap.
+// Scanner uses it when it skips comments from commentStart, instead of scanning the source again
+struct PreScannedToken {
+    size_t commentStart;
+    size_t start;
+    size_t end; // index of Scanner after the token
+    size_t lineBreaks; // line terminators between commentStart and start
+    size_t lineStart; // valid only if lineBreaks is not zero
+    unsigned char type; // InvalidToken if the token is left to Scanner
+    bool startWithZero;
+    union {
+        PunctuatorKind valuePunctuatorKind;
+        KeywordKind valueKeywordKind;
+        double valueNumber;
+    };
+};
+
+class PreScannedTokens {
+public:
+    PreScannedTokens()
+        : m_replayedCount(0)
+        , m_missedCount(0)
+    {
+    }
+
+    // punctuators, identifiers, keywords and decimal numeric literals are pre-scanned.
+    // other tokens are skipped, and scanning stops at the first error
+    void scan(const StringBufferAccessData& source);
+
+    // returns the token whose comments start at commentStart, or nullptr
+    // cursor keeps the position of the last lookup, because lookups usually go forward
+    const PreScannedToken* find(size_t commentStart, size_t& cursor) const;
+
+    size_t size() const
+    {
+        return m_tokens.size();
+    }
+
+    // Scanner counts tokens used instead of scanning the source again,
+    // and lookups which found no usable token, on the thread parsing the source
+    void countReplayed() const
+    {
+        m_replayedCount++;
+    }
+
+    void countMissed() const
+    {
+        m_missedCount++;
+    }
+
+    size_t replayedCount() const
+    {
+        return m_replayedCount;
+    }
+
+    size_t missedCount() const
+    {
+        return m_missedCount;
+    }
+
+private:
+    std::vector<PreScannedToken> m_tokens;
+    mutable size_t m_replayedCount;
+    mutable size_t m_missedCount;
+};
+
 struct ScanTemplteResult : public gc {
     UTF16StringData valueCooked;
     StringView raw;
@@ -363,6 +536,12 @@ public:
     size_t lineNumber;
     size_t lineStart;
 
+    // tokens of source pre-scanned on a worker thread. can be nullptr
+    const PreScannedTokens* preScannedTokens;
+    size_t preScannedTokenCursor;
+    // token found by the last scanComments
+    const PreScannedToken* matchedPreScannedToken;
+
     ~Scanner()
     {
     }
@@ -379,65 +558,13 @@ public:
         this->errorHandler->throwError(this->index, this->lineNumber, this->index - this->lineStart + 1, new ASCIIString(message), ErrorObject::SyntaxError);
     }
 
-    // ECMA-262 11.4 Comments
-
-    void skipSingleLineComment(void);
-    void skipMultiLineComment(void);
-
     ALWAYS_INLINE void scanComments()
     {
-        bool start = (this->index == 0);
-        while (LIKELY(!this->eof())) {
-            char16_t ch = this->source.bufferedCharAt(this->index);
-
-            if (isWhiteSpace(ch)) {
-                ++this->index;
-            } else if (isLineTerminator(ch)) {
-                ++this->index;
-                if (ch == 0x0D && this->source.bufferedCharAt(this->index) == 0x0A) {
-                    ++this->index;
-                }
-                ++this->lineNumber;
-                this->lineStart = this->index;
-                start = true;
-            } else if (ch == 0x2F) { // U+002F is '/'
-                ch = this->source.bufferedCharAt(this->index + 1);
-                if (ch == 0x2F) {
-                    this->index += 2;
-                    this->skipSingleLineComment();
-                    start = true;
-                } else if (ch == 0x2A) { // U+002A is '*'
-                    this->index += 2;
-                    this->skipMultiLineComment();
-                } else {
-                    break;
-                }
-            } else if (start && ch == 0x2D) { // U+002D is '-'
-                // U+003E is '>'
-                if ((this->source.bufferedCharAt(this->index + 1) == 0x2D) && (this->source.bufferedCharAt(this->index + 2) == 0x3E)) {
-                    // '-->' is a single-line comment
-                    this->index += 3;
-                    this->skipSingleLineComment();
-                } else {
-                    break;
-                }
-            } else if (ch == 0x3C) { // U+003C is '<'
-                if (this->length > this->index + 4) {
-                    if (this->source.bufferedCharAt(this->index + 1) == '!'
-                        && this->source.bufferedCharAt(this->index + 2) == '-'
-                        && this->source.bufferedCharAt(this->index + 3) == '-') {
-                        this->index += 4; // `<!--`
-                        this->skipSingleLineComment();
-                    } else {
-                        break;
-                    }
-                } else {
-                    break;
-                }
-
-            } else {
-                break;
-            }
+        if (UNLIKELY(this->preScannedTokens != nullptr) && this->skipPreScannedComments()) {
+            return;
+        }
+        if (UNLIKELY(!skipWhiteSpacesAndComments(this->source, this->length, this->index, this->lineNumber, this->lineStart))) {
+            this->throwUnexpectedToken();
         }
     }
 
@@ -502,6 +629,9 @@ public:
     void lex(Scanner::ScannerResult* token);
 
 private:
+    bool skipPreScannedComments();
+    bool lexPreScannedToken(Scanner::ScannerResult* token);
+
     ALWAYS_INLINE char16_t peekChar()
     {
         return this->source.bufferedCharAt(this->index);
@@ -33,7 +33,7 @@
 
 namespace Escargot {
 
-Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, bool isOnGlobal)
+void Script::generateByteCodeBlock(Context* context, bool isEvalMode, bool isOnGlobal)
 {
     RefPtr<Node> programNode = m_topCodeBlock->cachedASTNode();
     if (m_topCodeBlock->m_cachedASTNode) {
@@ -43,7 +43,27 @@ Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, b
     ASSERT(programNode && programNode->type() == ASTNodeType::Program);
 
     ByteCodeGenerator g;
-    m_topCodeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), m_topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), isEvalMode, isOnGlobal);
+    m_topCodeBlock->m_byteCodeBlock = g.generateByteCode(context, m_topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), isEvalMode, isOnGlobal);
+}
+
+void Script::prepareByteCodeBlock(Context* context)
+{
+    if (m_hasPreparedByteCodeBlock) {
+        return;
+    }
+    generateByteCodeBlock(context, false, false);
+    m_hasPreparedByteCodeBlock = true;
+}
+
+Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, bool isOnGlobal)
+{
+    if (LIKELY(!m_hasPreparedByteCodeBlock)) {
+        generateByteCodeBlock(state.context(), isEvalMode, isOnGlobal);
+    } else {
+        // bytecode of global code does not depend on isOnGlobal, only the flag does
+        ASSERT(!isEvalMode);
+        m_topCodeBlock->byteCodeBlock()->m_isOnGlobal = isOnGlobal;
+    }
 
     LexicalEnvironment* env;
     ExecutionContext* prevEc;
@@ -154,6 +174,10 @@ Value Script::executeLocal(ExecutionState& state, Value thisValue, InterpretedCo
     for (size_t i = 0; i < len; i++) {
         recordToAddVariable->createBinding(state, vec[i].m_name, inStrict ? false : true, true);
     }
+    if (len && !inStrict && !recordToAddVariable->isGlobalEnvironmentRecord()) {
+        // existing record gains bindings. drop it from name lookup cache
+        recordToAddVariable->setHasDynamicBindings();
+    }
     LexicalEnvironment* newEnvironment = new LexicalEnvironment(record, state.executionContext()->lexicalEnvironment());
 
     ExecutionContext ec(state.context(), state.executionContext(), newEnvironment, m_topCodeBlock->isStrict());
@@ -30,10 +30,12 @@ class Context;
 class Script : public gc {
     friend class ScriptParser;
     friend class GlobalObject;
+    friend class CodeCache;
     Script(String* fileName, String* src)
         : m_fileName(fileName)
         , m_src(src)
         , m_topCodeBlock(nullptr)
+        , m_hasPreparedByteCodeBlock(false)
     {
     }
 
@@ -69,11 +71,20 @@ public:
         return m_topCodeBlock;
     }
 
+    // generate bytecode of top code block before execution (execute will reuse it)
+    void prepareByteCodeBlock(Context* context);
+    bool hasPreparedByteCodeBlock()
+    {
+        return m_hasPreparedByteCodeBlock;
+    }
+
 private:
+    void generateByteCodeBlock(Context* context, bool isEvalMode, bool isOnGlobal);
     Value executeLocal(ExecutionState& state, Value thisValue, InterpretedCodeBlock* parentCodeBlock, bool isEvalMode = false, bool needNewEnv = false);
     String* m_fileName;
     String* m_src;
     InterpretedCodeBlock* m_topCodeBlock;
+    bool m_hasPreparedByteCodeBlock;
 };
 }
 
@@ -26,6 +26,11 @@
 #include "parser/ScriptParser.h"
 #include "parser/ast/AST.h"
 #include "parser/CodeBlock.h"
+#include "parser/CodeCache.h"
+#include "parser/Lexer.h"
+
+#include <atomic>
+#include <thread>
 
 namespace Escargot {
 
@@ -153,7 +158,7 @@ void ScriptParser::generateCodeBlockTreeFromASTWalkerPostProcess(InterpretedCode
     }
 }
 
-ScriptParser::ScriptParserResult ScriptParser::parse(StringView scriptSource, String* fileName, InterpretedCodeBlock* parentCodeBlock, bool strictFromOutside, bool isEvalCodeInFunction, size_t stackSizeRemain)
+ScriptParser::ScriptParserResult ScriptParser::parse(StringView scriptSource, String* fileName, InterpretedCodeBlock* parentCodeBlock, bool strictFromOutside, bool isEvalCodeInFunction, size_t stackSizeRemain, const EscargotLexer::PreScannedTokens* preScannedTokens)
 {
     Script* script = nullptr;
     ScriptParseError* error = nullptr;
@@ -162,7 +167,7 @@ ScriptParser::ScriptParserResult ScriptParser::parse(StringView scriptSource, St
 
     try {
         m_context->vmInstance()->m_parsedSourceCodes.push_back(scriptSource.string());
-        RefPtr<ProgramNode> program = esprima::parseProgram(m_context, scriptSource, strictFromOutside, stackSizeRemain);
+        RefPtr<ProgramNode> program = esprima::parseProgram(m_context, scriptSource, strictFromOutside, stackSizeRemain, preScannedTokens);
 
         script = new Script(fileName, new StringView(scriptSource));
         InterpretedCodeBlock* topCodeBlock;
@@ -252,6 +257,120 @@ ScriptParser::ScriptParserResult ScriptParser::parse(StringView scriptSource, St
     return result;
 }
 
+// cache file of a source which is read and validated off the VM thread.
+// if there is no valid cache, tokens of the source are pre-scanned instead
+struct PreparedCodeCache {
+    StringBufferAccessData source;
+    const char* cacheFilePath;
+    CodeCacheData data;
+    EscargotLexer::PreScannedTokens tokens;
+    bool isValid;
+
+    void prepare(bool shouldPreScan)
+    {
+        isValid = cacheFilePath && CodeCache::readFile(cacheFilePath, data) && CodeCache::isValid(source, data.data(), data.size());
+        if (!isValid && shouldPreScan) {
+            tokens.scan(source);
+        }
+    }
+};
+
+// sources are referred by caches, so the vector should be visible to GC
+typedef std::vector<PreparedCodeCache, GCUtil::gc_malloc_allocator<PreparedCodeCache>> PreparedCodeCacheVector;
+
+static void prepareCodeCaches(PreparedCodeCacheVector& caches, size_t workerCount)
+{
+    workerCount = std::min(workerCount, caches.size());
+    if (workerCount <= 1) {
+        // pre-scanning on this thread only adds work
+        for (size_t i = 0; i < caches.size(); i++) {
+            caches[i].prepare(false);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&]() {
+        size_t i;
+        while ((i = nextIndex++) < caches.size()) {
+            caches[i].prepare(true);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workerCount; i++) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+ScriptParser::ScriptParserResult ScriptParser::parseWithPreparedCodeCache(String* scriptSource, String* fileName, PreparedCodeCache& cache)
+{
+    if (cache.isValid) {
+        GC_disable();
+        Script* script = CodeCache::loadValidData(m_context, scriptSource, fileName, cache.data.data(), cache.data.size());
+        if (script) {
+            m_context->vmInstance()->m_parsedSourceCodes.push_back(scriptSource);
+        }
+        GC_enable();
+
+        if (script) {
+            return ScriptParserResult(script, nullptr);
+        }
+    }
+
+    const EscargotLexer::PreScannedTokens* tokens = cache.tokens.size() ? &cache.tokens : nullptr;
+    ScriptParserResult result = parse(StringView(scriptSource, 0, scriptSource->length()), fileName, nullptr, false, false, SIZE_MAX, tokens);
+    if (result.m_script && cache.cacheFilePath) {
+        result.m_script->prepareByteCodeBlock(m_context);
+        if (CodeCache::store(m_context, result.m_script, cache.data)) {
+            CodeCache::writeFile(cache.cacheFilePath, cache.data);
+        }
+    }
+    return result;
+}
+
+ScriptParser::ScriptParserResult ScriptParser::parseWithCodeCache(String* scriptSource, String* fileName, const char* cacheFilePath)
+{
+    PreparedCodeCache cache;
+    cache.source = scriptSource->bufferAccessData();
+    cache.cacheFilePath = cacheFilePath;
+    cache.prepare(false);
+    return parseWithPreparedCodeCache(scriptSource, fileName, cache);
+}
+
+ScriptParser::ScriptParserResultVector ScriptParser::parseWithCodeCache(const CodeCacheSourceVector& sources, size_t workerCount, CodeCacheStatistics* statistics)
+{
+    PreparedCodeCacheVector caches(sources.size());
+    for (size_t i = 0; i < sources.size(); i++) {
+        // rope strings are flattened here, so workers only read buffers of sources
+        caches[i].source = sources[i].script->bufferAccessData();
+        caches[i].cacheFilePath = sources[i].cacheFilePath;
+    }
+    prepareCodeCaches(caches, workerCount);
+
+    if (statistics) {
+        statistics->m_preScannedTokenCount = statistics->m_replayedTokenCount = statistics->m_missedTokenCount = 0;
+    }
+
+    ScriptParserResultVector results;
+    results.reserve(sources.size());
+    for (size_t i = 0; i < sources.size(); i++) {
+        results.push_back(parseWithPreparedCodeCache(sources[i].script, sources[i].fileName, caches[i]));
+        if (statistics) {
+            statistics->m_preScannedTokenCount += caches[i].tokens.size();
+            statistics->m_replayedTokenCount += caches[i].tokens.replayedCount();
+            statistics->m_missedTokenCount += caches[i].tokens.missedCount();
+        }
+        // release cache data and tokens as soon as possible
+        CodeCacheData().swap(caches[i].data);
+        caches[i].tokens = EscargotLexer::PreScannedTokens();
+    }
+    return results;
+}
+
 std::tuple<RefPtr<Node>, ASTScopeContext*> ScriptParser::parseFunction(InterpretedCodeBlock* codeBlock, size_t stackSizeRemain, ExecutionState* state)
 {
     try {
@@ -32,6 +32,10 @@ class InterpretedCodeBlock;
 class Context;
 class ProgramNode;
 class Node;
+struct PreparedCodeCache;
+namespace EscargotLexer {
+class PreScannedTokens;
+}
 typedef Vector<void*, GCUtil::gc_malloc_ignore_off_page_allocator<void*>, 150> LiteralValueRooterVector;
 
 class ScriptParser : public gc {
@@ -62,10 +66,32 @@ public:
     {
         return parse(StringView(script, 0, script->length()), fileName, nullptr, strictFromOutside, isEvalCodeInFunction, stackSizeRemain);
     }
-    ScriptParserResult parse(StringView script, String* fileName = String::emptyString, InterpretedCodeBlock* parentCodeBlock = nullptr, bool strictFromOutside = false, bool isEvalCodeInFunction = false, size_t stackSizeRemain = SIZE_MAX);
+    // preScannedTokens should be scanned from script, and can be nullptr
+    ScriptParserResult parse(StringView script, String* fileName = String::emptyString, InterpretedCodeBlock* parentCodeBlock = nullptr, bool strictFromOutside = false, bool isEvalCodeInFunction = false, size_t stackSizeRemain = SIZE_MAX, const EscargotLexer::PreScannedTokens* preScannedTokens = nullptr);
+    // load global code from cache file if it is valid for this source, otherwise parse and write the cache file
+    ScriptParserResult parseWithCodeCache(String* script, String* fileName, const char* cacheFilePath);
+
+    struct CodeCacheSource {
+        String* script;
+        String* fileName;
+        const char* cacheFilePath; // can be nullptr
+    };
+    typedef std::vector<CodeCacheSource, GCUtil::gc_malloc_allocator<CodeCacheSource>> CodeCacheSourceVector;
+    typedef std::vector<ScriptParserResult, GCUtil::gc_malloc_allocator<ScriptParserResult>> ScriptParserResultVector;
+    // reading and validating cache files, and pre-scanning tokens of sources without valid caches are done on worker threads,
+    // which touch neither GC heap nor AtomicStringMap.
+    // after that, scripts are loaded from valid caches or parsed with pre-scanned tokens on this thread in order of sources
+    struct CodeCacheStatistics {
+        size_t m_preScannedTokenCount;
+        size_t m_replayedTokenCount;
+        size_t m_missedTokenCount;
+    };
+    // statistics can be nullptr
+    ScriptParserResultVector parseWithCodeCache(const CodeCacheSourceVector& sources, size_t workerCount, CodeCacheStatistics* statistics = nullptr);
     std::tuple<RefPtr<Node>, ASTScopeContext*> parseFunction(InterpretedCodeBlock* codeBlock, size_t stackSizeRemain, ExecutionState* state = nullptr);
 
 private:
+    ScriptParserResult parseWithPreparedCodeCache(String* script, String* fileName, PreparedCodeCache& cache);
     InterpretedCodeBlock* generateCodeBlockTreeFromAST(Context* ctx, StringView source, Script* script, ProgramNode* program);
     InterpretedCodeBlock* generateCodeBlockTreeFromASTWalker(Context* ctx, StringView source, Script* script, ASTScopeContext* scopeCtx, InterpretedCodeBlock* parentCodeBlock);
     void generateCodeBlockTreeFromASTWalkerPostProcess(InterpretedCodeBlock* cb);
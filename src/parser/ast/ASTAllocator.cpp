@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ASTAllocator.h"
+
+namespace Escargot {
+
+thread_local ASTAllocator* ASTAllocator::s_current;
+
+// tracked blocks start with the allocator which owns them. the header keeps 8-byte alignment of blocks
+static const size_t trackedBlockHeaderSize = 8;
+COMPILE_ASSERT(sizeof(ASTAllocator*) <= trackedBlockHeaderSize, "");
+
+ASTAllocator::ASTAllocator()
+    : m_top(nullptr)
+    , m_end(nullptr)
+    , m_refCount(0)
+{
+}
+
+ASTAllocator::~ASTAllocator()
+{
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+        GC_FREE(m_chunks[i]);
+    }
+}
+
+void* ASTAllocator::allocate(size_t size)
+{
+    size = (size + 7) & ~(size_t)7;
+    if (UNLIKELY(size > ESCARGOT_AST_ALLOCATOR_CHUNK_SIZE / 4)) {
+        void* block = GC_MALLOC_UNCOLLECTABLE(size);
+        m_chunks.push_back(block);
+        return block;
+    }
+
+    if (UNLIKELY((size_t)(m_end - m_top) < size)) {
+        m_top = (char*)GC_MALLOC_UNCOLLECTABLE(ESCARGOT_AST_ALLOCATOR_CHUNK_SIZE);
+        m_end = m_top + ESCARGOT_AST_ALLOCATOR_CHUNK_SIZE;
+        m_chunks.push_back(m_top);
+    }
+    void* result = m_top;
+    m_top += size;
+    return result;
+}
+
+void* ASTAllocator::allocateTracked(size_t size)
+{
+    ASTAllocator* allocator = s_current;
+    char* block;
+    if (LIKELY(allocator != nullptr)) {
+        block = (char*)allocator->allocate(size + trackedBlockHeaderSize);
+        allocator->ref();
+    } else {
+        block = (char*)GC_MALLOC_UNCOLLECTABLE(size + trackedBlockHeaderSize);
+    }
+    *(ASTAllocator**)block = allocator;
+    return block + trackedBlockHeaderSize;
+}
+
+void ASTAllocator::freeTracked(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    char* block = (char*)ptr - trackedBlockHeaderSize;
+    ASTAllocator* allocator = *(ASTAllocator**)block;
+    if (LIKELY(allocator != nullptr)) {
+        allocator->deref();
+    } else {
+        GC_FREE(block);
+    }
+}
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotASTAllocator__
+#define __EscargotASTAllocator__
+
+namespace Escargot {
+
+#ifndef ESCARGOT_AST_ALLOCATOR_CHUNK_SIZE
+#define ESCARGOT_AST_ALLOCATOR_CHUNK_SIZE (64 * 1024)
+#endif
+
+// Bump allocator for the AST of one parse. esprima installs it with ASTAllocatorScope.
+// Every AST node and node vector in it holds a reference of the allocator,
+// so its chunks are released at once when the last node is destroyed after bytecode generation.
+// Chunks are uncollectable like AST nodes were, so GC pointers in them are roots
+class ASTAllocator {
+public:
+    static ASTAllocator* current()
+    {
+        return s_current;
+    }
+
+    // allocates from current allocator if there is, or allocates an uncollectable block
+    static void* allocateTracked(size_t size);
+    static void freeTracked(void* ptr);
+
+    // memory which is not freed until the allocator is released, like strings of tokens
+    void* allocate(size_t size);
+
+private:
+    friend class ASTAllocatorScope;
+
+    ASTAllocator();
+    ~ASTAllocator();
+
+    void ref()
+    {
+        m_refCount++;
+    }
+
+    void deref()
+    {
+        ASSERT(m_refCount);
+        if (--m_refCount == 0) {
+            delete this;
+        }
+    }
+
+    static thread_local ASTAllocator* s_current;
+
+    char* m_top;
+    char* m_end;
+    size_t m_refCount;
+    std::vector<void*> m_chunks;
+};
+
+class ASTAllocatorScope {
+public:
+    ASTAllocatorScope()
+        : m_allocator(new ASTAllocator())
+        , m_previous(ASTAllocator::s_current)
+    {
+        m_allocator->ref();
+        ASTAllocator::s_current = m_allocator;
+    }
+
+    ~ASTAllocatorScope()
+    {
+        ASSERT(ASTAllocator::s_current == m_allocator);
+        ASTAllocator::s_current = m_previous;
+        m_allocator->deref();
+    }
+
+private:
+    ASTAllocator* m_allocator;
+    ASTAllocator* m_previous;
+};
+
+// allocator for vectors of AST nodes
+template <typename T>
+class ast_allocator {
+public:
+    typedef T value_type;
+
+    ast_allocator() {}
+    template <typename U>
+    ast_allocator(const ast_allocator<U>&)
+    {
+    }
+
+    template <typename U>
+    struct rebind {
+        typedef ast_allocator<U> other;
+    };
+
+    T* allocate(size_t n)
+    {
+        return (T*)ASTAllocator::allocateTracked(n * sizeof(T));
+    }
+
+    void deallocate(T* ptr, size_t)
+    {
+        ASTAllocator::freeTracked(ptr);
+    }
+};
+
+template <typename T, typename U>
+inline bool operator==(const ast_allocator<T>&, const ast_allocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const ast_allocator<T>&, const ast_allocator<U>&)
+{
+    return false;
+}
+}
+
+#endif
@@ -69,7 +69,7 @@ private:
     std::vector<FunctionDeclarationNode *> m_innerFDs;
 };
 
-typedef std::vector<RefPtr<Node>> CatchClauseNodeVector;
+typedef std::vector<RefPtr<Node>, ast_allocator<RefPtr<Node>>> CatchClauseNodeVector;
 }
 
 #endif
@@ -26,7 +26,7 @@
 
 namespace Escargot {
 
-typedef std::vector<RefPtr<ClassElementNode>> ClassElementNodeVector;
+typedef std::vector<RefPtr<ClassElementNode>, ast_allocator<RefPtr<ClassElementNode>>> ClassElementNodeVector;
 
 class ClassBodyNode : public Node {
 public:
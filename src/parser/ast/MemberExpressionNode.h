@@ -84,9 +84,7 @@ public:
 
         if (isPreComputedCase()) {
             ASSERT(m_property->isIdentifier());
-            size_t pos = codeBlock->currentCodeSize();
             codeBlock->pushCode(GetObjectPreComputedCase(ByteCodeLOC(m_loc.index), objectIndex, dstIndex, m_property->asIdentifier()->name()), context, this);
-            context->m_getObjectCodePositions.push_back(pos);
         } else {
             size_t propertyIndex = m_property->getRegister(codeBlock, context);
             m_property->generateExpressionByteCode(codeBlock, context, propertyIndex);
@@ -153,9 +151,7 @@ public:
         if (isPreComputedCase()) {
             size_t objectIndex = context->getLastRegisterIndex();
             size_t resultIndex = context->getRegister();
-            size_t pos = codeBlock->currentCodeSize();
             codeBlock->pushCode(GetObjectPreComputedCase(ByteCodeLOC(m_loc.index), objectIndex, resultIndex, m_property->asIdentifier()->name()), context, this);
-            context->m_getObjectCodePositions.push_back(pos);
         } else {
             size_t objectIndex = context->getLastRegisterIndex(1);
             size_t propertyIndex = context->getLastRegisterIndex();
@@ -22,6 +22,7 @@
 
 #include "runtime/AtomicString.h"
 #include "runtime/Value.h"
+#include "parser/ast/ASTAllocator.h"
 
 namespace Escargot {
 
@@ -248,12 +249,12 @@ public:
 
     inline void *operator new(size_t size)
     {
-        return GC_MALLOC_UNCOLLECTABLE(size);
+        return ASTAllocator::allocateTracked(size);
     }
 
     inline void operator delete(void *obj)
     {
-        GC_FREE(obj);
+        ASTAllocator::freeTracked(obj);
     }
 
     bool isAssignmentOperation()
@@ -585,14 +586,14 @@ struct ASTScopeContext : public gc {
     }
 };
 
-typedef std::vector<RefPtr<Node>> NodeVector;
-typedef std::vector<RefPtr<Node>> ArgumentVector;
-typedef std::vector<RefPtr<Node>> ExpressionNodeVector;
-typedef std::vector<RefPtr<Node>> PatternNodeVector;
+typedef std::vector<RefPtr<Node>, ast_allocator<RefPtr<Node>>> NodeVector;
+typedef std::vector<RefPtr<Node>, ast_allocator<RefPtr<Node>>> ArgumentVector;
+typedef std::vector<RefPtr<Node>, ast_allocator<RefPtr<Node>>> ExpressionNodeVector;
+typedef std::vector<RefPtr<Node>, ast_allocator<RefPtr<Node>>> PatternNodeVector;
 class PropertyNode;
-typedef std::vector<RefPtr<PropertyNode>> PropertiesNodeVector;
+typedef std::vector<RefPtr<PropertyNode>, ast_allocator<RefPtr<PropertyNode>>> PropertiesNodeVector;
 class VariableDeclaratorNode;
-typedef std::vector<RefPtr<VariableDeclaratorNode>> VariableDeclaratorVector;
+typedef std::vector<RefPtr<VariableDeclaratorNode>, ast_allocator<RefPtr<VariableDeclaratorNode>>> VariableDeclaratorVector;
 }
 
 #endif
@@ -54,6 +54,16 @@ public:
         return adoptRef(new StatementContainer());
     }
 
+    inline void* operator new(size_t size)
+    {
+        return ASTAllocator::allocateTracked(size);
+    }
+
+    inline void operator delete(void* obj)
+    {
+        ASTAllocator::freeTracked(obj);
+    }
+
     ~StatementContainer()
     {
         RefPtr<StatementNode> c = m_firstChild.release();
@@ -21,6 +21,7 @@
 #define SwitchStatementNode_h
 
 #include "ExpressionNode.h"
+#include "LiteralNode.h"
 #include "StatementNode.h"
 #include "SwitchCaseNode.h"
 
@@ -55,33 +56,41 @@ public:
         newContext.m_canSkipCopyToRegister = canSkipCopyToRegister;
 
         std::vector<size_t> jumpCodePerCaseNodePosition;
-        StatementNode* nd = m_casesB->firstChild();
-        while (nd) {
-            SwitchCaseNode* caseNode = (SwitchCaseNode*)nd;
-            size_t refIndex = caseNode->m_test->getRegister(codeBlock, &newContext);
-            caseNode->m_test->generateExpressionByteCode(codeBlock, &newContext, refIndex);
-            size_t resultIndex = newContext.getRegister();
-            codeBlock->pushCode(BinaryStrictEqual(ByteCodeLOC(m_loc.index), refIndex, rIndex0, resultIndex), &newContext, this);
-            jumpCodePerCaseNodePosition.push_back(codeBlock->currentCodeSize());
-            codeBlock->pushCode(JumpIfTrue(ByteCodeLOC(m_loc.index), resultIndex), &newContext, this);
-            newContext.giveUpRegister();
-            newContext.giveUpRegister();
-            nd = nd->nextSilbing();
-        }
+        std::vector<LiteralNode*> caseTests;
+        SwitchJumpTableData* table = createJumpTable(caseTests);
+        StatementNode* nd;
+        if (table) {
+            codeBlock->m_literalData.pushBack(table);
+            codeBlock->pushCode(SwitchJumpTable(ByteCodeLOC(m_loc.index), rIndex0, table), &newContext, this);
+        } else {
+            nd = m_casesB->firstChild();
+            while (nd) {
+                SwitchCaseNode* caseNode = (SwitchCaseNode*)nd;
+                size_t refIndex = caseNode->m_test->getRegister(codeBlock, &newContext);
+                caseNode->m_test->generateExpressionByteCode(codeBlock, &newContext, refIndex);
+                size_t resultIndex = newContext.getRegister();
+                codeBlock->pushCode(BinaryStrictEqual(ByteCodeLOC(m_loc.index), refIndex, rIndex0, resultIndex), &newContext, this);
+                jumpCodePerCaseNodePosition.push_back(codeBlock->currentCodeSize());
+                codeBlock->pushCode(JumpIfTrue(ByteCodeLOC(m_loc.index), resultIndex), &newContext, this);
+                newContext.giveUpRegister();
+                newContext.giveUpRegister();
+                nd = nd->nextSilbing();
+            }
 
-        ASSERT(rIndex0 == newContext.getLastRegisterIndex());
-        nd = m_casesA->firstChild();
-        while (nd) {
-            SwitchCaseNode* caseNode = (SwitchCaseNode*)nd;
-            size_t refIndex = caseNode->m_test->getRegister(codeBlock, &newContext);
-            caseNode->m_test->generateExpressionByteCode(codeBlock, &newContext, refIndex);
-            size_t resultIndex = newContext.getRegister();
-            codeBlock->pushCode(BinaryStrictEqual(ByteCodeLOC(m_loc.index), refIndex, rIndex0, resultIndex), &newContext, this);
-            jumpCodePerCaseNodePosition.push_back(codeBlock->currentCodeSize());
-            codeBlock->pushCode(JumpIfTrue(ByteCodeLOC(m_loc.index), resultIndex), &newContext, this);
-            newContext.giveUpRegister();
-            newContext.giveUpRegister();
-            nd = nd->nextSilbing();
+            ASSERT(rIndex0 == newContext.getLastRegisterIndex());
+            nd = m_casesA->firstChild();
+            while (nd) {
+                SwitchCaseNode* caseNode = (SwitchCaseNode*)nd;
+                size_t refIndex = caseNode->m_test->getRegister(codeBlock, &newContext);
+                caseNode->m_test->generateExpressionByteCode(codeBlock, &newContext, refIndex);
+                size_t resultIndex = newContext.getRegister();
+                codeBlock->pushCode(BinaryStrictEqual(ByteCodeLOC(m_loc.index), refIndex, rIndex0, resultIndex), &newContext, this);
+                jumpCodePerCaseNodePosition.push_back(codeBlock->currentCodeSize());
+                codeBlock->pushCode(JumpIfTrue(ByteCodeLOC(m_loc.index), resultIndex), &newContext, this);
+                newContext.giveUpRegister();
+                newContext.giveUpRegister();
+                nd = nd->nextSilbing();
+            }
         }
 
         newContext.giveUpRegister();
@@ -94,7 +103,7 @@ public:
         nd = m_casesB->firstChild();
         while (nd) {
             SwitchCaseNode* caseNode = (SwitchCaseNode*)nd;
-            codeBlock->peekCode<JumpIfTrue>(jumpCodePerCaseNodePosition[caseIdx++])->m_jumpPosition = codeBlock->currentCodeSize();
+            bindCasePosition(codeBlock, table, jumpCodePerCaseNodePosition, caseIdx++);
             caseNode->generateStatementByteCode(codeBlock, &newContext);
             nd = nd->nextSilbing();
         }
@@ -105,10 +114,20 @@ public:
         nd = m_casesA->firstChild();
         while (nd) {
             SwitchCaseNode* caseNode = (SwitchCaseNode*)nd;
-            codeBlock->peekCode<JumpIfTrue>(jumpCodePerCaseNodePosition[caseIdx++])->m_jumpPosition = codeBlock->currentCodeSize();
+            bindCasePosition(codeBlock, table, jumpCodePerCaseNodePosition, caseIdx++);
             caseNode->generateStatementByteCode(codeBlock, &newContext);
             nd = nd->nextSilbing();
         }
+        if (table) {
+            for (size_t i = 0; i < caseTests.size(); i++) {
+                if (table->m_isStringTable) {
+                    table->addString(caseTests[i]->value().asString(), jumpCodePerCaseNodePosition[i]);
+                } else {
+                    table->addInt32(caseTests[i]->value().asInt32(), jumpCodePerCaseNodePosition[i]);
+                }
+            }
+        }
+
         size_t breakPos = codeBlock->currentCodeSize();
         newContext.consumeBreakPositions(codeBlock, breakPos, context->m_tryStatementScopeCount);
         newContext.m_positionToContinue = context->m_positionToContinue;
@@ -121,6 +140,71 @@ public:
 
     virtual ASTNodeType type() { return ASTNodeType::SwitchStatement; }
 private:
+    // returns empty table when every case test is int32 literal in dense range or string literal
+    // caseTests gets the tests in the order of comparison
+    SwitchJumpTableData* createJumpTable(std::vector<LiteralNode*>& caseTests)
+    {
+        StatementContainer* containers[2] = { m_casesB.get(), m_casesA.get() };
+        for (size_t i = 0; i < 2; i++) {
+            StatementNode* nd = containers[i]->firstChild();
+            while (nd) {
+                Node* test = ((SwitchCaseNode*)nd)->m_test.get();
+                if (test->type() != ASTNodeType::Literal) {
+                    return nullptr;
+                }
+                caseTests.push_back((LiteralNode*)test);
+                nd = nd->nextSilbing();
+            }
+        }
+
+        if (caseTests.size() < SWITCH_JUMP_TABLE_MIN_CASE_COUNT) {
+            return nullptr;
+        }
+
+        if (caseTests[0]->value().isString()) {
+            for (size_t i = 0; i < caseTests.size(); i++) {
+                if (!caseTests[i]->value().isString()) {
+                    return nullptr;
+                }
+            }
+            size_t capacity = 1;
+            while (capacity < caseTests.size() * 2) {
+                capacity <<= 1;
+            }
+            SwitchJumpTableData* table = new SwitchJumpTableData(true, 0);
+            table->m_keys.resize(capacity, nullptr);
+            table->m_positions.resize(capacity, SIZE_MAX);
+            return table;
+        }
+
+        int64_t minimum = std::numeric_limits<int32_t>::max();
+        int64_t maximum = std::numeric_limits<int32_t>::min();
+        for (size_t i = 0; i < caseTests.size(); i++) {
+            const Value& v = caseTests[i]->value();
+            if (!v.isInt32()) {
+                return nullptr;
+            }
+            minimum = std::min(minimum, (int64_t)v.asInt32());
+            maximum = std::max(maximum, (int64_t)v.asInt32());
+        }
+        if ((uint64_t)(maximum - minimum + 1) > (uint64_t)caseTests.size() * SWITCH_JUMP_TABLE_MAX_INT32_HOLE_RATE) {
+            return nullptr;
+        }
+        SwitchJumpTableData* table = new SwitchJumpTableData(false, (int32_t)minimum);
+        table->m_positions.resize(maximum - minimum + 1, SIZE_MAX);
+        return table;
+    }
+
+    void bindCasePosition(ByteCodeBlock* codeBlock, SwitchJumpTableData* table, std::vector<size_t>& jumpCodePerCaseNodePosition, size_t caseIdx)
+    {
+        if (table) {
+            ASSERT(jumpCodePerCaseNodePosition.size() == caseIdx);
+            jumpCodePerCaseNodePosition.push_back(codeBlock->currentCodeSize());
+        } else {
+            codeBlock->peekCode<JumpIfTrue>(jumpCodePerCaseNodePosition[caseIdx])->m_jumpPosition = codeBlock->currentCodeSize();
+        }
+    }
+
     RefPtr<ExpressionNode> m_discriminant;
     RefPtr<StatementContainer> m_casesA;
     RefPtr<StatementNode> m_default;
@@ -6183,9 +6183,12 @@ public:
     */
 };
 
-RefPtr<ProgramNode> parseProgram(::Escargot::Context* ctx, StringView source, bool strictFromOutside, size_t stackRemain)
+RefPtr<ProgramNode> parseProgram(::Escargot::Context* ctx, StringView source, bool strictFromOutside, size_t stackRemain, const EscargotLexer::PreScannedTokens* preScannedTokens)
 {
+    // the allocator outlives parser, and is released with the last node of result
+    ASTAllocatorScope allocatorScope;
     Parser parser(ctx, source, stackRemain);
+    parser.scannerInstance.preScannedTokens = preScannedTokens;
     parser.context->strict = strictFromOutside;
     RefPtr<ProgramNode> nd = parser.parseProgram();
     return nd;
@@ -6193,6 +6196,7 @@ RefPtr<ProgramNode> parseProgram(::Escargot::Context* ctx, StringView source, bo
 
 std::tuple<RefPtr<Node>, ASTScopeContext*> parseSingleFunction(::Escargot::Context* ctx, InterpretedCodeBlock* codeBlock, size_t stackRemain)
 {
+    ASTAllocatorScope allocatorScope;
     Parser parser(ctx, codeBlock->src(), stackRemain, codeBlock->sourceElementStart());
     parser.trackUsingNames = false;
     parser.config.parseSingleFunction = true;
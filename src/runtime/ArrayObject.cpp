@@ -36,7 +36,7 @@ ArrayObject::ArrayObject(ExecutionState& state, bool hasSpreadElement)
     Object::setPrototype(state, state.context()->globalObject()->arrayPrototype());
 
     if (UNLIKELY(state.context()->vmInstance()->didSomePrototypeObjectDefineIndexedProperty() || hasSpreadElement)) {
-        ensureObjectRareData()->m_isFastModeArrayObject = false;
+        convertIntoSparseMode(state);
     }
 }
 
@@ -60,9 +60,20 @@ ObjectGetResult ArrayObject::getOwnProperty(ExecutionState& state, const ObjectP
     ObjectGetResult v = getFastModeValue(state, P);
     if (LIKELY(v.hasValue())) {
         return v;
-    } else {
-        return Object::getOwnProperty(state, P);
     }
+
+    ArraySparseElementMap* sparse = sparseElements();
+    if (UNLIKELY(sparse != nullptr)) {
+        uint64_t idx = P.tryToUseAsArrayIndex();
+        if (idx != Value::InvalidArrayIndexValue) {
+            auto iter = sparse->find(idx);
+            if (iter != sparse->end()) {
+                return ObjectGetResult(iter->second, true, true, true);
+            }
+            return ObjectGetResult();
+        }
+    }
+    return Object::getOwnProperty(state, P);
 }
 
 bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE
@@ -71,6 +82,10 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
         return true;
     }
 
+    if (UNLIKELY(sparseElements() != nullptr) && setSparseModeValue(state, P, desc)) {
+        return true;
+    }
+
     uint64_t idx = P.tryToUseAsArrayIndex();
     auto oldLenDesc = structure()->readProperty(state, (size_t)0);
     uint32_t oldLen = getArrayLength(state);
@@ -86,6 +101,10 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
         }
         return true;
     } else if (P.toPropertyName(state).equals(state.context()->staticStrings().length.string())) {
+        if (UNLIKELY(sparseElements() != nullptr) && desc.isWritablePresent() && !desc.isWritable()) {
+            convertIntoNonFastMode(state);
+        }
+
         // See 3.a ~ 3.n on http://www.ecma-international.org/ecma-262/5.1/#sec-15.4.5.1
         if (desc.isValuePresent()) {
             ObjectPropertyDescriptor newLenDesc(desc);
@@ -128,6 +147,12 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
                 return false;
             }
 
+            if (sparseElements()) {
+                // every sparse element is configurable, so setArrayLength has removed all of them already
+                ASSERT(newWritable);
+                return true;
+            }
+
             while (newLen < oldLen) {
                 oldLen--;
 
@@ -171,11 +196,19 @@ bool ArrayObject::deleteOwnProperty(ExecutionState& state, const ObjectPropertyN
         if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
             uint64_t len = getArrayLength(state);
             if (idx < len) {
-                m_fastModeData[idx] = Value(Value::EmptyValue);
+                setFastModeElement(state, idx, Value(Value::EmptyValue));
                 ensureObjectRareData()->m_shouldUpdateEnumerateObjectData = true;
                 return true;
             }
         }
+    } else if (ArraySparseElementMap* sparse = sparseElements()) {
+        uint64_t idx = P.tryToUseAsArrayIndex();
+        if (idx != Value::InvalidArrayIndexValue) {
+            if (sparse->erase(idx)) {
+                rareData()->m_shouldUpdateEnumerateObjectData = true;
+            }
+            return true;
+        }
     }
     return Object::deleteOwnProperty(state, P);
 }
@@ -186,12 +219,26 @@ void ArrayObject::enumeration(ExecutionState& state, bool (*callback)(ExecutionS
         size_t len = getArrayLength(state);
         for (size_t i = 0; i < len; i++) {
             ASSERT(isFastModeArray());
-            if (m_fastModeData[i].isEmpty())
+            if (getFastModeElement(i).isEmpty())
                 continue;
             if (!callback(state, this, ObjectPropertyName(state, Value(i)), ObjectStructurePropertyDescriptor::createDataDescriptor(ObjectStructurePropertyDescriptor::AllPresent), data)) {
                 return;
             }
         }
+    } else if (ArraySparseElementMap* sparse = sparseElements()) {
+        // callback can modify elements, so find next index from the map on each step
+        auto iter = sparse->begin();
+        while (iter != sparse->end()) {
+            uint32_t index = iter->first;
+            if (!callback(state, this, ObjectPropertyName(state, Value(index)), ObjectStructurePropertyDescriptor::createDataDescriptor(ObjectStructurePropertyDescriptor::AllPresent), data)) {
+                return;
+            }
+            sparse = sparseElements();
+            if (!sparse) {
+                break;
+            }
+            iter = sparse->upper_bound(index);
+        }
     }
     Object::enumeration(state, callback, data, shouldSkipSymbolKey);
 }
@@ -204,7 +251,7 @@ void ArrayObject::sort(ExecutionState& state, const std::function<bool(const Val
             Value* tempBuffer = (Value*)GC_MALLOC_IGNORE_OFF_PAGE(sizeof(Value) * orgLength);
 
             for (size_t i = 0; i < orgLength; i++) {
-                tempBuffer[i] = m_fastModeData[i];
+                tempBuffer[i] = getFastModeElement(i);
             }
 
             if (orgLength) {
@@ -223,12 +270,42 @@ void ArrayObject::sort(ExecutionState& state, const std::function<bool(const Val
 
             if (isFastModeArray()) {
                 for (size_t i = 0; i < orgLength; i++) {
-                    m_fastModeData[i] = tempBuffer[i];
+                    setFastModeElement(state, i, tempBuffer[i]);
                 }
             }
             GC_FREE(tempBuffer);
         }
         return;
+    } else if (ArraySparseElementMap* sparse = sparseElements()) {
+        std::vector<uint32_t> indexes;
+        std::vector<Value, GCUtil::gc_malloc_ignore_off_page_allocator<Value>> selected;
+        indexes.reserve(sparse->size());
+        selected.reserve(sparse->size());
+        for (auto iter = sparse->begin(); iter != sparse->end(); iter++) {
+            indexes.push_back(iter->first);
+            selected.push_back(iter->second);
+        }
+
+        if (selected.size()) {
+            TightVector<Value, GCUtil::gc_malloc_ignore_off_page_allocator<Value>> tempSpace;
+            tempSpace.resizeWithUninitializedValues(selected.size());
+
+            mergeSort(selected.data(), selected.size(), tempSpace.data(), [&](const Value& a, const Value& b, bool* lessOrEqualp) -> bool {
+                *lessOrEqualp = comp(a, b);
+                return true;
+            });
+        }
+
+        size_t n = selected.size();
+        for (size_t i = 0; i < n; i++) {
+            setThrowsException(state, ObjectPropertyName(state, Value(i)), selected[i], this);
+        }
+        for (size_t i = 0; i < indexes.size(); i++) {
+            if (indexes[i] >= n) {
+                deleteOwnProperty(state, ObjectPropertyName(state, Value(indexes[i])));
+            }
+        }
+        return;
     }
     Object::sort(state, comp);
 }
@@ -245,7 +322,8 @@ void ArrayObject::iterateArrays(ExecutionState& state, HeapObjectIteratorCallbac
 
 void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
 {
-    if (!isFastModeArray())
+    ArraySparseElementMap* sparse = sparseElements();
+    if (!isFastModeArray() && !sparse)
         return;
 
     if (!structure()->isStructureWithFastAccess()) {
@@ -254,14 +332,68 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
 
     ensureObjectRareData()->m_isFastModeArrayObject = false;
 
+    if (sparse) {
+        rareData()->m_arraySparseElements = nullptr;
+        for (auto iter = sparse->begin(); iter != sparse->end(); iter++) {
+            defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, Value(iter->first)), ObjectPropertyDescriptor(iter->second, ObjectPropertyDescriptor::AllPresent));
+        }
+        return;
+    }
+
     auto length = getArrayLength(state);
     for (size_t i = 0; i < length; i++) {
-        if (!m_fastModeData[i].isEmpty()) {
-            defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(m_fastModeData[i], ObjectPropertyDescriptor::AllPresent));
+        Value v = getFastModeElement(i);
+        if (!v.isEmpty()) {
+            defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(v, ObjectPropertyDescriptor::AllPresent));
         }
     }
 
     m_fastModeData.clear();
+    m_fastModeDoubleData.clear();
+}
+
+void ArrayObject::convertIntoSparseMode(ExecutionState& state)
+{
+    if (!isFastModeArray())
+        return;
+
+    ArraySparseElementMap* sparse = new (GC) ArraySparseElementMap();
+    auto length = getArrayLength(state);
+    for (size_t i = 0; i < length; i++) {
+        Value v = getFastModeElement(i);
+        if (!v.isEmpty()) {
+            sparse->insert(sparse->end(), std::make_pair((uint32_t)i, SmallValue(v)));
+        }
+    }
+
+    ObjectRareData* data = ensureObjectRareData();
+    data->m_isFastModeArrayObject = false;
+    data->m_arraySparseElements = sparse;
+    m_fastModeData.clear();
+    m_fastModeDoubleData.clear();
+}
+
+void ArrayObject::convertFastModeDoubleDataIntoValues(ExecutionState& state)
+{
+    ASSERT(hasFastModeDoubleData());
+    size_t length = getArrayLength(state);
+    m_fastModeData.resize(0, length, Value(Value::EmptyValue));
+    for (size_t i = 0; i < length; i++) {
+        double d = m_fastModeDoubleData[i];
+        if (!isFastModeDoubleHole(d)) {
+            m_fastModeData[i] = Value(d);
+        }
+    }
+    m_fastModeDoubleData.clear();
+}
+
+void ArrayObject::resizeFastModeData(size_t oldSize, size_t newSize)
+{
+    if (hasFastModeDoubleData() || (!m_fastModeData.data() && !oldSize)) {
+        m_fastModeDoubleData.resize(oldSize, newSize, bitwise_cast<double>((uint64_t)ESCARGOT_ARRAY_DOUBLE_HOLE_BITS));
+    } else {
+        m_fastModeData.resize(oldSize, newSize, Value(Value::EmptyValue));
+    }
 }
 
 bool ArrayObject::setArrayLength(ExecutionState& state, const uint64_t newLength)
@@ -269,7 +401,7 @@ bool ArrayObject::setArrayLength(ExecutionState& state, const uint64_t newLength
     if (UNLIKELY(isFastModeArray() && (newLength > ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE))) {
         uint32_t orgLength = getArrayLength(state);
         if (newLength > orgLength && (newLength - orgLength > ESCARGOT_ARRAY_NON_FASTMODE_START_MIN_GAP)) {
-            convertIntoNonFastMode(state);
+            convertIntoSparseMode(state);
         }
     }
 
@@ -277,12 +409,18 @@ bool ArrayObject::setArrayLength(ExecutionState& state, const uint64_t newLength
         auto oldSize = getArrayLength(state);
         auto oldLenDesc = structure()->readProperty(state, (size_t)0);
         m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER] = Value(newLength);
-        m_fastModeData.resize(oldSize, newLength, Value(Value::EmptyValue));
+        resizeFastModeData(oldSize, newLength);
 
         if (UNLIKELY(!oldLenDesc.m_descriptor.isWritable())) {
             convertIntoNonFastMode(state);
         }
         return true;
+    } else if (ArraySparseElementMap* sparse = sparseElements()) {
+        if (newLength < getArrayLength(state)) {
+            sparse->erase(sparse->lower_bound(newLength), sparse->end());
+        }
+        m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER] = Value(newLength);
+        return true;
     } else {
         if (!isInArrayObjectDefineOwnProperty()) {
             auto oldLenDesc = structure()->readProperty(state, (size_t)0);
@@ -323,7 +461,7 @@ ObjectGetResult ArrayObject::getFastModeValue(ExecutionState& state, const Objec
     if (LIKELY(isFastModeArray())) {
         uint64_t idx = P.tryToUseAsArrayIndex();
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < getArrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = getFastModeElement(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
@@ -333,13 +471,40 @@ ObjectGetResult ArrayObject::getFastModeValue(ExecutionState& state, const Objec
     return ObjectGetResult();
 }
 
+bool ArrayObject::setSparseModeValue(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc)
+{
+    ArraySparseElementMap* sparse = sparseElements();
+    ASSERT(sparse);
+    uint64_t idx = P.tryToUseAsArrayIndex();
+    if (idx == Value::InvalidArrayIndexValue) {
+        return false;
+    }
+
+    auto iter = sparse->find(idx);
+    if (iter != sparse->end()) {
+        if (desc.isValuePresent() && (desc.isValuePresentAlone() || desc.isDataWritableEnumerableConfigurable())) {
+            iter->second = desc.value();
+            return true;
+        }
+    } else if (desc.isDataWritableEnumerableConfigurable() && isExtensible(state)) {
+        if (idx >= getArrayLength(state)) {
+            setArrayLength(state, idx + 1);
+        }
+        sparse->insert(std::make_pair((uint32_t)idx, SmallValue(desc.value())));
+        return true;
+    }
+
+    convertIntoNonFastMode(state);
+    return false;
+}
+
 bool ArrayObject::setFastModeValue(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc)
 {
     if (LIKELY(isFastModeArray())) {
         uint64_t idx = P.tryToUseAsArrayIndex();
         if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
             uint32_t len = getArrayLength(state);
-            if (len > idx && !m_fastModeData[idx].isEmpty()) {
+            if (len > idx && !getFastModeElement(idx).isEmpty()) {
                 // Non-empty slot of fast-mode array always has {writable:true, enumerable:true, configurable:true}.
                 // So, when new desciptor is not present, keep {w:true, e:true, c:true}
                 if (UNLIKELY(!(desc.isValuePresentAlone() || desc.isDataWritableEnumerableConfigurable()))) {
@@ -366,7 +531,7 @@ bool ArrayObject::setFastModeValue(ExecutionState& state, const ObjectPropertyNa
                     return false;
                 }
             }
-            m_fastModeData[idx] = desc.value();
+            setFastModeElement(state, idx, desc.value());
             return true;
         }
     }
@@ -378,12 +543,20 @@ ObjectGetResult ArrayObject::getIndexedProperty(ExecutionState& state, const Val
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = property.tryToUseAsArrayIndex(state);
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < getArrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = getFastModeElement(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
             return get(state, ObjectPropertyName(state, property));
         }
+    } else if (ArraySparseElementMap* sparse = sparseElements()) {
+        uint32_t idx = property.tryToUseAsArrayIndex(state);
+        if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
+            auto iter = sparse->find(idx);
+            if (iter != sparse->end()) {
+                return ObjectGetResult(iter->second, true, true, true);
+            }
+        }
     }
     return get(state, ObjectPropertyName(state, property));
 }
@@ -402,9 +575,19 @@ bool ArrayObject::setIndexedProperty(ExecutionState& state, const Value& propert
                     return set(state, ObjectPropertyName(state, property), value, this);
                 }
             }
-            m_fastModeData[idx] = value;
+            setFastModeElement(state, idx, value);
             return true;
         }
+    } else if (ArraySparseElementMap* sparse = sparseElements()) {
+        // existing sparse element is always writable data property of this object
+        uint32_t idx = property.tryToUseAsArrayIndex(state);
+        if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
+            auto iter = sparse->find(idx);
+            if (iter != sparse->end()) {
+                iter->second = value;
+                return true;
+            }
+        }
     }
     return set(state, ObjectPropertyName(state, property), value, this);
 }
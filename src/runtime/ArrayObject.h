@@ -28,9 +28,14 @@ namespace Escargot {
 
 #define ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE 65536 * 16
 #define ESCARGOT_ARRAY_NON_FASTMODE_START_MIN_GAP 1024
+// bit pattern of a hole in unboxed double elements.
+// this NaN payload never appears as an element value because every NaN is canonicalized before being stored
+#define ESCARGOT_ARRAY_DOUBLE_HOLE_BITS 0x7FFC00000000DEADULL
 
 extern size_t g_arrayObjectTag;
 
+typedef std::map<uint32_t, SmallValue, std::less<uint32_t>, gc_allocator<std::pair<const uint32_t, SmallValue>>> ArraySparseElementMap;
+
 class ArrayIteratorObject;
 
 class ArrayObject : public Object {
@@ -38,6 +43,10 @@ class ArrayObject : public Object {
     friend class Context;
     friend class Object;
     friend class ByteCodeInterpreter;
+    friend class JSONParser;
+    friend class ArrayBufferView;
+    template <typename Buffer>
+    friend class JSONStringifier;
     friend Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression);
     friend void initializeCustomAllocators();
     friend int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr);
@@ -109,10 +118,71 @@ private:
     bool defineArrayLengthProperty(ExecutionState& state, const ObjectPropertyDescriptor& desc);
     void convertIntoNonFastMode(ExecutionState& state);
 
+    // Sparse mode keeps elements in an index-ordered map instead of the ObjectStructure.
+    // Every sparse element is {writable, enumerable, configurable} data property.
+    // Other cases are converted into non-fast mode, where elements are ordinary properties.
+    void convertIntoSparseMode(ExecutionState& state);
+    ALWAYS_INLINE ArraySparseElementMap* sparseElements()
+    {
+        if (LIKELY(rareData() == nullptr)) {
+            return nullptr;
+        }
+        return (ArraySparseElementMap*)rareData()->m_arraySparseElements;
+    }
+    bool setSparseModeValue(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc);
+
+    // Elements of fast-mode array are stored unboxed in m_fastModeDoubleData while every element is a number or a hole.
+    // Storing any other value moves every element into m_fastModeData once.
+    // The kind is chosen again only when the array grows from an empty buffer.
+    ALWAYS_INLINE bool hasFastModeDoubleData()
+    {
+        return m_fastModeDoubleData.data();
+    }
+
+    ALWAYS_INLINE static bool isFastModeDoubleHole(double d)
+    {
+        return bitwise_cast<uint64_t>(d) == ESCARGOT_ARRAY_DOUBLE_HOLE_BITS;
+    }
+
+    ALWAYS_INLINE Value getFastModeElement(size_t idx)
+    {
+        if (hasFastModeDoubleData()) {
+            double d = m_fastModeDoubleData[idx];
+            if (UNLIKELY(isFastModeDoubleHole(d))) {
+                return Value(Value::EmptyValue);
+            }
+            return Value(d);
+        }
+        return m_fastModeData[idx];
+    }
+
+    ALWAYS_INLINE void setFastModeElement(ExecutionState& state, size_t idx, const Value& v)
+    {
+        if (hasFastModeDoubleData()) {
+            if (LIKELY(v.isNumber())) {
+                double d = v.asNumber();
+                if (UNLIKELY(std::isnan(d))) {
+                    d = std::numeric_limits<double>::quiet_NaN();
+                }
+                m_fastModeDoubleData[idx] = d;
+                return;
+            } else if (v.isEmpty()) {
+                m_fastModeDoubleData[idx] = bitwise_cast<double>((uint64_t)ESCARGOT_ARRAY_DOUBLE_HOLE_BITS);
+                return;
+            }
+            convertFastModeDoubleDataIntoValues(state);
+        }
+        m_fastModeData[idx] = v;
+    }
+
+    void convertFastModeDoubleDataIntoValues(ExecutionState& state);
+    void resizeFastModeData(size_t oldSize, size_t newSize);
+
     ObjectGetResult getFastModeValue(ExecutionState& state, const ObjectPropertyName& P);
     bool setFastModeValue(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc);
 
     VectorWithNoSize<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>> m_fastModeData;
+    VectorWithNoSize<double, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<double>> m_fastModeDoubleData;
 };
 
 class ArrayIteratorObject : public IteratorObject {
@@ -28,11 +28,12 @@
 #include "EnvironmentRecord.h"
 #include "parser/CodeBlock.h"
 #include "SandBox.h"
+#include "ContextSnapshot.h"
 #include "ArrayObject.h"
 
 namespace Escargot {
 
-Context::Context(VMInstance* instance)
+Context::Context(VMInstance* instance, ContextSnapshot* snapshot)
     : m_instance(instance)
     , m_atomicStringMap(&instance->m_atomicStringMap)
     , m_staticStrings(instance->m_staticStrings)
@@ -69,7 +70,11 @@ Context::Context(VMInstance* instance)
 
     ExecutionState stateForInit(this);
     m_globalObject = new GlobalObject(stateForInit);
-    m_globalObject->installBuiltins(stateForInit);
+    if (snapshot) {
+        snapshot->instantiate(stateForInit, m_globalObject);
+    } else {
+        m_globalObject->installBuiltins(stateForInit);
+    }
 
     auto temp = new ArrayObject(stateForInit);
     g_arrayObjectTag = *((size_t*)temp);
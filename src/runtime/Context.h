@@ -41,6 +41,7 @@ class SandBox;
 class JobQueue;
 class ByteCodeBlock;
 class ToStringRecursionPreventer;
+class ContextSnapshot;
 
 typedef Value (*VirtualIdentifierCallback)(ExecutionState& state, Value name);
 typedef Value (*SecurityPolicyCheckCallback)(ExecutionState& state, bool isEval);
@@ -53,7 +54,8 @@ class Context : public gc {
     friend class ContextRef;
 
 public:
-    explicit Context(VMInstance* instance);
+    // if snapshot is given, builtins are copied from it instead of being installed
+    explicit Context(VMInstance* instance, ContextSnapshot* snapshot = nullptr);
 
     VMInstance* vmInstance()
     {
@@ -75,7 +77,7 @@ public:
         return *m_scriptParser;
     }
 
-    RegExpCacheMap* regexpCache()
+    RegExpCache* regexpCache()
     {
         return m_regexpCache;
     }
@@ -223,7 +225,7 @@ private:
     ScriptParser* m_scriptParser;
     Vector<CodeBlock*, GCUtil::gc_malloc_ignore_off_page_allocator<CodeBlock*>>& m_compiledCodeBlocks;
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
-    RegExpCacheMap* m_regexpCache;
+    RegExpCache* m_regexpCache;
     ObjectStructure* m_defaultStructureForObject;
     ObjectStructure* m_defaultStructureForFunctionObject;
     ObjectStructure* m_defaultStructureForClassFunctionObject;
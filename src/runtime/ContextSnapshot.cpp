@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ContextSnapshot.h"
+#include "Context.h"
+#include "VMInstance.h"
+#include "GlobalObject.h"
+#include "ObjectStructure.h"
+#include "FunctionObject.h"
+#include "ArrayObject.h"
+#include "BooleanObject.h"
+#include "NumberObject.h"
+#include "StringObject.h"
+#include "DateObject.h"
+#include "ErrorObject.h"
+#include "RegExpObject.h"
+#include "GlobalRegExpFunctionObject.h"
+#include "MapObject.h"
+#include "SetObject.h"
+#include "WeakMapObject.h"
+#include "WeakSetObject.h"
+#include "PromiseObject.h"
+#include "ArrayBufferObject.h"
+#include "DataViewObject.h"
+#include "parser/CodeBlock.h"
+
+namespace Escargot {
+
+// GlobalObject fields which point objects of the builtin graph
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_COMMON(F)   \
+    F(m_object, FunctionObject)                  \
+    F(m_objectPrototype, Object)                 \
+    F(m_objectPrototypeToString, FunctionObject) \
+    F(m_objectCreate, FunctionObject)            \
+    F(m_function, FunctionObject)                \
+    F(m_functionPrototype, FunctionObject)       \
+    F(m_iteratorPrototype, Object)               \
+    F(m_error, FunctionObject)                   \
+    F(m_errorPrototype, Object)                  \
+    F(m_referenceError, FunctionObject)          \
+    F(m_referenceErrorPrototype, Object)         \
+    F(m_typeError, FunctionObject)               \
+    F(m_typeErrorPrototype, Object)              \
+    F(m_rangeError, FunctionObject)              \
+    F(m_rangeErrorPrototype, Object)             \
+    F(m_syntaxError, FunctionObject)             \
+    F(m_syntaxErrorPrototype, Object)            \
+    F(m_uriError, FunctionObject)                \
+    F(m_uriErrorPrototype, Object)               \
+    F(m_evalError, FunctionObject)               \
+    F(m_evalErrorPrototype, Object)              \
+    F(m_string, FunctionObject)                  \
+    F(m_stringPrototype, Object)                 \
+    F(m_stringIteratorPrototype, Object)         \
+    F(m_number, FunctionObject)                  \
+    F(m_numberPrototype, Object)                 \
+    F(m_symbol, FunctionObject)                  \
+    F(m_symbolPrototype, Object)                 \
+    F(m_array, FunctionObject)                   \
+    F(m_arrayPrototype, Object)                  \
+    F(m_arrayIteratorPrototype, Object)          \
+    F(m_boolean, FunctionObject)                 \
+    F(m_booleanPrototype, Object)                \
+    F(m_date, FunctionObject)                    \
+    F(m_datePrototype, Object)                   \
+    F(m_regexp, GlobalRegExpFunctionObject)      \
+    F(m_regexpPrototype, Object)                 \
+    F(m_math, Object)                            \
+    F(m_eval, FunctionObject)                    \
+    F(m_throwTypeError, FunctionObject)          \
+    F(m_stringProxyObject, StringObject)         \
+    F(m_numberProxyObject, NumberObject)         \
+    F(m_json, Object)                            \
+    F(m_jsonStringify, FunctionObject)           \
+    F(m_jsonParse, FunctionObject)               \
+    F(m_map, FunctionObject)                     \
+    F(m_mapPrototype, Object)                    \
+    F(m_mapIteratorPrototype, Object)            \
+    F(m_set, FunctionObject)                     \
+    F(m_setPrototype, Object)                    \
+    F(m_setIteratorPrototype, Object)            \
+    F(m_weakMap, FunctionObject)                 \
+    F(m_weakMapPrototype, Object)                \
+    F(m_weakSet, FunctionObject)                 \
+    F(m_weakSetPrototype, Object)
+
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_INTL(F) \
+    F(m_intl, Object)                        \
+    F(m_intlCollator, FunctionObject)        \
+    F(m_intlDateTimeFormat, FunctionObject)  \
+    F(m_intlNumberFormat, FunctionObject)
+#else
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_INTL(F)
+#endif
+
+#if ESCARGOT_ENABLE_PROMISE
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_PROMISE(F) \
+    F(m_promise, FunctionObject)                \
+    F(m_promisePrototype, Object)
+#else
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_PROMISE(F)
+#endif
+
+#if ESCARGOT_ENABLE_PROXY_REFLECT
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_PROXY_REFLECT(F) \
+    F(m_proxy, FunctionObject)                        \
+    F(m_reflect, Object)
+#else
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_PROXY_REFLECT(F)
+#endif
+
+#if ESCARGOT_ENABLE_TYPEDARRAY
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_TYPEDARRAY(F) \
+    F(m_arrayBuffer, FunctionObject)               \
+    F(m_arrayBufferPrototype, Object)              \
+    F(m_dataView, FunctionObject)                  \
+    F(m_dataViewPrototype, Object)                 \
+    F(m_typedArray, FunctionObject)                \
+    F(m_typedArrayPrototype, Object)               \
+    F(m_int8Array, FunctionObject)                 \
+    F(m_int8ArrayPrototype, Object)                \
+    F(m_uint8Array, FunctionObject)                \
+    F(m_uint8ArrayPrototype, Object)               \
+    F(m_uint8ClampedArray, FunctionObject)         \
+    F(m_uint8ClampedArrayPrototype, Object)        \
+    F(m_int16Array, FunctionObject)                \
+    F(m_int16ArrayPrototype, Object)               \
+    F(m_uint16Array, FunctionObject)               \
+    F(m_uint16ArrayPrototype, Object)              \
+    F(m_int32Array, FunctionObject)                \
+    F(m_int32ArrayPrototype, Object)               \
+    F(m_uint32Array, FunctionObject)               \
+    F(m_uint32ArrayPrototype, Object)              \
+    F(m_float32Array, FunctionObject)              \
+    F(m_float32ArrayPrototype, Object)             \
+    F(m_float64Array, FunctionObject)              \
+    F(m_float64ArrayPrototype, Object)
+#else
+#define FOR_EACH_GLOBAL_OBJECT_FIELD_TYPEDARRAY(F)
+#endif
+
+#define FOR_EACH_GLOBAL_OBJECT_FIELD(F)           \
+    FOR_EACH_GLOBAL_OBJECT_FIELD_COMMON(F)        \
+    FOR_EACH_GLOBAL_OBJECT_FIELD_INTL(F)          \
+    FOR_EACH_GLOBAL_OBJECT_FIELD_PROMISE(F)       \
+    FOR_EACH_GLOBAL_OBJECT_FIELD_PROXY_REFLECT(F) \
+    FOR_EACH_GLOBAL_OBJECT_FIELD_TYPEDARRAY(F)
+
+// builtin objects which are not plain objects or plain native functions.
+// they are created by their own constructor, then their properties and prototype are copied from the template
+#define FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_COMMON(F)                                                    \
+    F(m_arrayPrototype, new ArrayObject(state))                                                        \
+    F(m_arrayIteratorPrototype, new ArrayIteratorObject(state, nullptr, ArrayIteratorObject::TypeKey)) \
+    F(m_booleanPrototype, new BooleanObject(state, false))                                             \
+    F(m_numberPrototype, new NumberObject(state, 0))                                                   \
+    F(m_stringPrototype, new StringObject(state, String::emptyString))                                 \
+    F(m_stringIteratorPrototype, new StringIteratorObject(state, nullptr))                             \
+    F(m_datePrototype, new DateObject(state))                                                          \
+    F(m_errorPrototype, new ErrorObject(state, String::emptyString))                                   \
+    F(m_referenceErrorPrototype, new ReferenceErrorObject(state, String::emptyString))                 \
+    F(m_typeErrorPrototype, new TypeErrorObject(state, String::emptyString))                           \
+    F(m_rangeErrorPrototype, new RangeErrorObject(state, String::emptyString))                         \
+    F(m_syntaxErrorPrototype, new SyntaxErrorObject(state, String::emptyString))                       \
+    F(m_uriErrorPrototype, new URIErrorObject(state, String::emptyString))                             \
+    F(m_evalErrorPrototype, new EvalErrorObject(state, String::emptyString))                           \
+    F(m_regexpPrototype, new RegExpObject(state))                                                      \
+    F(m_mapPrototype, new MapObject(state))                                                            \
+    F(m_mapIteratorPrototype, new MapIteratorObject(state, nullptr, MapIteratorObject::TypeKey))       \
+    F(m_setPrototype, new SetObject(state))                                                            \
+    F(m_setIteratorPrototype, new SetIteratorObject(state, nullptr, SetIteratorObject::TypeKey))       \
+    F(m_weakMapPrototype, new WeakMapObject(state))                                                    \
+    F(m_weakSetPrototype, new WeakSetObject(state))
+
+#if ESCARGOT_ENABLE_PROMISE
+#define FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_PROMISE(F) \
+    F(m_promisePrototype, new PromiseObject(state))
+#else
+#define FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_PROMISE(F)
+#endif
+
+#if ESCARGOT_ENABLE_TYPEDARRAY
+#define FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_TYPEDARRAY(F)     \
+    F(m_arrayBufferPrototype, new ArrayBufferObject(state)) \
+    F(m_dataViewPrototype, new DataViewObject(state))
+#else
+#define FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_TYPEDARRAY(F)
+#endif
+
+#define FOR_EACH_SPECIAL_PROTOTYPE_OBJECT(F)     \
+    FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_COMMON(F)  \
+    FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_PROMISE(F) \
+    FOR_EACH_SPECIAL_PROTOTYPE_OBJECT_TYPEDARRAY(F)
+
+#define FOR_EACH_SPECIAL_OBJECT(F)                     \
+    FOR_EACH_SPECIAL_PROTOTYPE_OBJECT(F)               \
+    F(m_stringProxyObject, new StringObject(state))    \
+    F(m_numberProxyObject, new NumberObject(state))    \
+    F(m_regexp, new GlobalRegExpFunctionObject(state)) \
+    F(m_eval, target->createEvalFunctionObject(state))
+
+enum SnapshotObjectKind : size_t {
+    GlobalObjectKind,
+    ObjectPrototypeKind,
+    PlainObjectKind,
+    NativeFunctionObjectKind,
+#define DECLARE_SPECIAL_OBJECT_KIND(field, creation) SpecialObjectKind_##field,
+    FOR_EACH_SPECIAL_OBJECT(DECLARE_SPECIAL_OBJECT_KIND)
+#undef DECLARE_SPECIAL_OBJECT_KIND
+};
+
+Object* ContextSnapshot::rawPrototypeOf(Object* obj)
+{
+    return obj->rareData() ? obj->rareData()->m_prototype : obj->m_prototype;
+}
+
+ContextSnapshot* ContextSnapshot::create(VMInstance* instance)
+{
+    Context* context = new Context(instance);
+    // snapshot is owned by the embedder
+    ContextSnapshot* snapshot = new (NoGC) ContextSnapshot(instance, context);
+    if (!snapshot->collectObjects()) {
+        delete snapshot;
+        return nullptr;
+    }
+    return snapshot;
+}
+
+bool ContextSnapshot::collectObjects()
+{
+    GlobalObject* global = m_context->globalObject();
+
+    std::unordered_map<Object*, size_t> specialObjects;
+#define ADD_SPECIAL_OBJECT(field, creation) \
+    specialObjects.insert(std::make_pair((Object*)global->field, (size_t)SpecialObjectKind_##field));
+    FOR_EACH_SPECIAL_OBJECT(ADD_SPECIAL_OBJECT)
+#undef ADD_SPECIAL_OBJECT
+
+    std::unordered_set<PointerValue*> visited;
+    std::vector<Value> worklist;
+    auto visit = [&](const Value& v) {
+        if (v.isPointerValue()) {
+            worklist.push_back(v);
+        }
+    };
+
+    visit(global);
+#define VISIT_FIELD(field, type) \
+    if (global->field) {         \
+        visit(global->field);    \
+    }
+    FOR_EACH_GLOBAL_OBJECT_FIELD(VISIT_FIELD)
+#undef VISIT_FIELD
+    visit(global->m_throwerGetterSetterData);
+
+    while (worklist.size()) {
+        PointerValue* p = worklist.back().asPointerValue();
+        worklist.pop_back();
+        if (p->isString() || p->isSymbol() || !visited.insert(p).second) {
+            continue;
+        }
+        if (p->isJSGetterSetter()) {
+            JSGetterSetter* gs = p->asJSGetterSetter();
+            m_getterSetters.pushBack(gs);
+            if (gs->hasGetter()) {
+                visit(gs->getter());
+            }
+            if (gs->hasSetter()) {
+                visit(gs->setter());
+            }
+            continue;
+        }
+        if (!p->isObject()) {
+            return false;
+        }
+
+        Object* obj = p->asObject();
+        size_t kind;
+        auto iter = specialObjects.find(obj);
+        if (obj == global) {
+            kind = GlobalObjectKind;
+        } else if (obj == global->m_objectPrototype) {
+            kind = ObjectPrototypeKind;
+        } else if (iter != specialObjects.end()) {
+            kind = iter->second;
+        } else if (obj->hasTag(g_objectTag)) {
+            kind = PlainObjectKind;
+        } else if (obj->hasTag(g_functionObjectTag)) {
+            FunctionObject* fn = obj->asFunctionObject();
+            CodeBlock* cb = fn->codeBlock();
+            if (!cb->hasCallNativeFunctionCode() || cb->isBindedFunction() || fn->m_outerEnvironment) {
+                return false;
+            }
+            if (fn->m_homeObject) {
+                visit(fn->m_homeObject);
+            }
+            kind = NativeFunctionObjectKind;
+        } else {
+            return false;
+        }
+
+        if (obj->rareData()) {
+            // native data of builtins cannot be copied
+            if (obj->extraData()) {
+                return false;
+            }
+            if (obj->hasInternalSlot()) {
+                visit(obj->internalSlot());
+            }
+        }
+
+        Object* proto = rawPrototypeOf(obj);
+        if (proto) {
+            visit(proto);
+        }
+        size_t count = obj->m_structure->propertyCount();
+        for (size_t i = 0; i < count; i++) {
+            visit(Value(obj->m_values[i]));
+        }
+
+        m_objects.pushBack(obj);
+        m_objectKinds.pushBack(kind);
+    }
+
+    return true;
+}
+
+void ContextSnapshot::instantiate(ExecutionState& state, GlobalObject* target)
+{
+    ASSERT(state.context()->vmInstance() == m_instance);
+    Context* context = state.context();
+    GlobalObject* source = m_context->globalObject();
+
+    // new objects are only reachable from this map until they are linked
+    GC_disable();
+
+    std::unordered_map<PointerValue*, PointerValue*> map;
+    auto remap = [&](const Value& v) -> Value {
+        if (!v.isPointerValue()) {
+            return v;
+        }
+        auto iter = map.find(v.asPointerValue());
+        if (iter == map.end()) {
+            // strings and symbols are shared
+            return v;
+        }
+        return Value(iter->second);
+    };
+
+    // create objects which can be made without other builtins
+    for (size_t i = 0; i < m_objects.size(); i++) {
+        Object* obj = m_objects[i];
+        Object* newObject = nullptr;
+        switch (m_objectKinds[i]) {
+        case GlobalObjectKind:
+            newObject = target;
+            break;
+        case ObjectPrototypeKind:
+            newObject = target->m_objectPrototype;
+            break;
+        case PlainObjectKind:
+            newObject = new Object(state, 0, false);
+            break;
+        case NativeFunctionObjectKind: {
+            CodeBlock* cb = obj->asFunctionObject()->codeBlock();
+            CodeBlock* newCodeBlock = new CodeBlock(context, cb->functionName(), cb->parameterCount(), cb->isStrict(), cb->isConstructor(), cb->nativeFunctionData());
+            newObject = new FunctionObject(state, newCodeBlock, FunctionObject::__ForSnapshot__);
+            break;
+        }
+        default:
+            continue;
+        }
+        map.insert(std::make_pair(obj, newObject));
+    }
+
+    // constructors of special objects refer the prototypes in the target GlobalObject
+    // prototypes are fixed below, like installBuiltins does
+#define LINK_FIELD(field, type)                  \
+    {                                            \
+        auto iter = map.find(source->field);     \
+        if (iter != map.end()) {                 \
+            target->field = (type*)iter->second; \
+        }                                        \
+    }
+    FOR_EACH_GLOBAL_OBJECT_FIELD(LINK_FIELD)
+#define SET_PLACEHOLDER(field, creation)           \
+    if (source->field) {                           \
+        target->field = target->m_objectPrototype; \
+    }
+    FOR_EACH_SPECIAL_PROTOTYPE_OBJECT(SET_PLACEHOLDER)
+#undef SET_PLACEHOLDER
+
+#define CREATE_SPECIAL_OBJECT(field, creation)                                               \
+    if (source->field) {                                                                     \
+        map.insert(std::make_pair((PointerValue*)source->field, (PointerValue*)(creation))); \
+    }
+    FOR_EACH_SPECIAL_OBJECT(CREATE_SPECIAL_OBJECT)
+#undef CREATE_SPECIAL_OBJECT
+
+    for (size_t i = 0; i < m_getterSetters.size(); i++) {
+        JSGetterSetter* gs = m_getterSetters[i];
+        map.insert(std::make_pair(gs, new JSGetterSetter(gs->hasGetter() ? remap(gs->getter()) : Value(Value::EmptyValue),
+                                                         gs->hasSetter() ? remap(gs->setter()) : Value(Value::EmptyValue))));
+    }
+
+    // copy properties, prototype and flags
+    for (size_t i = 0; i < m_objects.size(); i++) {
+        Object* obj = m_objects[i];
+        Object* newObject = map.find(obj)->second->asObject();
+
+        ObjectStructure* structure = obj->m_structure;
+        if (structure->isStructureWithFastAccess()) {
+            // structures with fast access are modified in place when their owner is modified
+            ObjectStructureItemVector properties(structure->m_properties);
+            structure = new ObjectStructureWithFastAccess(state, std::move(properties), structure->hasIndexPropertyName());
+        }
+        newObject->m_structure = structure;
+
+        size_t count = structure->propertyCount();
+        newObject->m_values.resizeWithUninitializedValues(0, count);
+        for (size_t j = 0; j < count; j++) {
+            newObject->m_values[j] = remap(Value(obj->m_values[j]));
+        }
+
+        Object* proto = rawPrototypeOf(obj);
+        if (proto) {
+            proto = map.find(proto)->second->asObject();
+        }
+        if (ObjectRareData* rareData = obj->rareData()) {
+            ObjectRareData* newRareData = newObject->ensureObjectRareData();
+            newRareData->m_isExtensible = rareData->m_isExtensible;
+            newRareData->m_isEverSetAsPrototypeObject = rareData->m_isEverSetAsPrototypeObject;
+            newRareData->m_isFastModeArrayObject = rareData->m_isFastModeArrayObject;
+            newRareData->m_shouldUpdateEnumerateObjectData = rareData->m_shouldUpdateEnumerateObjectData;
+            newRareData->m_isInArrayObjectDefineOwnProperty = rareData->m_isInArrayObjectDefineOwnProperty;
+            newRareData->m_hasNonWritableLastIndexRegexpObject = rareData->m_hasNonWritableLastIndexRegexpObject;
+            newRareData->m_prototype = proto;
+            if (obj->hasInternalSlot()) {
+                newObject->setInternalSlot(remap(obj->internalSlot()).asObject());
+            }
+        } else if (newObject->rareData()) {
+            newObject->rareData()->m_prototype = proto;
+        } else {
+            newObject->m_prototype = proto;
+        }
+
+        if (m_objectKinds[i] == NativeFunctionObjectKind) {
+            FunctionObject* fn = obj->asFunctionObject();
+            FunctionObject* newFunction = newObject->asFunctionObject();
+            if (fn->m_homeObject) {
+                newFunction->m_homeObject = remap(fn->m_homeObject).asObject();
+            }
+            newFunction->m_constructorKind = fn->m_constructorKind;
+            newFunction->m_isBuiltin = fn->m_isBuiltin;
+        }
+    }
+
+    FOR_EACH_GLOBAL_OBJECT_FIELD(LINK_FIELD)
+#undef LINK_FIELD
+    // builtins not installed in the template are installed on the first access, as usual
+    target->m_lazyBuiltins = source->m_lazyBuiltins;
+    target->m_throwerGetterSetterData = map.find(source->m_throwerGetterSetterData)->second->asJSGetterSetter();
+
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    target->m_intlCollatorAvailableLocales = source->m_intlCollatorAvailableLocales;
+    target->m_intlDateTimeFormatAvailableLocales = source->m_intlDateTimeFormatAvailableLocales;
+    target->m_intlNumberFormatAvailableLocales = source->m_intlNumberFormatAvailableLocales;
+#endif
+
+    GC_enable();
+}
+}
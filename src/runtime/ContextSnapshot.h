@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotContextSnapshot__
+#define __EscargotContextSnapshot__
+
+namespace Escargot {
+
+class VMInstance;
+class Context;
+class Object;
+class GlobalObject;
+class JSGetterSetter;
+class ExecutionState;
+
+// ContextSnapshot keeps a pristine Context whose builtins are installed once,
+// and copies its builtin object graph into new Contexts instead of running installBuiltins again.
+// Property names, strings, symbols, native function data and structures without fast access
+// are shared with the template. Objects, function code blocks and fast access structures are copied.
+// Snapshot is valid only for Contexts of the VMInstance it is created from
+class ContextSnapshot : public gc {
+public:
+    // returns nullptr if some builtin object cannot be copied
+    // returned snapshot is not collected until it is deleted
+    static ContextSnapshot* create(VMInstance* instance);
+
+    VMInstance* vmInstance()
+    {
+        return m_instance;
+    }
+
+    // fills `target` (which should be created right now) with the copy of builtins
+    void instantiate(ExecutionState& state, GlobalObject* target);
+
+private:
+    ContextSnapshot(VMInstance* instance, Context* context)
+        : m_instance(instance)
+        , m_context(context)
+    {
+    }
+
+    bool collectObjects();
+    static Object* rawPrototypeOf(Object* obj);
+
+    VMInstance* m_instance;
+    Context* m_context;
+    // every object reachable from the global object of m_context, with its kind
+    Vector<Object*, GCUtil::gc_malloc_ignore_off_page_allocator<Object*>> m_objects;
+    Vector<size_t, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<size_t>> m_objectKinds;
+    Vector<JSGetterSetter*, GCUtil::gc_malloc_ignore_off_page_allocator<JSGetterSetter*>> m_getterSetters;
+};
+}
+
+#endif
@@ -50,6 +50,7 @@ typedef Vector<IdentifierRecord, GCUtil::gc_malloc_atomic_ignore_off_page_alloca
 class EnvironmentRecord : public gc {
 protected:
     EnvironmentRecord()
+        : m_hasDynamicBindings(false)
     {
     }
 
@@ -175,7 +176,21 @@ public:
         return reinterpret_cast<DeclarativeEnvironmentRecord*>(this);
     }
 
+    // bindings of record are not decided by its code block
+    // (e.g. object environment, bindings added by eval, virtual identifiers)
+    // LoadByName/StoreByName cache cannot skip or index into these records
+    bool hasDynamicBindings()
+    {
+        return m_hasDynamicBindings;
+    }
+
+    void setHasDynamicBindings()
+    {
+        m_hasDynamicBindings = true;
+    }
+
 protected:
+    bool m_hasDynamicBindings;
 };
 
 class ObjectEnvironmentRecord : public EnvironmentRecord {
@@ -184,6 +199,7 @@ public:
         : EnvironmentRecord()
         , m_bindingObject(O)
     {
+        m_hasDynamicBindings = true;
     }
     ~ObjectEnvironmentRecord() {}
     Object* bindingObject()
@@ -375,6 +391,10 @@ public:
 
     virtual void createBinding(ExecutionState& state, const AtomicString& name, bool canDelete = false, bool isMutable = true);
     virtual GetBindingValueResult getBindingValue(ExecutionState& state, const AtomicString& name);
+    virtual Value getBindingValue(ExecutionState& state, const size_t idx)
+    {
+        return m_heapStorage[idx];
+    }
     virtual void setMutableBinding(ExecutionState& state, const AtomicString& name, const Value& V);
     virtual void setMutableBindingByIndex(ExecutionState& state, const size_t idx, const AtomicString& name, const Value& v);
 
@@ -588,6 +608,11 @@ public:
         return GetBindingValueResult();
     }
 
+    virtual Value getBindingValue(ExecutionState& state, const size_t idx)
+    {
+        return m_heapStorage[idx];
+    }
+
     virtual BindingSlot hasBinding(ExecutionState& state, const AtomicString& name)
     {
         const auto& v = m_functionObject->codeBlock()->asInterpretedCodeBlock()->identifierInfos();
@@ -690,6 +715,10 @@ public:
 
     virtual void createBinding(ExecutionState& state, const AtomicString& name, bool canDelete = false, bool isMutable = true);
     virtual GetBindingValueResult getBindingValue(ExecutionState& state, const AtomicString& name);
+    virtual Value getBindingValue(ExecutionState& state, const size_t idx)
+    {
+        return m_heapStorage[idx];
+    }
     virtual void setMutableBinding(ExecutionState& state, const AtomicString& name, const Value& V);
     virtual void setMutableBindingByIndex(ExecutionState& state, const size_t idx, const AtomicString& name, const Value& v);
 
@@ -717,6 +746,7 @@ public:
     FunctionEnvironmentRecordNotIndexedWithVirtualID(FunctionObject* function, size_t argc, Value* argv)
         : FunctionEnvironmentRecordNotIndexed(function, argc, argv)
     {
+        m_hasDynamicBindings = true;
     }
 
     virtual GetBindingValueResult getBindingValue(ExecutionState& state, const AtomicString& name);
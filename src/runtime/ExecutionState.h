@@ -34,10 +34,17 @@ typedef Vector<ControlFlowRecord*, GCUtil::gc_malloc_ignore_off_page_allocator<C
 struct ExecutionStateRareData : public gc {
     Vector<ControlFlowRecord*, GCUtil::gc_malloc_ignore_off_page_allocator<ControlFlowRecord*>>* m_controlFlowRecord;
     ExecutionState* m_parent;
+    // number of interpret() frames on this state that hand an exception to their caller by returning it.
+    // they are try, catch bodies and a function body called from one of them.
+    // if it is not zero, the innermost interpret() frame of this state is one of them
+    size_t m_handlerFrameDepth;
+    bool m_hasPendingException;
     ExecutionStateRareData()
     {
         m_controlFlowRecord = nullptr;
         m_parent = nullptr;
+        m_handlerFrameDepth = 0;
+        m_hasPendingException = false;
     }
 };
 
@@ -111,6 +118,17 @@ public:
 
     ExecutionState* parent();
     ExecutionStateRareData* ensureRareData();
+    void setRareData(ExecutionStateRareData* rareData)
+    {
+        ASSERT(m_parent & 1);
+        rareData->m_parent = parent();
+        m_rareData = rareData;
+    }
+
+    bool hasRareData()
+    {
+        return !(m_parent & 1);
+    }
 
     ExecutionStateRareData* rareData()
     {
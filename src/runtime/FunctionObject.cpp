@@ -110,6 +110,16 @@ FunctionObject::FunctionObject(ExecutionState& state, CodeBlock* codeBlock, ForG
     initFunctionObject(state);
 }
 
+FunctionObject::FunctionObject(ExecutionState& state, CodeBlock* codeBlock, ForSnapshot)
+    : Object(state, 0, false)
+    , m_codeBlock(codeBlock)
+    , m_outerEnvironment(nullptr)
+    , m_homeObject(nullptr)
+    , m_constructorKind(ConstructorKind::Base)
+    , m_isBuiltin(false)
+{
+}
+
 FunctionObject::FunctionObject(ExecutionState& state, CodeBlock* codeBlock, ForBuiltin)
     : Object(state, codeBlock->isConstructor() ? (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 3) : (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 2), false)
     , m_codeBlock(codeBlock)
@@ -320,7 +330,7 @@ Object* FunctionObject::newInstance(ExecutionState& state, const size_t argc, Va
         return receiver;
 }
 
-Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSrc, const size_t argc, Value* argv, bool isNewExpression)
+Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSrc, const size_t argc, Value* argv, bool isNewExpression, bool returnsException)
 {
     volatile int sp;
     size_t currentStackBase = (size_t)&sp;
@@ -574,6 +584,12 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
     }
 
     ExecutionState newState(ctx, &state, ec, registerFile);
+    if (UNLIKELY(returnsException)) {
+        // caller is a try or catch body, so function body hands its exception to caller by returning it
+        ExecutionStateRareData* rareData = new (alloca(sizeof(ExecutionStateRareData))) ExecutionStateRareData();
+        rareData->m_handlerFrameDepth = 1;
+        newState.setRareData(rareData);
+    }
 
     if (UNLIKELY(m_codeBlock->usesArgumentsObject())) {
         generateArgumentsObject(newState, record, stackStorage);
@@ -584,6 +600,12 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
     if (UNLIKELY(blk->m_shouldClearStack))
         clearStack<512>();
 
+    if (UNLIKELY(returnsException && newState.rareData()->m_hasPendingException)) {
+        ASSERT(state.rareData()->m_handlerFrameDepth);
+        state.rareData()->m_hasPendingException = true;
+        return returnValue;
+    }
+
     if (UNLIKELY(isSuperCall)) {
         if (returnValue.isNull()) {
             ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, errorMessage_InvalidDerivedConstructorReturnValue);
@@ -34,10 +34,15 @@ class FunctionEnvironmentRecord;
 class FunctionObject : public Object {
     friend class GlobalObject;
     friend class Script;
+    friend class ContextSnapshot;
+    friend class ByteCodeInterpreter;
     void initFunctionObject(ExecutionState& state);
 
     enum ForGlobalBuiltin { __ForGlobalBuiltin__ };
     FunctionObject(ExecutionState& state, CodeBlock* codeBlock, ForGlobalBuiltin);
+    // ContextSnapshot fills properties and prototype after creation
+    enum ForSnapshot { __ForSnapshot__ };
+    FunctionObject(ExecutionState& state, CodeBlock* codeBlock, ForSnapshot);
 
 public:
     enum ThisMode {
@@ -217,7 +222,8 @@ private:
         return true;
     }
 
-    Value processCall(ExecutionState& state, const Value& receiver, const size_t argc, Value* argv, bool isNewExpression);
+    // if returnsException is true, an exception of function body is returned with m_hasPendingException of state
+    Value processCall(ExecutionState& state, const Value& receiver, const size_t argc, Value* argv, bool isNewExpression, bool returnsException = false);
     static Value callSlowCase(ExecutionState& state, const Value& callee, const Value& receiver, const size_t argc, Value* argv, bool isNewExpression);
     void generateArgumentsObject(ExecutionState& state, FunctionEnvironmentRecord* fnRecord, Value* stackStorage);
     void generateBytecodeBlock(ExecutionState& state);
@@ -176,6 +176,14 @@ static Value builtinEval(ExecutionState& state, Value thisValue, size_t argc, Va
     return fn->m_globalObject->eval(state, argv[0]);
 }
 
+FunctionObject* GlobalObject::createEvalFunctionObject(ExecutionState& state)
+{
+    return new EvalFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().eval, builtinEval, 1, nullptr, NativeFunctionInfo::Strict));
+}
+
+static ObjectPropertyNativeGetterSetterData lazyBuiltinNativeGetterSetterData(
+    true, false, true, &GlobalObject::lazyBuiltinNativeGetter, &GlobalObject::lazyBuiltinNativeSetter);
+
 ObjectGetResult GlobalObject::getOwnProperty(ExecutionState& state, const ObjectPropertyName& P) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE
 {
     ObjectGetResult r = Object::getOwnProperty(state, P);
@@ -195,6 +203,172 @@ ObjectGetResult GlobalObject::getOwnProperty(ExecutionState& state, const Object
     return r;
 }
 
+bool GlobalObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE
+{
+    if (UNLIKELY(m_lazyBuiltins && !P.isUIntType())) {
+        // placeholder should be replaced by the builtin before it is redefined
+        size_t idx = m_structure->findProperty(state, P.propertyName());
+        if (idx != SIZE_MAX) {
+            const ObjectStructureItem& item = m_structure->readProperty(state, idx);
+            if (item.m_descriptor.isNativeAccessorProperty() && item.m_descriptor.nativeGetterSetterData() == &lazyBuiltinNativeGetterSetterData) {
+                installLazyBuiltin(lazyBuiltinKindOf(state, P.propertyName()));
+            }
+        }
+    }
+    return Object::defineOwnProperty(state, P, desc);
+}
+
+static const struct {
+    AtomicString StaticStrings::*m_name;
+    GlobalObject::LazyBuiltin m_kind;
+} lazyBuiltinNames[] = {
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    { &StaticStrings::Intl, GlobalObject::LazyBuiltinIntl },
+#endif
+#if ESCARGOT_ENABLE_PROMISE
+    { &StaticStrings::Promise, GlobalObject::LazyBuiltinPromise },
+#endif
+#if ESCARGOT_ENABLE_PROXY_REFLECT
+    { &StaticStrings::Proxy, GlobalObject::LazyBuiltinProxy },
+    { &StaticStrings::Reflect, GlobalObject::LazyBuiltinReflect },
+#endif
+#if ESCARGOT_ENABLE_TYPEDARRAY
+    { &StaticStrings::DataView, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::ArrayBuffer, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Int8Array, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Int16Array, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Int32Array, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Uint8Array, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Uint16Array, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Uint32Array, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Uint8ClampedArray, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Float32Array, GlobalObject::LazyBuiltinTypedArray },
+    { &StaticStrings::Float64Array, GlobalObject::LazyBuiltinTypedArray },
+#endif
+    { &StaticStrings::WeakMap, GlobalObject::LazyBuiltinWeakMap },
+    { &StaticStrings::WeakSet, GlobalObject::LazyBuiltinWeakSet },
+};
+
+GlobalObject::LazyBuiltin GlobalObject::lazyBuiltinKindOf(ExecutionState& state, const PropertyName& name)
+{
+    const StaticStrings& strings = state.context()->staticStrings();
+    for (size_t i = 0; i < sizeof(lazyBuiltinNames) / sizeof(lazyBuiltinNames[0]); i++) {
+        if (PropertyName(strings.*lazyBuiltinNames[i].m_name) == name) {
+            return lazyBuiltinNames[i].m_kind;
+        }
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+Value GlobalObject::lazyBuiltinNativeGetter(ExecutionState& state, Object* self, const SmallValue& privateDataFromObjectPrivateArea)
+{
+    ASSERT(self->isGlobalObject());
+    // placeholder keeps its property name
+    PropertyName name(AtomicString(state, Value(privateDataFromObjectPrivateArea).asString()));
+    GlobalObject* global = self->asGlobalObject();
+    global->installLazyBuiltin(global->lazyBuiltinKindOf(state, name));
+    return global->Object::getOwnProperty(state, ObjectPropertyName(state, name)).value(state, global);
+}
+
+bool GlobalObject::lazyBuiltinNativeSetter(ExecutionState& state, Object* self, SmallValue& privateDataFromObjectPrivateArea, const Value& setterInputData)
+{
+    ASSERT(self->isGlobalObject());
+    PropertyName name(AtomicString(state, Value(privateDataFromObjectPrivateArea).asString()));
+    GlobalObject* global = self->asGlobalObject();
+    global->installLazyBuiltin(global->lazyBuiltinKindOf(state, name));
+    return global->Object::set(state, ObjectPropertyName(state, name), setterInputData, global);
+}
+
+void GlobalObject::defineLazyBuiltin(ExecutionState& state, LazyBuiltin kind)
+{
+    const StaticStrings& strings = state.context()->staticStrings();
+    for (size_t i = 0; i < sizeof(lazyBuiltinNames) / sizeof(lazyBuiltinNames[0]); i++) {
+        if (lazyBuiltinNames[i].m_kind == kind) {
+            const AtomicString& name = strings.*lazyBuiltinNames[i].m_name;
+            defineNativeDataAccessorProperty(state, ObjectPropertyName(name), &lazyBuiltinNativeGetterSetterData, Value(name.string()));
+        }
+    }
+    m_lazyBuiltins |= kind;
+}
+
+void GlobalObject::installLazyBuiltin(LazyBuiltin kind)
+{
+    ASSERT(m_lazyBuiltins & kind);
+    m_lazyBuiltins &= ~kind;
+
+    ExecutionState state(m_context);
+    const StaticStrings& strings = m_context->staticStrings();
+    // remove placeholders first, or they would keep their native getter and setter
+    // placeholders deleted by script are remembered, because installers define every builtin of the group
+    uint32_t deletedPlaceholders = 0;
+    COMPILE_ASSERT(sizeof(lazyBuiltinNames) / sizeof(lazyBuiltinNames[0]) <= 32, "");
+    for (size_t i = 0; i < sizeof(lazyBuiltinNames) / sizeof(lazyBuiltinNames[0]); i++) {
+        if (lazyBuiltinNames[i].m_kind == kind) {
+            size_t idx = m_structure->findProperty(state, strings.*lazyBuiltinNames[i].m_name);
+            if (idx != SIZE_MAX) {
+                Object::deleteOwnProperty(state, idx);
+            } else {
+                deletedPlaceholders |= 1 << i;
+            }
+        }
+    }
+
+    // builtins should be installed even if the global object is not extensible
+    bool isExtensible = rareData() ? rareData()->m_isExtensible : true;
+    if (!isExtensible) {
+        rareData()->m_isExtensible = true;
+    }
+
+    switch (kind) {
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    case LazyBuiltinIntl:
+        installIntl(state);
+        break;
+#endif
+#if ESCARGOT_ENABLE_PROMISE
+    case LazyBuiltinPromise:
+        installPromise(state);
+        break;
+#endif
+#if ESCARGOT_ENABLE_PROXY_REFLECT
+    case LazyBuiltinProxy:
+        installProxy(state);
+        break;
+    case LazyBuiltinReflect:
+        installReflect(state);
+        break;
+#endif
+#if ESCARGOT_ENABLE_TYPEDARRAY
+    case LazyBuiltinTypedArray:
+        installDataView(state);
+        installTypedArray(state);
+        break;
+#endif
+    case LazyBuiltinWeakMap:
+        installWeakMap(state);
+        break;
+    case LazyBuiltinWeakSet:
+        installWeakSet(state);
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+
+    for (size_t i = 0; deletedPlaceholders; i++) {
+        if (deletedPlaceholders & (1 << i)) {
+            deletedPlaceholders &= ~(1 << i);
+            size_t idx = m_structure->findProperty(state, strings.*lazyBuiltinNames[i].m_name);
+            if (idx != SIZE_MAX) {
+                Object::deleteOwnProperty(state, idx);
+            }
+        }
+    }
+
+    if (!isExtensible) {
+        rareData()->m_isExtensible = false;
+    }
+}
+
 Value GlobalObject::eval(ExecutionState& state, const Value& arg)
 {
     if (arg.isString()) {
@@ -996,8 +1170,7 @@ void GlobalObject::installOthers(ExecutionState& state)
     defineOwnProperty(state, strings->undefined, ObjectPropertyDescriptor(Value(), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ValuePresent)));
 
     // $18.2.1 eval (x)
-    m_eval = new EvalFunctionObject(state,
-                                    NativeFunctionInfo(strings->eval, builtinEval, 1, nullptr, NativeFunctionInfo::Strict));
+    m_eval = createEvalFunctionObject(state);
     defineOwnProperty(state, ObjectPropertyName(strings->eval),
                       ObjectPropertyDescriptor(m_eval, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // $18.2.2 isFinite(number)
@@ -47,10 +47,12 @@ public:
     friend class ByteCodeInterpreter;
     friend class GlobalEnvironmentRecord;
     friend class IdentifierNode;
+    friend class ContextSnapshot;
 
     explicit GlobalObject(ExecutionState& state)
         : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, false)
         , m_context(state.context())
+        , m_lazyBuiltins(0)
         , m_object(nullptr)
         , m_objectPrototypeToString(nullptr)
         , m_objectCreate(nullptr)
@@ -175,26 +177,51 @@ public:
         installRegExp(state);
         installJSON(state);
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
-        installIntl(state);
+        defineLazyBuiltin(state, LazyBuiltinIntl);
 #endif
 #if ESCARGOT_ENABLE_PROMISE
-        installPromise(state);
+        defineLazyBuiltin(state, LazyBuiltinPromise);
 #endif
 #if ESCARGOT_ENABLE_PROXY_REFLECT
-        installProxy(state);
-        installReflect(state);
+        defineLazyBuiltin(state, LazyBuiltinProxy);
+        defineLazyBuiltin(state, LazyBuiltinReflect);
 #endif
 #if ESCARGOT_ENABLE_TYPEDARRAY
-        installDataView(state);
-        installTypedArray(state);
+        defineLazyBuiltin(state, LazyBuiltinTypedArray);
 #endif
         installMap(state);
         installSet(state);
-        installWeakMap(state);
-        installWeakSet(state);
+        defineLazyBuiltin(state, LazyBuiltinWeakMap);
+        defineLazyBuiltin(state, LazyBuiltinWeakSet);
         installOthers(state);
     }
 
+    // Builtins below are rarely used, so they are installed on the first access.
+    // Until then their global properties are native data properties (placeholders),
+    // and C++ accessors of their objects install them too
+    enum LazyBuiltin {
+        LazyBuiltinIntl = 1 << 0,
+        LazyBuiltinPromise = 1 << 1,
+        LazyBuiltinProxy = 1 << 2,
+        LazyBuiltinReflect = 1 << 3,
+        LazyBuiltinTypedArray = 1 << 4,
+        LazyBuiltinWeakMap = 1 << 5,
+        LazyBuiltinWeakSet = 1 << 6,
+    };
+
+    void ensureLazyBuiltinInstalled(LazyBuiltin kind)
+    {
+        if (UNLIKELY(m_lazyBuiltins & kind)) {
+            installLazyBuiltin(kind);
+        }
+    }
+
+    void defineLazyBuiltin(ExecutionState& state, LazyBuiltin kind);
+    void installLazyBuiltin(LazyBuiltin kind);
+    LazyBuiltin lazyBuiltinKindOf(ExecutionState& state, const PropertyName& name);
+    static Value lazyBuiltinNativeGetter(ExecutionState& state, Object* self, const SmallValue& privateDataFromObjectPrivateArea);
+    static bool lazyBuiltinNativeSetter(ExecutionState& state, Object* self, SmallValue& privateDataFromObjectPrivateArea, const Value& setterInputData);
+
     void installFunction(ExecutionState& state);
     void installObject(ExecutionState& state);
     void installError(ExecutionState& state);
@@ -229,6 +256,7 @@ public:
     void installWeakMap(ExecutionState& state);
     void installWeakSet(ExecutionState& state);
     void installOthers(ExecutionState& state);
+    FunctionObject* createEvalFunctionObject(ExecutionState& state);
 
     Value eval(ExecutionState& state, const Value& arg);
     Value evalLocal(ExecutionState& state, const Value& arg, Value thisValue, InterpretedCodeBlock* parentCodeBlock);
@@ -412,14 +440,20 @@ public:
     {
         return m_jsonParse;
     }
+
+    // JSON.stringify(value) in UTF-8, without creating the result string if possible.
+    // it is empty if the result is undefined
+    UTF8StringDataNonGCStd jsonStringifyToUTF8(ExecutionState& state, const Value& value);
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
     Object* intl()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinIntl);
         return m_intl;
     }
 
     FunctionObject* intlCollator()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinIntl);
         return m_intlCollator;
     }
 
@@ -427,6 +461,7 @@ public:
 
     FunctionObject* intlDateTimeFormat()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinIntl);
         return m_intlDateTimeFormat;
     }
 
@@ -434,6 +469,7 @@ public:
 
     FunctionObject* intlNumberFormat()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinIntl);
         return m_intlNumberFormat;
     }
 
@@ -442,114 +478,141 @@ public:
 #if ESCARGOT_ENABLE_PROMISE
     FunctionObject* promise()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinPromise);
         return m_promise;
     }
     Object* promisePrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinPromise);
         return m_promisePrototype;
     }
 #endif
 #if ESCARGOT_ENABLE_PROXY_REFLECT
     FunctionObject* proxy()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinProxy);
         return m_proxy;
     }
 #endif
 #if ESCARGOT_ENABLE_TYPEDARRAY
     FunctionObject* arrayBuffer()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_arrayBuffer;
     }
     Object* arrayBufferPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_arrayBufferPrototype;
     }
     FunctionObject* dataView()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_dataView;
     }
     Object* dataViewPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_dataViewPrototype;
     }
     Object* typedArray()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_typedArray;
     }
     Object* typedArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_typedArrayPrototype;
     }
     Object* int8Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_int8Array;
     }
     Object* int8ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_int8ArrayPrototype;
     }
     Object* uint8Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint8Array;
     }
     Object* uint8ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint8ArrayPrototype;
     }
     Object* int16Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_int16Array;
     }
     Object* int16ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_int16ArrayPrototype;
     }
     Object* uint16Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint16Array;
     }
     Object* uint16ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint16ArrayPrototype;
     }
     Object* int32Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_int32Array;
     }
     Object* int32ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_int32ArrayPrototype;
     }
     Object* uint32Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint32Array;
     }
     Object* uint32ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint32ArrayPrototype;
     }
     Object* uint8ClampedArray()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint8ClampedArray;
     }
     Object* uint8ClampedArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_uint8ClampedArrayPrototype;
     }
     Object* float32Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_float32Array;
     }
     Object* float32ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_float32ArrayPrototype;
     }
     Object* float64Array()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_float64Array;
     }
     Object* float64ArrayPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinTypedArray);
         return m_float64ArrayPrototype;
     }
 #endif
@@ -586,21 +649,25 @@ public:
 
     FunctionObject* weakMap()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinWeakMap);
         return m_weakMap;
     }
 
     Object* weakMapPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinWeakMap);
         return m_weakMapPrototype;
     }
 
     FunctionObject* weakSet()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinWeakSet);
         return m_weakSet;
     }
 
     Object* weakSetPrototype()
     {
+        ensureLazyBuiltinInstalled(LazyBuiltinWeakSet);
         return m_weakSetPrototype;
     }
 
@@ -639,6 +706,7 @@ public:
     }
 
     virtual ObjectGetResult getOwnProperty(ExecutionState& state, const ObjectPropertyName& P) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE;
+    virtual bool defineOwnProperty(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE;
 
     void* operator new(size_t size)
     {
@@ -648,6 +716,8 @@ public:
 
 private:
     Context* m_context;
+    // LazyBuiltin bits which are not installed yet
+    size_t m_lazyBuiltins;
 
     FunctionObject* m_object;
     Object* m_objectPrototype;
@@ -63,7 +63,7 @@ Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t arg
         if (argc > 1 || !val.isInt32()) {
             if (array->isFastModeArray()) {
                 for (size_t idx = 0; idx < argc; idx++) {
-                    array->m_fastModeData[idx] = argv[idx];
+                    array->setFastModeElement(state, idx, argv[idx]);
                 }
             } else {
                 for (size_t idx = 0; idx < argc; idx++) {
@@ -25,145 +25,519 @@
 #include "ArrayObject.h"
 #include "TypedArrayObject.h"
 #include "BooleanObject.h"
-
-#define RAPIDJSON_PARSE_DEFAULT_FLAGS kParseFullPrecisionFlag
-#define RAPIDJSON_ERROR_CHARTYPE char
-#include <rapidjson/document.h>
-#include <rapidjson/filereadstream.h>
-#include <rapidjson/memorystream.h>
-#include <rapidjson/internal/dtoa.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
-#include <rapidjson/error/en.h>
+#include "ObjectStructure.h"
+#include "StringSearch.h"
+#include "double-conversion.h"
 
 namespace Escargot {
 
-template <typename Encoding>
-struct JSONStringStream {
-    typedef typename Encoding::Ch Ch;
+#ifndef JSON_PARSE_PROPERTY_NAME_CACHE_SIZE
+#define JSON_PARSE_PROPERTY_NAME_CACHE_SIZE 128
+#endif
+
+#ifndef JSON_PARSE_PROPERTY_NAME_CACHE_MAX_LENGTH
+#define JSON_PARSE_PROPERTY_NAME_CACHE_MAX_LENGTH 64
+#endif
+
+#ifndef JSON_PARSE_STRUCTURE_CACHE_DEPTH
+#define JSON_PARSE_STRUCTURE_CACHE_DEPTH 16
+#endif
 
-    JSONStringStream(const Ch* src, size_t length)
-        : src_(src)
-        , head_(src)
-        , tail_(src + length)
+static void checkJSONStackLimit(ExecutionState& state)
+{
+    volatile int sp;
+    size_t currentStackBase = (size_t)&sp;
+#ifdef STACK_GROWS_DOWN
+    if (UNLIKELY((state.stackBase() - currentStackBase) > STACK_LIMIT_FROM_BASE)) {
+#else
+    if (UNLIKELY((currentStackBase - state.stackBase()) > STACK_LIMIT_FROM_BASE)) {
+#endif
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, "Maximum call stack size exceeded");
+    }
+}
+
+// Creates values while reading JSON text, without building a document first.
+// 8-bit text is read without widening. Recently seen property names are kept in a small cache,
+// and an object reuses the structure of the previous object at the same depth if their keys are same
+class JSONParser {
+public:
+    JSONParser(ExecutionState& state, String* source)
+        : m_state(state)
+        , m_source(source)
+        , m_index(0)
     {
+        const auto& data = source->bufferAccessData();
+        m_has8BitContent = data.has8BitContent;
+        m_data = data.buffer;
+        m_length = data.length;
+        for (size_t i = 0; i < JSON_PARSE_STRUCTURE_CACHE_DEPTH; i++) {
+            m_structureCache[i] = nullptr;
+        }
     }
 
-    Ch Peek() const
+    Value parse()
     {
-        if (UNLIKELY(tail_ <= src_)) {
-            return 0;
+        if (m_has8BitContent) {
+            return parse<LChar>();
         }
-        return *src_;
+        return parse<char16_t>();
     }
-    Ch Take()
+
+private:
+    template <typename CharType>
+    Value parse()
     {
-        if (UNLIKELY(tail_ <= src_)) {
-            return 0;
+        if (isEnd<CharType>()) {
+            throwError("The document is empty.");
+        }
+        Value result = parseValue<CharType>(0);
+        if (!isEnd<CharType>()) {
+            throwError("The document root must not be followed by other values.");
         }
-        return *src_++;
+        return result;
     }
-    size_t Tell() const { return static_cast<size_t>(src_ - head_); }
-    Ch* PutBegin()
+
+    template <typename CharType>
+    ALWAYS_INLINE const CharType* characters()
     {
-        RAPIDJSON_ASSERT(false);
-        return 0;
+        return (const CharType*)m_data;
     }
-    void Put(Ch) { RAPIDJSON_ASSERT(false); }
-    void Flush() { RAPIDJSON_ASSERT(false); }
-    size_t PutEnd(Ch*)
+
+    // skips whitespace and returns true if there is nothing left
+    template <typename CharType>
+    ALWAYS_INLINE bool isEnd()
     {
-        RAPIDJSON_ASSERT(false);
-        return 0;
+        const CharType* chars = characters<CharType>();
+        while (m_index < m_length) {
+            CharType c = chars[m_index];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                return false;
+            }
+            m_index++;
+        }
+        return true;
     }
 
-    const Ch* src_; //!< Current read position.
-    const Ch* head_; //!< Original head of the string.
-    const Ch* tail_;
-};
+    void throwError(const char* message)
+    {
+        auto strings = &m_state.context()->staticStrings();
+        ErrorObject::throwBuiltinError(m_state, ErrorObject::SyntaxError, strings->JSON.string(), true, strings->parse.string(), message);
+    }
 
-template <typename CharType, typename JSONCharType>
-static Value parseJSONWorker(ExecutionState& state, rapidjson::GenericValue<JSONCharType>& value)
-{
-    volatile int sp;
-    size_t currentStackBase = (size_t)&sp;
-#ifdef STACK_GROWS_DOWN
-    if (UNLIKELY((state.stackBase() - currentStackBase) > STACK_LIMIT_FROM_BASE)) {
-#else
-    if (UNLIKELY((currentStackBase - state.stackBase()) > STACK_LIMIT_FROM_BASE)) {
-#endif
-        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, "Maximum call stack size exceeded");
+    template <typename CharType>
+    Value parseValue(size_t depth)
+    {
+        if (isEnd<CharType>()) {
+            throwError("Invalid value.");
+        }
+
+        switch (characters<CharType>()[m_index]) {
+        case '{':
+            return parseObject<CharType>(depth);
+        case '[':
+            return parseArray<CharType>(depth);
+        case '"':
+            return Value(parseString<CharType>());
+        case 't':
+            expectLiteral<CharType>("true", 4);
+            return Value(true);
+        case 'f':
+            expectLiteral<CharType>("false", 5);
+            return Value(false);
+        case 'n':
+            expectLiteral<CharType>("null", 4);
+            return Value(Value::Null);
+        default:
+            return parseNumber<CharType>();
+        }
     }
 
-    if (value.IsBool()) {
-        return Value(value.GetBool());
-    } else if (value.IsInt()) {
-        return Value(value.GetInt());
-    } else if (value.IsUint()) {
-        return Value(value.GetUint());
-    } else if (value.IsInt64()) {
-        return Value(value.GetInt64());
-    } else if (value.IsUint64()) {
-        return Value(value.GetUint64());
-    } else if (value.IsDouble()) {
-        return Value(value.GetDouble());
-    } else if (value.IsNull()) {
-        return Value(Value::Null);
-    } else if (value.IsString()) {
-        if (std::is_same<CharType, char16_t>::value) {
-            const char16_t* chars = (const char16_t*)value.GetString();
-            unsigned len = value.GetStringLength();
-            if (isAllLatin1(chars, len)) {
-                return new Latin1String(chars, len);
-            } else {
-                return new UTF16String(chars, len);
+    template <typename CharType>
+    void expectLiteral(const char* literal, size_t length)
+    {
+        const CharType* chars = characters<CharType>();
+        if (m_length - m_index < length) {
+            throwError("Invalid value.");
+        }
+        for (size_t i = 0; i < length; i++) {
+            if (chars[m_index + i] != literal[i]) {
+                throwError("Invalid value.");
             }
+        }
+        m_index += length;
+    }
+
+    template <typename CharType>
+    ALWAYS_INLINE bool isDigitAt(size_t index)
+    {
+        return index < m_length && characters<CharType>()[index] >= '0' && characters<CharType>()[index] <= '9';
+    }
+
+    static double stringToDouble(const LChar* chars, size_t length)
+    {
+        int processed;
+        return double_conversion::StringToDoubleConverter(double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0, nullptr, nullptr).StringToDouble((const char*)chars, (int)length, &processed);
+    }
+
+    static double stringToDouble(const char16_t* chars, size_t length)
+    {
+        int processed;
+        return double_conversion::StringToDoubleConverter(double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0, nullptr, nullptr).StringToDouble((const double_conversion::uc16*)chars, (int)length, &processed);
+    }
+
+    template <typename CharType>
+    Value parseNumber()
+    {
+        const CharType* chars = characters<CharType>();
+        size_t start = m_index;
+        bool negative = false;
+        if (chars[m_index] == '-') {
+            negative = true;
+            m_index++;
+        }
+
+        if (!isDigitAt<CharType>(m_index)) {
+            throwError("Invalid value.");
+        }
+        if (chars[m_index] == '0') {
+            m_index++;
         } else {
-            const char* valueAsString = (const char*)value.GetString();
-            if (isAllASCII(valueAsString, strlen(valueAsString))) {
-                return new ASCIIString(valueAsString);
-            } else {
-                return new UTF16String(utf8StringToUTF16String(valueAsString, strlen(valueAsString)));
+            while (isDigitAt<CharType>(m_index)) {
+                m_index++;
+            }
+        }
+
+        bool isInteger = true;
+        if (m_index < m_length && chars[m_index] == '.') {
+            isInteger = false;
+            m_index++;
+            if (!isDigitAt<CharType>(m_index)) {
+                throwError("Missing fraction part in number.");
+            }
+            while (isDigitAt<CharType>(m_index)) {
+                m_index++;
+            }
+        }
+        if (m_index < m_length && (chars[m_index] == 'e' || chars[m_index] == 'E')) {
+            isInteger = false;
+            m_index++;
+            if (m_index < m_length && (chars[m_index] == '+' || chars[m_index] == '-')) {
+                m_index++;
+            }
+            if (!isDigitAt<CharType>(m_index)) {
+                throwError("Missing exponent in number.");
+            }
+            while (isDigitAt<CharType>(m_index)) {
+                m_index++;
+            }
+        }
+
+        // integers up to 15 digits are exact in double
+        size_t digitStart = start + (negative ? 1 : 0);
+        if (isInteger && m_index - digitStart <= 15) {
+            int64_t number = 0;
+            for (size_t i = digitStart; i < m_index; i++) {
+                number = number * 10 + (chars[i] - '0');
+            }
+            if (negative) {
+                return Value(number ? (double)-number : -0.0);
+            }
+            return Value((double)number);
+        }
+        return Value(stringToDouble(chars + start, m_index - start));
+    }
+
+    template <typename CharType>
+    String* createString(size_t start, size_t end, bool isLatin1)
+    {
+        if (start == end) {
+            return String::emptyString;
+        }
+        const CharType* chars = characters<CharType>() + start;
+        if (sizeof(CharType) == 1) {
+            return new Latin1String((const LChar*)chars, end - start);
+        } else if (isLatin1) {
+            return new Latin1String((const char16_t*)chars, end - start);
+        }
+        return new UTF16String((const char16_t*)chars, end - start);
+    }
+
+    // scans string from m_index (after the opening quotation mark) to the closing one.
+    // returns false if there is an escape sequence at m_index
+    template <typename CharType>
+    ALWAYS_INLINE bool scanString(bool& isLatin1, size_t& hash)
+    {
+        const CharType* chars = characters<CharType>();
+        while (true) {
+            if (UNLIKELY(m_index >= m_length)) {
+                throwError("Missing a closing quotation mark in string.");
+            }
+            CharType c = chars[m_index];
+            if (c == '"') {
+                return true;
+            } else if (c == '\\') {
+                return false;
+            } else if (UNLIKELY(c < 0x20)) {
+                throwError("Invalid character in string.");
             }
+            if (sizeof(CharType) == 2 && c > 0xFF) {
+                isLatin1 = false;
+            }
+            hash = hash * 31 + c;
+            m_index++;
         }
-    } else if (value.IsArray()) {
-        ArrayObject* arr = new ArrayObject(state);
-        size_t i = 0;
-        auto iter = value.Begin();
-        while (iter != value.End()) {
-            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(i++)), ObjectPropertyDescriptor(parseJSONWorker<CharType, JSONCharType>(state, *iter), ObjectPropertyDescriptor::AllPresent));
-            iter++;
+    }
+
+    template <typename CharType>
+    String* parseStringWithEscape(size_t start)
+    {
+        const CharType* chars = characters<CharType>();
+        StringBuilder builder;
+        size_t runStart = start;
+        while (true) {
+            if (UNLIKELY(m_index >= m_length)) {
+                throwError("Missing a closing quotation mark in string.");
+            }
+            CharType c = chars[m_index];
+            if (c == '"') {
+                if (runStart < m_index) {
+                    builder.appendSubString(m_source, runStart, m_index);
+                }
+                m_index++;
+                return builder.finalize(&m_state);
+            } else if (UNLIKELY(c < 0x20)) {
+                throwError("Invalid character in string.");
+            } else if (c != '\\') {
+                m_index++;
+                continue;
+            }
+
+            if (runStart < m_index) {
+                builder.appendSubString(m_source, runStart, m_index);
+            }
+            m_index++;
+            if (m_index >= m_length) {
+                throwError("Invalid escape character in string.");
+            }
+            switch (chars[m_index++]) {
+            case '"':
+                builder.appendChar((char16_t)'"');
+                break;
+            case '\\':
+                builder.appendChar((char16_t)'\\');
+                break;
+            case '/':
+                builder.appendChar((char16_t)'/');
+                break;
+            case 'b':
+                builder.appendChar((char16_t)'\b');
+                break;
+            case 'f':
+                builder.appendChar((char16_t)'\f');
+                break;
+            case 'n':
+                builder.appendChar((char16_t)'\n');
+                break;
+            case 'r':
+                builder.appendChar((char16_t)'\r');
+                break;
+            case 't':
+                builder.appendChar((char16_t)'\t');
+                break;
+            case 'u': {
+                char16_t code = 0;
+                for (size_t i = 0; i < 4; i++, m_index++) {
+                    CharType h = m_index < m_length ? chars[m_index] : 0;
+                    if (h >= '0' && h <= '9') {
+                        code = code * 16 + (h - '0');
+                    } else if (h >= 'a' && h <= 'f') {
+                        code = code * 16 + (h - 'a' + 10);
+                    } else if (h >= 'A' && h <= 'F') {
+                        code = code * 16 + (h - 'A' + 10);
+                    } else {
+                        throwError("Incorrect hex digit after \\u escape in string.");
+                    }
+                }
+                builder.appendChar(code);
+                break;
+            }
+            default:
+                throwError("Invalid escape character in string.");
+            }
+            runStart = m_index;
+        }
+    }
+
+    template <typename CharType>
+    String* parseString()
+    {
+        ASSERT(characters<CharType>()[m_index] == '"');
+        size_t start = ++m_index;
+        bool isLatin1 = true;
+        size_t hash = 0;
+        if (UNLIKELY(!scanString<CharType>(isLatin1, hash))) {
+            return parseStringWithEscape<CharType>(start);
+        }
+        return createString<CharType>(start, m_index++, isLatin1);
+    }
+
+    template <typename CharType>
+    AtomicString parsePropertyName()
+    {
+        ASSERT(characters<CharType>()[m_index] == '"');
+        size_t start = ++m_index;
+        bool isLatin1 = true;
+        size_t hash = 0;
+        if (UNLIKELY(!scanString<CharType>(isLatin1, hash))) {
+            return AtomicString(m_state, parseStringWithEscape<CharType>(start));
+        }
+
+        size_t end = m_index++;
+        size_t length = end - start;
+        if (length > JSON_PARSE_PROPERTY_NAME_CACHE_MAX_LENGTH) {
+            return AtomicString(m_state, createString<CharType>(start, end, isLatin1));
+        }
+
+        AtomicString& cached = m_propertyNameCache[hash % JSON_PARSE_PROPERTY_NAME_CACHE_SIZE];
+        StringBufferAccessData nameData;
+        nameData.has8BitContent = sizeof(CharType) == 1;
+        nameData.length = length;
+        nameData.buffer = characters<CharType>() + start;
+        const auto& cachedData = cached.string()->bufferAccessData();
+        if (cachedData.length != length || !StringSearch::matchesAt(cachedData, nameData, 0)) {
+            cached = AtomicString(m_state, createString<CharType>(start, end, isLatin1));
+        }
+        return cached;
+    }
+
+    template <typename CharType>
+    Value parseArray(size_t depth)
+    {
+        checkJSONStackLimit(m_state);
+        const CharType* chars = characters<CharType>();
+        m_index++;
+        size_t base = m_valueStack.size();
+        if (isEnd<CharType>()) {
+            throwError("Missing a comma or ']' after an array element.");
+        }
+        if (chars[m_index] != ']') {
+            while (true) {
+                m_valueStack.pushBack(parseValue<CharType>(depth + 1));
+                if (isEnd<CharType>()) {
+                    throwError("Missing a comma or ']' after an array element.");
+                }
+                CharType c = chars[m_index++];
+                if (c == ']') {
+                    break;
+                } else if (c != ',') {
+                    throwError("Missing a comma or ']' after an array element.");
+                }
+            }
+        } else {
+            m_index++;
+        }
+
+        size_t count = m_valueStack.size() - base;
+        ArrayObject* arr = new ArrayObject(m_state, (double)count);
+        if (LIKELY(arr->isFastModeArray())) {
+            for (size_t i = 0; i < count; i++) {
+                arr->setFastModeElement(m_state, i, m_valueStack[base + i]);
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                arr->defineOwnProperty(m_state, ObjectPropertyName(m_state, Value(i)), ObjectPropertyDescriptor(m_valueStack[base + i], ObjectPropertyDescriptor::AllPresent));
+            }
         }
+        m_valueStack.resizeWithUninitializedValues(base);
         return arr;
-    } else if (value.IsObject()) {
-        Object* obj = new Object(state);
-        auto iter = value.MemberBegin();
-        while (iter != value.MemberEnd()) {
-            Value propertyName = parseJSONWorker<CharType, JSONCharType>(state, iter->name);
-            ASSERT(propertyName.isString());
-            obj->defineOwnProperty(state, ObjectPropertyName(state, propertyName), ObjectPropertyDescriptor(parseJSONWorker<CharType, JSONCharType>(state, iter->value), ObjectPropertyDescriptor::AllPresent));
-            iter++;
+    }
+
+    template <typename CharType>
+    Value parseObject(size_t depth)
+    {
+        checkJSONStackLimit(m_state);
+        const CharType* chars = characters<CharType>();
+        m_index++;
+        size_t base = m_valueStack.size();
+        if (isEnd<CharType>()) {
+            throwError("Missing a name for object member.");
         }
+        if (chars[m_index] != '}') {
+            while (true) {
+                if (isEnd<CharType>() || chars[m_index] != '"') {
+                    throwError("Missing a name for object member.");
+                }
+                AtomicString name = parsePropertyName<CharType>();
+                if (isEnd<CharType>() || chars[m_index] != ':') {
+                    throwError("Missing a colon after a name of object member.");
+                }
+                m_index++;
+                Value value = parseValue<CharType>(depth + 1);
+                m_propertyNameStack.pushBack(name);
+                m_valueStack.pushBack(value);
+                if (isEnd<CharType>()) {
+                    throwError("Missing a comma or '}' after an object member.");
+                }
+                CharType c = chars[m_index++];
+                if (c == '}') {
+                    break;
+                } else if (c != ',') {
+                    throwError("Missing a comma or '}' after an object member.");
+                }
+            }
+        } else {
+            m_index++;
+        }
+
+        size_t count = m_valueStack.size() - base;
+        Object* obj = new Object(m_state);
+        ObjectStructure* structure = depth < JSON_PARSE_STRUCTURE_CACHE_DEPTH ? m_structureCache[depth] : nullptr;
+        if (count && structure && hasSameProperties(structure, base, count)) {
+            obj->m_structure = structure;
+            obj->m_values.resizeWithUninitializedValues(0, count);
+            for (size_t i = 0; i < count; i++) {
+                obj->m_values[i] = m_valueStack[base + i];
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                obj->defineOwnProperty(m_state, ObjectPropertyName(m_propertyNameStack[base + i]), ObjectPropertyDescriptor(m_valueStack[base + i], ObjectPropertyDescriptor::AllPresent));
+            }
+            // structures in transition mode are shared and never modified
+            ObjectStructure* newStructure = obj->m_structure;
+            if (count && depth < JSON_PARSE_STRUCTURE_CACHE_DEPTH && newStructure->inTransitionMode() && !newStructure->isStructureWithFastAccess()) {
+                m_structureCache[depth] = newStructure;
+            }
+        }
+        m_valueStack.resizeWithUninitializedValues(base);
+        m_propertyNameStack.resizeWithUninitializedValues(base);
         return obj;
-    } else {
-        RELEASE_ASSERT_NOT_REACHED();
     }
-}
 
-template <typename CharType, typename JSONCharType>
-Value parseJSON(ExecutionState& state, const CharType* data, size_t length)
-{
-    auto strings = &state.context()->staticStrings();
-    rapidjson::GenericDocument<JSONCharType> jsonDocument;
-
-    JSONStringStream<JSONCharType> stringStream(data, length);
-    jsonDocument.ParseStream(stringStream);
-    if (jsonDocument.HasParseError()) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::SyntaxError, strings->JSON.string(), true, strings->parse.string(), rapidjson::GetParseError_En(jsonDocument.GetParseError()));
+    bool hasSameProperties(ObjectStructure* structure, size_t base, size_t count)
+    {
+        if (structure->propertyCount() != count) {
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (structure->readProperty(m_state, i).m_propertyName != PropertyName(m_propertyNameStack[base + i])) {
+                return false;
+            }
+        }
+        return true;
     }
 
-    return parseJSONWorker<CharType, JSONCharType>(state, jsonDocument);
-}
+    ExecutionState& m_state;
+    String* m_source;
+    bool m_has8BitContent;
+    const void* m_data;
+    size_t m_length;
+    size_t m_index;
+    // values and names of the arrays and objects being parsed
+    ValueVector m_valueStack;
+    Vector<AtomicString, GCUtil::gc_malloc_ignore_off_page_allocator<AtomicString>> m_propertyNameStack;
+    AtomicString m_propertyNameCache[JSON_PARSE_PROPERTY_NAME_CACHE_SIZE];
+    ObjectStructure* m_structureCache[JSON_PARSE_STRUCTURE_CACHE_DEPTH];
+};
 
 String* codePointTo4digitString(int codepoint)
 {
@@ -194,20 +568,7 @@ static Value builtinJSONParse(ExecutionState& state, Value thisValue, size_t arg
 
     // 1, 2, 3
     String* JText = argv[0].toString(state);
-    Value unfiltered;
-
-    if (JText->has8BitContent()) {
-        size_t len = JText->length();
-        char16_t* char16Buf = new char16_t[len];
-        std::unique_ptr<char16_t[]> buf(char16Buf);
-        const LChar* srcBuf = JText->characters8();
-        for (size_t i = 0; i < len; i++) {
-            char16Buf[i] = srcBuf[i];
-        }
-        unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, buf.get(), JText->length());
-    } else {
-        unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, JText->characters16(), JText->length());
-    }
+    Value unfiltered = JSONParser(state, JText).parse();
 
     // 4
     Value reviver = argv[1];
@@ -277,6 +638,481 @@ static Value builtinJSONParse(ExecutionState& state, Value thisValue, size_t arg
     return unfiltered;
 }
 
+// output of JSONStringifier as a string.
+// characters are kept in 8-bit until a character which does not fit in 8-bit is written
+class JSONStringBuffer {
+public:
+    JSONStringBuffer()
+        : m_is8Bit(true)
+    {
+    }
+
+    void appendChar(char c)
+    {
+        if (m_is8Bit) {
+            m_latin1.push_back(c);
+        } else {
+            m_utf16.push_back(c);
+        }
+    }
+
+    void appendASCII(const char* src, size_t length)
+    {
+        if (m_is8Bit) {
+            m_latin1.append((const LChar*)src, length);
+        } else {
+            for (size_t i = 0; i < length; i++) {
+                m_utf16.push_back(src[i]);
+            }
+        }
+    }
+
+    void appendChars(const LChar* src, size_t length)
+    {
+        if (m_is8Bit) {
+            m_latin1.append(src, length);
+        } else {
+            for (size_t i = 0; i < length; i++) {
+                m_utf16.push_back(src[i]);
+            }
+        }
+    }
+
+    void appendChars(const char16_t* src, size_t length)
+    {
+        if (m_is8Bit) {
+            size_t i = 0;
+            while (i < length && src[i] <= 0xFF) {
+                m_latin1.push_back(src[i]);
+                i++;
+            }
+            if (i == length) {
+                return;
+            }
+            widen();
+            src += i;
+            length -= i;
+        }
+        m_utf16.append(src, length);
+    }
+
+    String* finalize()
+    {
+        if (m_is8Bit) {
+            return new Latin1String(m_latin1.data(), m_latin1.length());
+        }
+        return new UTF16String(m_utf16.data(), m_utf16.length());
+    }
+
+private:
+    void widen()
+    {
+        m_utf16.reserve(m_latin1.length() * 2);
+        for (size_t i = 0; i < m_latin1.length(); i++) {
+            m_utf16.push_back(m_latin1[i]);
+        }
+        m_latin1.clear();
+        m_is8Bit = false;
+    }
+
+    bool m_is8Bit;
+    Latin1StringDataNonGCStd m_latin1;
+    UTF16StringDataNonGCStd m_utf16;
+};
+
+// output of JSONStringifier as UTF-8 bytes.
+// the bytes are same as the UTF-8 conversion of the string result
+class JSONUTF8Buffer {
+public:
+    void appendChar(char c)
+    {
+        m_buffer.push_back(c);
+    }
+
+    void appendASCII(const char* src, size_t length)
+    {
+        m_buffer.append(src, length);
+    }
+
+    void appendChars(const LChar* src, size_t length)
+    {
+        for (size_t i = 0; i < length; i++) {
+            LChar ch = src[i];
+            if (ch < 0x80) {
+                m_buffer.push_back(ch);
+            } else {
+                m_buffer.push_back(0xC0 | (ch >> 6));
+                m_buffer.push_back(0x80 | (ch & 0x3F));
+            }
+        }
+    }
+
+    // a chunk always ends before a quote or a backslash,
+    // so a lead surrogate at the end of it is unpaired
+    void appendChars(const char16_t* src, size_t length)
+    {
+        for (size_t i = 0; i < length; i++) {
+            char32_t ch = src[i];
+            if (ch < 0x80) {
+                m_buffer.push_back(ch);
+                continue;
+            }
+            if (U16_IS_LEAD(ch)) {
+                if (i + 1 < length && U16_IS_TRAIL(src[i + 1])) {
+                    ch = U16_GET_SUPPLEMENTARY(ch, src[i + 1]);
+                    i++;
+                } else {
+                    ch = 0xFFFD;
+                }
+            }
+            char buf[8];
+            m_buffer.append(buf, utf32ToUtf8(ch, buf));
+        }
+    }
+
+    UTF8StringDataNonGCStd& result()
+    {
+        return m_buffer;
+    }
+
+private:
+    UTF8StringDataNonGCStd m_buffer;
+};
+
+template <typename Buffer, typename CharType>
+static void appendJSONQuotedChars(Buffer& out, const CharType* chars, size_t length)
+{
+    out.appendChar('"');
+    size_t start = 0;
+    for (size_t i = 0; i < length; i++) {
+        char16_t c = chars[i];
+        if (LIKELY(c >= ' ' && c != '"' && c != '\\')) {
+            continue;
+        }
+        out.appendChars(chars + start, i - start);
+        start = i + 1;
+        switch (c) {
+        case '"':
+            out.appendASCII("\\\"", 2);
+            break;
+        case '\\':
+            out.appendASCII("\\\\", 2);
+            break;
+        case '\b':
+            out.appendASCII("\\b", 2);
+            break;
+        case '\f':
+            out.appendASCII("\\f", 2);
+            break;
+        case '\n':
+            out.appendASCII("\\n", 2);
+            break;
+        case '\r':
+            out.appendASCII("\\r", 2);
+            break;
+        case '\t':
+            out.appendASCII("\\t", 2);
+            break;
+        default: {
+            const char* hex = "0123456789abcdef";
+            char escaped[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+            out.appendASCII(escaped, 6);
+        }
+        }
+    }
+    out.appendChars(chars + start, length - start);
+    out.appendChar('"');
+}
+
+template <typename Buffer>
+static void appendJSONQuotedString(Buffer& out, String* str)
+{
+    const auto& data = str->bufferAccessData();
+    if (data.has8BitContent) {
+        appendJSONQuotedChars(out, (const LChar*)data.buffer, data.length);
+    } else {
+        appendJSONQuotedChars(out, (const char16_t*)data.buffer, data.length);
+    }
+}
+
+template <typename Buffer>
+static void appendJSONString(Buffer& out, String* str)
+{
+    const auto& data = str->bufferAccessData();
+    if (data.has8BitContent) {
+        out.appendChars((const LChar*)data.buffer, data.length);
+    } else {
+        out.appendChars((const char16_t*)data.buffer, data.length);
+    }
+}
+
+// quoted keys of a structure, in the order of its properties.
+// key is null when JSON.stringify skips the property (non-enumerable or symbol)
+class JSONStringifyKeys : public gc {
+public:
+    JSONStringifyKeys()
+        : m_isSerializable(true)
+    {
+    }
+
+    // false if there is toJSON or an enumerable accessor
+    bool m_isSerializable;
+    Vector<String*, GCUtil::gc_malloc_ignore_off_page_allocator<String*>> m_quotedKeys;
+
+    void* operator new(size_t size)
+    {
+        static bool typeInited = false;
+        static GC_descr descr;
+        if (!typeInited) {
+            GC_word obj_bitmap[GC_BITMAP_SIZE(JSONStringifyKeys)] = { 0 };
+            GC_set_bit(obj_bitmap, GC_WORD_OFFSET(JSONStringifyKeys, m_quotedKeys));
+            descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(JSONStringifyKeys));
+            typeInited = true;
+        }
+        return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    }
+    void* operator new[](size_t size) = delete;
+};
+
+// JSON.stringify without replacer for plain objects and fast mode arrays.
+// it reads values of objects directly, so it gives up (returns false) on anything which can run JS code:
+// toJSON, accessors, holes of arrays and other kinds of objects.
+// nothing is observable until then, so the caller can start over with the generic algorithm
+template <typename Buffer>
+class JSONStringifier {
+public:
+    JSONStringifier(ExecutionState& state, String* gap)
+        : m_state(state)
+        , m_gap(gap)
+        , m_objectPrototype(state.context()->globalObject()->objectPrototype())
+        , m_arrayPrototype(state.context()->globalObject()->arrayPrototype())
+    {
+    }
+
+    bool stringify(const Value& value)
+    {
+        if (value.isUndefined() || value.isSymbol() || !canUseFastPath()) {
+            return false;
+        }
+        return appendValue(value);
+    }
+
+    Buffer& buffer()
+    {
+        return m_buffer;
+    }
+
+private:
+    bool canUseFastPath()
+    {
+        PropertyName toJSON(m_state.context()->staticStrings().toJSON);
+        return m_objectPrototype->getPrototypeObject(m_state) == nullptr
+            && m_arrayPrototype->getPrototypeObject(m_state) == m_objectPrototype
+            && m_objectPrototype->structure()->findProperty(toJSON) == SIZE_MAX
+            && m_arrayPrototype->structure()->findProperty(toJSON) == SIZE_MAX;
+    }
+
+    // undefined and symbol values are handled by callers
+    bool appendValue(const Value& value)
+    {
+        if (value.isString()) {
+            appendJSONQuotedString(m_buffer, value.asString());
+        } else if (value.isNumber()) {
+            appendNumber(value);
+        } else if (value.isNull()) {
+            m_buffer.appendASCII("null", 4);
+        } else if (value.isBoolean()) {
+            if (value.asBoolean()) {
+                m_buffer.appendASCII("true", 4);
+            } else {
+                m_buffer.appendASCII("false", 5);
+            }
+        } else if (value.isObject()) {
+            Object* obj = value.asObject();
+            size_t tag = *((size_t*)obj);
+            if (tag == g_objectTag) {
+                return appendObject(obj);
+            } else if (tag == g_arrayObjectTag) {
+                return appendArray(obj->asArrayObject());
+            }
+            return false;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void appendNumber(const Value& value)
+    {
+        if (value.isInt32()) {
+            int32_t num = value.asInt32();
+            uint32_t n = num < 0 ? -(uint32_t)num : num;
+            char buf[12];
+            char* end = buf + sizeof(buf);
+            char* p = end;
+            do {
+                *--p = '0' + n % 10;
+                n /= 10;
+            } while (n);
+            if (num < 0) {
+                *--p = '-';
+            }
+            m_buffer.appendASCII(p, end - p);
+            return;
+        }
+
+        double d = value.asNumber();
+        if (!std::isfinite(d)) {
+            m_buffer.appendASCII("null", 4);
+        } else if (d == 0) {
+            m_buffer.appendChar('0');
+        } else {
+            ASCIIStringData s = dtoa(d);
+            m_buffer.appendASCII(s.data(), s.length());
+        }
+    }
+
+    bool appendObject(Object* obj)
+    {
+        if (obj->getPrototypeObject(m_state) != m_objectPrototype) {
+            return false;
+        }
+        JSONStringifyKeys* keys = keysOf(obj->structure());
+        if (!keys->m_isSerializable) {
+            return false;
+        }
+        enter(obj, errorMessage_GlobalObject_JOError);
+
+        m_buffer.appendChar('{');
+        bool isEmpty = true;
+        size_t count = keys->m_quotedKeys.size();
+        for (size_t i = 0; i < count; i++) {
+            String* key = keys->m_quotedKeys[i];
+            if (!key) {
+                continue;
+            }
+            Value value = obj->m_values[i];
+            if (value.isUndefined() || value.isSymbol()) {
+                continue;
+            }
+            if (!isEmpty) {
+                m_buffer.appendChar(',');
+            }
+            isEmpty = false;
+            appendIndent(m_stack.size());
+            appendJSONString(m_buffer, key);
+            m_buffer.appendChar(':');
+            if (m_gap->length()) {
+                m_buffer.appendChar(' ');
+            }
+            if (!appendValue(value)) {
+                return false;
+            }
+        }
+        if (!isEmpty) {
+            appendIndent(m_stack.size() - 1);
+        }
+        m_buffer.appendChar('}');
+
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool appendArray(ArrayObject* arr)
+    {
+        if (!arr->isFastModeArray() || arr->getPrototypeObject(m_state) != m_arrayPrototype || !keysOf(arr->structure())->m_isSerializable) {
+            return false;
+        }
+        enter(arr, errorMessage_GlobalObject_JAError);
+
+        m_buffer.appendChar('[');
+        uint32_t length = arr->getArrayLength(m_state);
+        for (uint32_t i = 0; i < length; i++) {
+            Value value = arr->getFastModeElement(i);
+            // holes are read from the prototype chain
+            if (value.isEmpty()) {
+                return false;
+            }
+            if (i) {
+                m_buffer.appendChar(',');
+            }
+            appendIndent(m_stack.size());
+            if (value.isUndefined() || value.isSymbol()) {
+                m_buffer.appendASCII("null", 4);
+            } else if (!appendValue(value)) {
+                return false;
+            }
+        }
+        if (length) {
+            appendIndent(m_stack.size() - 1);
+        }
+        m_buffer.appendChar(']');
+
+        m_stack.pop_back();
+        return true;
+    }
+
+    void enter(Object* obj, const char* cycleErrorMessage)
+    {
+        checkJSONStackLimit(m_state);
+        for (size_t i = 0; i < m_stack.size(); i++) {
+            if (m_stack[i] == obj) {
+                auto strings = &m_state.context()->staticStrings();
+                ErrorObject::throwBuiltinError(m_state, ErrorObject::TypeError, strings->JSON.string(), false, strings->stringify.string(), cycleErrorMessage);
+            }
+        }
+        m_stack.pushBack(obj);
+    }
+
+    void appendIndent(size_t depth)
+    {
+        if (m_gap->length()) {
+            m_buffer.appendChar('\n');
+            for (size_t i = 0; i < depth; i++) {
+                appendJSONString(m_buffer, m_gap);
+            }
+        }
+    }
+
+    JSONStringifyKeys* keysOf(ObjectStructure* structure)
+    {
+        if (LIKELY(structure->m_jsonStringifyKeys != nullptr)) {
+            return structure->m_jsonStringifyKeys;
+        }
+
+        JSONStringifyKeys* keys = new JSONStringifyKeys();
+        PropertyName toJSON(m_state.context()->staticStrings().toJSON);
+        size_t count = structure->propertyCount();
+        keys->m_quotedKeys.resizeWithUninitializedValues(count);
+        for (size_t i = 0; i < count; i++) {
+            const ObjectStructureItem& item = structure->readProperty(m_state, i);
+            String* quotedKey = nullptr;
+            if (item.m_propertyName == toJSON) {
+                keys->m_isSerializable = false;
+            } else if (!item.m_propertyName.isSymbol() && item.m_descriptor.isEnumerable()) {
+                if (item.m_descriptor.isPlainDataProperty()) {
+                    JSONStringBuffer quoted;
+                    appendJSONQuotedString(quoted, item.m_propertyName.plainString());
+                    quotedKey = quoted.finalize();
+                } else {
+                    keys->m_isSerializable = false;
+                }
+            }
+            keys->m_quotedKeys[i] = quotedKey;
+        }
+        structure->m_jsonStringifyKeys = keys;
+        return keys;
+    }
+
+    ExecutionState& m_state;
+    String* m_gap;
+    Object* m_objectPrototype;
+    Object* m_arrayPrototype;
+    // arrays and objects being serialized
+    Vector<Object*, GCUtil::gc_malloc_ignore_off_page_allocator<Object*>> m_stack;
+    Buffer m_buffer;
+};
+
 static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
 {
     auto strings = &state.context()->staticStrings();
@@ -365,6 +1201,13 @@ static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t
         }
     }
 
+    if (!replacerFunc && !propertyListTouched) {
+        JSONStringifier<JSONStringBuffer> stringifier(state, gap);
+        if (stringifier.stringify(value)) {
+            return stringifier.buffer().finalize();
+        }
+    }
+
     std::function<Value(ObjectPropertyName key, Object * holder)> Str;
     std::function<String*(ArrayObject*)> JA;
     std::function<String*(Object*)> JO;
@@ -624,6 +1467,21 @@ static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t
     return Str(ObjectPropertyName(state, Value(String::emptyString)), wrapper);
 }
 
+UTF8StringDataNonGCStd GlobalObject::jsonStringifyToUTF8(ExecutionState& state, const Value& value)
+{
+    JSONStringifier<JSONUTF8Buffer> stringifier(state, String::emptyString);
+    if (stringifier.stringify(value)) {
+        return std::move(stringifier.buffer().result());
+    }
+
+    Value argv[3] = { value, Value(), Value() };
+    Value result = builtinJSONStringify(state, Value(), 3, argv, false);
+    if (result.isUndefined()) {
+        return UTF8StringDataNonGCStd();
+    }
+    return result.asString()->toNonGCUTF8StringData();
+}
+
 void GlobalObject::installJSON(ExecutionState& state)
 {
     m_json = new Object(state);
@@ -25,6 +25,7 @@
 #include "ErrorObject.h"
 #include "RegExpObject.h"
 #include "ArrayObject.h"
+#include "StringSearch.h"
 #include "parser/Lexer.h"
 
 namespace Escargot {
@@ -566,27 +567,13 @@ static Value builtinStringSplit(ExecutionState& state, Value thisValue, size_t a
         return A;
     }
 
-    std::function<Value(String*, int, String*)> splitMatchUsingStr;
-    splitMatchUsingStr = [](String* S, int q, String* R) -> Value {
-        int s = S->length();
-        int r = R->length();
-        if (q + r > s)
-            return Value(false);
-        for (int i = 0; i < r; i++)
-            if (S->charAt(q + i) != R->charAt(i))
-                return Value(false);
-        return Value(q + r);
-    };
     if (s == 0) {
         bool ret = true;
         if (P->isRegExpObject()) {
             RegexMatchResult result;
             ret = P->asRegExpObject()->matchNonGlobally(state, S, result, false, 0);
         } else {
-            Value z = splitMatchUsingStr(S, 0, P->asString());
-            if (z.isBoolean()) {
-                ret = z.asBoolean();
-            }
+            ret = StringSearch::matchesAt(S->bufferAccessData(), P->asString()->bufferAccessData(), 0);
         }
         if (ret)
             return A;
@@ -624,24 +611,24 @@ static Value builtinStringSplit(ExecutionState& state, Value thisValue, size_t a
         }
     } else {
         String* R = P->asString();
+        size_t r = R->length();
         while (q != s) {
-            Value e = splitMatchUsingStr(S, q, R);
-            if (e == Value(false))
+            q = StringSearch::find(S->bufferAccessData(), R->bufferAccessData(), q);
+            if (q == SIZE_MAX) {
+                break;
+            }
+            if (q + r == p) {
                 q++;
-            else {
-                if ((size_t)e.asInt32() == p)
-                    q++;
-                else {
-                    if (q >= S->length())
-                        break;
-
-                    String* T = S->substring(p, q);
-                    A->defineOwnProperty(state, ObjectPropertyName(state, Value(lengthA++)), ObjectPropertyDescriptor(T, ObjectPropertyDescriptor::AllPresent));
-                    if (lengthA == lim)
-                        return A;
-                    p = e.asInt32();
-                    q = p;
-                }
+            } else {
+                if (q >= s)
+                    break;
+
+                String* T = S->substring(p, q);
+                A->defineOwnProperty(state, ObjectPropertyName(state, Value(lengthA++)), ObjectPropertyDescriptor(T, ObjectPropertyDescriptor::AllPresent));
+                if (lengthA == lim)
+                    return A;
+                p = q + r;
+                q = p;
             }
         }
     }
@@ -907,16 +894,7 @@ static Value builtinStringStartsWith(ExecutionState& state, Value thisValue, siz
     }
     // If the sequence of elements of S starting at start of length searchLength is the same as the full element sequence of searchStr, return true.
     // Otherwise, return false.
-    const auto& srcData = S->bufferAccessData();
-    const auto& src2Data = searchStr->bufferAccessData();
-
-    for (size_t i = 0; i < src2Data.length; i++) {
-        if (srcData.charAt(i + start) != src2Data.charAt(i)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(StringSearch::matchesAt(S->bufferAccessData(), searchStr->bufferAccessData(), start));
 }
 
 static Value builtinStringEndsWith(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
@@ -954,15 +932,7 @@ static Value builtinStringEndsWith(ExecutionState& state, Value thisValue, size_
         return Value(false);
     }
     // If the sequence of elements of S starting at start of length searchLength is the same as the full element sequence of searchStr, return true.
-    const auto& srcData = S->bufferAccessData();
-    const auto& src2Data = searchStr->bufferAccessData();
-    for (size_t i = 0; i < searchLength; i++) {
-        if (srcData.charAt(i + start) != src2Data.charAt(i)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(StringSearch::matchesAt(S->bufferAccessData(), searchStr->bufferAccessData(), start));
 }
 
 // ( template, ...substitutions )
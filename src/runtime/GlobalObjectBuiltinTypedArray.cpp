@@ -426,7 +426,6 @@ Value builtinTypedArrayConstructor(ExecutionState& state, Value thisValue, size_
             // Let srcName be the String value of srcArray’s [[TypedArrayName]] internal slot.
             // Let srcType be the String value of the Element Type value in Table 49 for srcName.
             // Let srcElementSize be the Element Size value in Table 49 for srcName.
-            int srcElementSize = ArrayBufferView::getElementSize(srcArray->typedArrayType());
             // Let srcByteOffset be the value of srcArray’s [[ByteOffset]] internal slot.
             unsigned srcByteOffset = srcArray->byteoffset();
             // Let elementSize be the Element Size value in Table 49 for constructorName.
@@ -447,24 +446,11 @@ Value builtinTypedArrayConstructor(ExecutionState& state, Value thisValue, size_
                 Value arg[1] = { Value(byteLength) };
                 data = ByteCodeInterpreter::newOperation(state, bufferConstructor, 1, arg)->asArrayBufferObject();
 
-                // Let srcByteIndex be srcByteOffset.
-                unsigned srcByteIndex = srcByteOffset;
-                // Let targetByteIndex be 0.
-                unsigned targetByteIndex = 0;
-                // Let count be elementLength.
-                unsigned count = elementLength;
-                // Repeat, while count > 0
-                while (count > 0) {
-                    // Let value be GetValueFromBuffer(srcData, srcByteIndex, srcType).
-                    Value value = srcData->getValueFromBuffer<typename TypeAdaptor::Type>(state, srcByteIndex);
-                    // Perform SetValueInBuffer(data, targetByteIndex, elementType, value).
-                    data->setValueInBuffer<TypeAdaptor>(state, targetByteIndex, value);
-                    // Set srcByteIndex to srcByteIndex + srcElementSize.
-                    srcByteIndex += srcElementSize;
-                    // Set targetByteIndex to targetByteIndex + elementSize.
-                    targetByteIndex += elementSize;
-                    // Decrement count by 1.
-                    count--;
+                if (srcData->isDetachedBuffer()) {
+                    ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().TypedArray.string(), true, state.context()->staticStrings().constructor.string(), errorMessage_GlobalObject_DetachedBuffer);
+                }
+                if (data->bytelength() < byteLength) {
+                    ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, state.context()->staticStrings().TypedArray.string(), false, String::emptyString, errorMessage_GlobalObject_InvalidArrayBufferSize);
                 }
             }
             // Set O’s [[ViewedArrayBuffer]] internal slot to data.
@@ -472,6 +458,10 @@ Value builtinTypedArrayConstructor(ExecutionState& state, Value thisValue, size_
             // Set O’s [[ByteOffset]] internal slot to 0.
             // Set O’s [[ArrayLength]] internal slot to elementLength.
             obj->setBuffer(data, 0, byteLength, elementLength);
+            if (obj->typedArrayType() != srcArray->typedArrayType()) {
+                // Repeat GetValueFromBuffer(srcData, srcByteIndex, srcType) and SetValueInBuffer(data, targetByteIndex, elementType, value) for each element
+                obj->copyElementsFrom(state, 0, srcArray, 0, elementLength);
+            }
         } else if (val.isObject()) {
             // TODO implement 22.2.1.4
             Object* inputObj = val.asObject();
@@ -486,7 +476,11 @@ Value builtinTypedArrayConstructor(ExecutionState& state, Value thisValue, size_
             ArrayBufferObject* buffer = new ArrayBufferObject(state);
             buffer->allocateBuffer(bufferSize);
             obj->setBuffer(buffer, 0, length * elementSize, length);
-            for (uint64_t i = 0; i < length; i++) {
+            uint64_t i = 0;
+            if (inputObj->isArrayObject()) {
+                i = obj->copyElementsFromFastModeArray(state, 0, inputObj->asArrayObject(), length);
+            }
+            for (; i < length; i++) {
                 ObjectPropertyName pK(state, Value(i));
                 obj->setThrowsException(state, pK, inputObj->get(state, pK).value(state, inputObj), obj);
             }
@@ -532,6 +526,13 @@ static Value builtinTypedArrayCopyWithin(ExecutionState& state, Value thisValue,
 
     // Let count be min(final-from, len-to).
     double count = std::min(finalEnd - from, len - to);
+    ArrayBufferView* view = O->asArrayBufferView();
+    if (!view->buffer()->isDetachedBuffer()) {
+        if (count > 0) {
+            view->copyElementsFrom(state, to, view, from, count);
+        }
+        return O;
+    }
     int8_t direction;
     // If from<to and to<from+count
     if (from < to && to < from + count) {
@@ -612,6 +613,13 @@ static Value builtinTypedArrayIndexOf(ExecutionState& state, Value thisValue, si
         }
     }
 
+    // Strict Equality Comparison with a number compares element values directly
+    ArrayBufferView* view = O->asArrayBufferView();
+    if (argv[0].isNumber() && !view->buffer()->isDetachedBuffer()) {
+        size_t index = view->indexOfElement(argv[0].asNumber(), k, len);
+        return index == SIZE_MAX ? Value(-1) : Value(index);
+    }
+
     // Repeat, while k<len
     while (k < len) {
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
@@ -668,6 +676,12 @@ static Value builtinTypedArrayLastIndexOf(ExecutionState& state, Value thisValue
         k = len - std::abs(n);
     }
 
+    ArrayBufferView* view = O->asArrayBufferView();
+    if (argv[0].isNumber() && k >= 0 && !view->buffer()->isDetachedBuffer()) {
+        size_t index = view->lastIndexOfElement(argv[0].asNumber(), k);
+        return index == SIZE_MAX ? Value(-1) : Value(index);
+    }
+
     // Repeat, while k≥ 0
     while (k >= 0) {
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
@@ -731,6 +745,10 @@ static Value builtinTypedArraySet(ExecutionState& state, Value thisValue, size_t
         int targetByteIndex = offset * targetElementSize + targetByteOffset;
         int k = 0;
         int limit = targetByteIndex + targetElementSize * srcLength;
+        if (src->isArrayObject() && !targetBuffer->isDetachedBuffer()) {
+            k = wrapper->copyElementsFromFastModeArray(state, offset, src->asArrayObject(), srcLength);
+            targetByteIndex += k * targetElementSize;
+        }
         while (targetByteIndex < limit) {
             double kNumber = src->get(state, ObjectPropertyName(state, Value(k))).value(state, src).toNumber(state);
             wrapper->setThrowsException(state, ObjectPropertyName(state, Value(targetByteIndex / targetElementSize)), Value(kNumber), wrapper);
@@ -742,39 +760,16 @@ static Value builtinTypedArraySet(ExecutionState& state, Value thisValue, size_t
         auto arg0Wrapper = arg0->asArrayBufferView();
         ArrayBufferObject* srcBuffer = arg0Wrapper->buffer();
         unsigned srcLength = arg0Wrapper->arraylength();
-        int srcByteOffset = arg0Wrapper->byteoffset();
+        if (srcBuffer->isDetachedBuffer() || targetBuffer->isDetachedBuffer()) {
+            const StaticStrings* strings = &state.context()->staticStrings();
+            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, strings->TypedArray.string(), true, strings->set.string(), errorMessage_GlobalObject_DetachedBuffer);
+        }
         if (((double)srcLength + (double)offset) > (double)targetLength) {
             const StaticStrings* strings = &state.context()->staticStrings();
             ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, strings->TypedArray.string(), true, strings->set.string(), errorMessage_GlobalObject_InvalidArrayLength);
         }
-        int srcByteIndex = 0;
-        ArrayBufferObject* oldSrcBuffer = srcBuffer;
-        unsigned oldSrcByteoffset = arg0Wrapper->byteoffset();
-        unsigned oldSrcBytelength = arg0Wrapper->bytelength();
-        unsigned oldSrcArraylength = arg0Wrapper->arraylength();
-        if (srcBuffer == targetBuffer) {
-            // NOTE: Step 24
-            srcBuffer = new ArrayBufferObject(state);
-            bool succeed = srcBuffer->cloneBuffer(targetBuffer, srcByteOffset, oldSrcBytelength);
-            if (!succeed) {
-                const StaticStrings* strings = &state.context()->staticStrings();
-                ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, strings->TypedArray.string(), true, strings->set.string(), "");
-            }
-            arg0Wrapper->setBuffer(srcBuffer, 0, srcBuffer->bytelength(), oldSrcArraylength);
-        } else {
-            srcByteIndex = srcByteOffset;
-        }
-        unsigned targetIndex = (unsigned)offset, srcIndex = 0;
-        unsigned targetByteIndex = offset * targetElementSize + targetByteOffset;
-        unsigned limit = targetByteIndex + targetElementSize * srcLength;
-        while (targetIndex < offset + srcLength) {
-            Value value = arg0Wrapper->get(state, ObjectPropertyName(state, Value(srcIndex))).value(state, arg0Wrapper);
-            wrapper->setThrowsException(state, ObjectPropertyName(state, Value(targetIndex)), value, wrapper);
-            srcIndex++;
-            targetIndex++;
-        }
-        if (oldSrcBuffer != srcBuffer)
-            arg0Wrapper->setBuffer(oldSrcBuffer, oldSrcByteoffset, oldSrcBytelength, oldSrcArraylength);
+        // NOTE: Step 24, source in same buffer is handled by copyElementsFrom
+        wrapper->copyElementsFrom(state, offset, arg0Wrapper, 0, srcLength);
         return Value();
     }
 }
@@ -984,6 +979,13 @@ static Value builtinTypedArrayFill(ExecutionState& state, Value thisValue, size_
     unsigned fin = (relativeEnd < 0) ? std::max(len + relativeEnd, 0.0) : std::min(relativeEnd, len);
 
     Value value = argv[0];
+    ArrayBufferView* view = O->asArrayBufferView();
+    if (value.isNumber() && !view->buffer()->isDetachedBuffer()) {
+        if (k < fin) {
+            view->fillElements(state, k, fin, value.asNumber());
+        }
+        return O;
+    }
     while (k < fin) {
         O->setIndexedPropertyThrowsException(state, Value(k), value);
         k++;
@@ -1434,8 +1436,15 @@ static Value builtinTypedArraySlice(ExecutionState& state, Value thisValue, size
     Value arg[1] = { Value(count) };
     Value A = ByteCodeInterpreter::newOperation(state, C, 1, arg);
 
-    // If SameValue(srcType, targetType) is false, then
-    if (O->asArrayBufferView()->typedArrayType() != A.asObject()->asArrayBufferView()->typedArrayType()) {
+    auto srcWrapper = O->asArrayBufferView();
+    auto targetWrapper = A.asObject()->asArrayBufferView();
+    if (count > 0 && targetWrapper->arraylength() >= count && !targetWrapper->buffer()->isDetachedBuffer()) {
+        if (srcWrapper->buffer()->isDetachedBuffer()) {
+            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().TypedArray.string(), false, String::emptyString, errorMessage_GlobalObject_DetachedBuffer);
+        }
+        // If SameValue(srcType, targetType) is false, elements are converted. otherwise bytes are copied
+        targetWrapper->copyElementsFrom(state, 0, srcWrapper, k, count);
+    } else {
         size_t n = 0;
         while (k < finalEnd) {
             Value kValue = O->getIndexedProperty(state, Value(k)).value(state, O);
@@ -1443,27 +1452,6 @@ static Value builtinTypedArraySlice(ExecutionState& state, Value thisValue, size
             k++;
             n++;
         }
-        // Else if count > 0,
-    } else if (count > 0) {
-        auto srcWrapper = O->asArrayBufferView();
-        auto targetWrapper = A.asObject()->asArrayBufferView();
-
-        ArrayBufferObject* srcBuffer = srcWrapper->buffer();
-        if (srcBuffer->isDetachedBuffer()) {
-            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().TypedArray.string(), false, String::emptyString, errorMessage_GlobalObject_DetachedBuffer);
-        }
-        ArrayBufferObject* targetBuffer = targetWrapper->buffer();
-        unsigned elementSize = ArrayBufferView::getElementSize(srcWrapper->typedArrayType());
-        unsigned srcByteOffset = srcWrapper->byteoffset();
-        unsigned targetByteIndex = 0;
-        unsigned srcByteIndex = k * elementSize + srcByteOffset;
-
-        while (targetByteIndex < count * elementSize) {
-            Value value = srcWrapper->getValueFromBuffer<uint8_t>(state, srcByteIndex);
-            targetWrapper->setValueInBuffer<Uint8Adaptor>(state, targetByteIndex, value);
-            srcByteIndex++;
-            targetByteIndex++;
-        }
     }
     // Return A.
     return A;
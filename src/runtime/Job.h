@@ -51,7 +51,10 @@ public:
         RELEASE_ASSERT_NOT_REACHED();
     }
 
-    virtual SandBox::SandBoxResult run() = 0;
+    // runs job in a SandBox of its own
+    SandBox::SandBoxResult run();
+    // runs job in SandBox of caller. VMInstance::drainJobQueue shares one SandBox among jobs of a context
+    virtual Value runInSandBox(ExecutionState& state) = 0;
     Context* relatedContext() const
     {
         return m_relatedContext;
@@ -76,7 +79,7 @@ public:
     {
     }
 
-    SandBox::SandBoxResult run();
+    Value runInSandBox(ExecutionState& state);
 
 private:
     PromiseReaction m_reaction;
@@ -93,7 +96,7 @@ public:
     {
     }
 
-    SandBox::SandBoxResult run();
+    Value runInSandBox(ExecutionState& state);
 
 private:
     PromiseObject* m_promise;
@@ -28,6 +28,8 @@
 
 namespace Escargot {
 
+COMPILE_ASSERT((ESCARGOT_JOB_QUEUE_INITIAL_CAPACITY & (ESCARGOT_JOB_QUEUE_INITIAL_CAPACITY - 1)) == 0, "capacity of job queue should be power of 2");
+
 JobQueue* JobQueue::create()
 {
     return DefaultJobQueue::create();
@@ -38,10 +40,44 @@ size_t DefaultJobQueue::enqueueJob(ExecutionState& state, Job* job)
     if (state.context()->vmInstance()->m_jobQueueListener) {
         state.context()->vmInstance()->m_jobQueueListener(state, job);
     } else {
-        m_jobs.push_back(job);
+        if (UNLIKELY(m_size == m_capacity)) {
+            grow();
+        }
+        m_buffer[(m_head + m_size) & (m_capacity - 1)] = job;
+        m_size++;
     }
     return 0;
 }
+
+void DefaultJobQueue::grow()
+{
+    size_t newCapacity = m_capacity ? m_capacity * 2 : ESCARGOT_JOB_QUEUE_INITIAL_CAPACITY;
+    Job** newBuffer = (Job**)GC_MALLOC(sizeof(Job*) * newCapacity);
+    for (size_t i = 0; i < m_size; i++) {
+        newBuffer[i] = m_buffer[(m_head + i) & (m_capacity - 1)];
+    }
+    if (m_buffer) {
+        GC_FREE(m_buffer);
+    }
+    m_buffer = newBuffer;
+    m_capacity = newCapacity;
+    m_head = 0;
+}
+
+void DefaultJobQueue::removeJobsOf(Context* context)
+{
+    size_t newSize = 0;
+    for (size_t i = 0; i < m_size; i++) {
+        size_t from = (m_head + i) & (m_capacity - 1);
+        Job* job = m_buffer[from];
+        m_buffer[from] = nullptr;
+        if (job->relatedContext() != context) {
+            m_buffer[(m_head + newSize) & (m_capacity - 1)] = job;
+            newSize++;
+        }
+    }
+    m_size = newSize;
+}
 }
 
 #endif
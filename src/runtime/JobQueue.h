@@ -37,9 +37,22 @@ public:
     virtual size_t enqueueJob(ExecutionState& state, Job* job) = 0;
 };
 
+#ifndef ESCARGOT_JOB_QUEUE_INITIAL_CAPACITY
+#define ESCARGOT_JOB_QUEUE_INITIAL_CAPACITY 16
+#endif
+
+// jobs are kept in a circular buffer which grows by doubling.
+// jobs are enqueued and drained only on the thread of VMInstance
 class DefaultJobQueue : public JobQueue {
 private:
-    DefaultJobQueue() {}
+    DefaultJobQueue()
+        : m_buffer(nullptr)
+        , m_capacity(0)
+        , m_head(0)
+        , m_size(0)
+    {
+    }
+
 public:
     static DefaultJobQueue* create()
     {
@@ -49,29 +62,45 @@ public:
     size_t enqueueJob(ExecutionState& state, Job* job);
     bool hasNextJob()
     {
-        return !m_jobs.empty();
+        return m_size;
     }
 
-    Job* nextJob()
+    size_t jobCount()
     {
-        ASSERT(!m_jobs.empty());
-        Job* job = m_jobs.front();
-        m_jobs.pop_front();
-        return job;
+        return m_size;
     }
 
-    std::list<Job*, gc_allocator<Job*>>& impl()
+    Job* peekJob()
     {
-        return m_jobs;
+        ASSERT(m_size);
+        return m_buffer[m_head];
     }
 
+    Job* nextJob()
+    {
+        ASSERT(m_size);
+        Job* job = m_buffer[m_head];
+        m_buffer[m_head] = nullptr;
+        m_head = (m_head + 1) & (m_capacity - 1);
+        m_size--;
+        return job;
+    }
+
+    // removes jobs of context keeping order of other jobs
+    void removeJobsOf(Context* context);
+
     static DefaultJobQueue* get(JobQueue* jobQueue)
     {
         return (DefaultJobQueue*)jobQueue;
     }
 
 private:
-    std::list<Job*, gc_allocator<Job*>> m_jobs;
+    void grow();
+
+    Job** m_buffer;
+    size_t m_capacity; // always power of 2
+    size_t m_head;
+    size_t m_size;
 };
 }
 #endif // ESCARGOT_ENABLE_PROMISE
@@ -26,6 +26,7 @@ namespace Escargot {
 
 MapObject::MapObject(ExecutionState& state)
     : Object(state)
+    , m_storage(new MapObjectData())
 {
     Object::setPrototype(state, state.context()->globalObject()->mapPrototype());
 }
@@ -48,85 +49,51 @@ void* MapObject::operator new(size_t size)
 
 void MapObject::clear(ExecutionState& state)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
-    }
+    m_storage->clear();
 }
 
 size_t MapObject::size(ExecutionState& state)
 {
-    size_t siz = 0;
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        siz++;
-    }
-    return siz;
+    return m_storage->size();
 }
 
 bool MapObject::deleteOperation(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
-            return true;
-        }
+    size_t position = m_storage->find(state, key);
+    if (position == SIZE_MAX) {
+        return false;
     }
-    return false;
+    m_storage->removeAt(position);
+    return true;
 }
 
 Value MapObject::get(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return m_storage[i].second;
-        }
+    size_t position = m_storage->find(state, key);
+    if (position == SIZE_MAX) {
+        return Value();
     }
-    return Value();
+    return m_storage->entryAt(position).second;
 }
 
 bool MapObject::has(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage->find(state, key) != SIZE_MAX;
 }
 
 void MapObject::set(ExecutionState& state, const Value& key, const Value& value)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i].second = value;
-            return;
-        }
+    size_t position = m_storage->find(state, key);
+    if (position != SIZE_MAX) {
+        m_storage->entryAt(position).second = value;
+        return;
     }
 
     // If key is -0, let key be +0.
     if (key.isNumber() && key.asNumber() == 0 && std::signbit(key.asNumber()) == true) {
-        m_storage.pushBack(std::make_pair(Value(0), value));
+        m_storage->append(std::make_pair(Value(0), value));
     } else {
-        m_storage.pushBack(std::make_pair(key, value));
+        m_storage->append(std::make_pair(key, value));
     }
 }
 
@@ -149,6 +116,7 @@ MapIteratorObject::MapIteratorObject(ExecutionState& state, MapObject* map, Type
     : IteratorObject(state)
     , m_map(map)
     , m_iteratorIndex(0)
+    , m_compaction(map->m_storage->currentCompaction())
     , m_type(type)
 {
     Object::setPrototype(state, state.context()->globalObject()->mapIteratorPrototype());
@@ -164,6 +132,7 @@ void* MapIteratorObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_values));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_map));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_compaction));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(MapIteratorObject));
         typeInited = true;
     }
@@ -186,17 +155,15 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
 
     // Let entries be the List that is the value of the [[MapData]] internal slot of m.
     // Repeat while index is less than the total number of elements of entries. The number of elements must be redetermined each time this method is evaluated.
-    while (index < m->m_storage.size()) {
+    // NOTE: [[MapData]] drops deleted entries while compacting, so index is translated to follow the compacted entries
+    if (m->m_storage->seekLiveEntry(index, m_compaction)) {
         // Let e be the Record {[[Key]], [[Value]]} that is the value of entries[index].
-        auto e = m->m_storage[index];
+        auto e = m->m_storage->entryAt(index);
         // Set index to index+1.
         index++;
         // Set the [[MapNextIndex]] internal slot of O to index.
         m_iteratorIndex = index;
 
-        if (e.first.isEmpty()) {
-            continue;
-        }
         // If e.[[Key]] is not empty, then
         // If itemKind is "key", let result be e.[[Key]].
         // Else if itemKind is "value", let result be e.[[Value]].
@@ -22,6 +22,7 @@
 
 #include "runtime/Object.h"
 #include "runtime/IteratorObject.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -31,7 +32,7 @@ class MapObject : public Object {
     friend class MapIteratorObject;
 
 public:
-    typedef TightVector<std::pair<SmallValue, SmallValue>, GCUtil::gc_malloc_ignore_off_page_allocator<std::pair<SmallValue, SmallValue>>> MapObjectData;
+    typedef OrderedHashTable<std::pair<SmallValue, SmallValue>> MapObjectData;
     explicit MapObject(ExecutionState& state);
 
     virtual bool isMapObject() const override
@@ -59,13 +60,13 @@ public:
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
-    const MapObjectData& storage()
+    MapObjectData& storage()
     {
-        return m_storage;
+        return *m_storage;
     }
 
 private:
-    MapObjectData m_storage;
+    MapObjectData* m_storage;
 };
 
 class MapIteratorObject : public IteratorObject {
@@ -93,6 +94,7 @@ public:
 private:
     MapObject* m_map;
     size_t m_iteratorIndex;
+    OrderedHashTableCompaction* m_compaction;
     Type m_type;
 };
 }
@@ -87,6 +87,7 @@ ObjectRareData::ObjectRareData(Object* obj)
     m_isInArrayObjectDefineOwnProperty = false;
     m_hasNonWritableLastIndexRegexpObject = false;
     m_extraData = nullptr;
+    m_arraySparseElements = nullptr;
 #ifdef ESCARGOT_ENABLE_PROMISE
     m_internalSlot = nullptr;
 #endif
@@ -100,6 +101,7 @@ void* ObjectRareData::operator new(size_t size)
         GC_word obj_bitmap[GC_BITMAP_SIZE(ObjectRareData)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_extraData));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_arraySparseElements));
 #ifdef ESCARGOT_ENABLE_PROMISE
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_internalSlot));
 #endif
@@ -500,7 +502,11 @@ ObjectGetResult Object::getOwnProperty(ExecutionState& state, const ObjectProper
                 return ObjectGetResult(m_values[idx], item.m_descriptor.isWritable(), item.m_descriptor.isEnumerable(), item.m_descriptor.isConfigurable());
             } else {
                 ObjectPropertyNativeGetterSetterData* data = item.m_descriptor.nativeGetterSetterData();
-                return ObjectGetResult(data->m_getter(state, this, m_values[idx]), item.m_descriptor.isWritable(), item.m_descriptor.isEnumerable(), item.m_descriptor.isConfigurable());
+                // getter can modify the structure of this object
+                bool isWritable = item.m_descriptor.isWritable();
+                bool isEnumerable = item.m_descriptor.isEnumerable();
+                bool isConfigurable = item.m_descriptor.isConfigurable();
+                return ObjectGetResult(data->m_getter(state, this, m_values[idx]), isWritable, isEnumerable, isConfigurable);
             }
         } else {
             Value v = m_values[idx];
@@ -50,6 +50,8 @@ struct ObjectRareData : public PointerValue {
     bool m_isInArrayObjectDefineOwnProperty : 1;
     bool m_hasNonWritableLastIndexRegexpObject : 1;
     void* m_extraData;
+    // ArraySparseElementMap of sparse mode ArrayObject
+    void* m_arraySparseElements;
     Object* m_prototype;
 #ifdef ESCARGOT_ENABLE_PROMISE
     Object* m_internalSlot;
@@ -521,7 +523,11 @@ class Object : public PointerValue {
     friend class VMInstance;
     friend class GlobalObject;
     friend class ByteCodeInterpreter;
+    friend class ContextSnapshot;
     friend struct ObjectRareData;
+    friend class JSONParser;
+    template <typename Buffer>
+    friend class JSONStringifier;
     static Object* createBuiltinObjectPrototype(ExecutionState& state);
 
 public:
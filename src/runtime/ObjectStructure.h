@@ -58,9 +58,16 @@ typedef Vector<ObjectStructureTransitionItem, GCUtil::gc_malloc_ignore_off_page_
 
 #define ESCARGOT_OBJECT_STRUCTURE_ACCESS_CACHE_BUILD_MIN_SIZE 96
 
+class EnumerateObjectKeys;
+class JSONStringifyKeys;
+
 class ObjectStructure : public gc {
     friend class Object;
     friend class ArrayObject;
+    friend class ContextSnapshot;
+    friend class ByteCodeInterpreter;
+    template <typename Buffer>
+    friend class JSONStringifier;
 
 public:
     ObjectStructure(ExecutionState&, bool needsTransitionTable = true)
@@ -68,6 +75,8 @@ public:
         , m_hasIndexPropertyName(false)
         , m_needsTransitionTable(needsTransitionTable)
         , m_isStructureWithFastAccess(false)
+        , m_enumerationCache(nullptr)
+        , m_jsonStringifyKeys(nullptr)
     {
     }
 
@@ -77,6 +86,8 @@ public:
         , m_needsTransitionTable(needsTransitionTable)
         , m_isStructureWithFastAccess(false)
         , m_properties(std::move(properties))
+        , m_enumerationCache(nullptr)
+        , m_jsonStringifyKeys(nullptr)
     {
     }
 
@@ -164,6 +175,10 @@ protected:
     bool m_isStructureWithFastAccess : 1;
     ObjectStructureItemVector m_properties;
     ObjectStructureTransitionTableVector m_transitionTable;
+    // keys of the last for-in over an object which has this structure
+    EnumerateObjectKeys* m_enumerationCache;
+    // quoted keys for JSON.stringify over objects which have this structure
+    JSONStringifyKeys* m_jsonStringifyKeys;
 
     size_t searchTransitionTable(const PropertyName& s, const ObjectStructurePropertyDescriptor& desc)
     {
@@ -327,6 +342,55 @@ inline ObjectStructure* ObjectStructure::convertToWithFastAccess(ExecutionState&
     ObjectStructureItemVector v = m_properties;
     return new ObjectStructureWithFastAccess(state, std::move(v), m_hasIndexPropertyName);
 }
+
+#define ESCARGOT_OBJECT_STRUCTURE_LOOKUP_CACHE_SIZE 256
+
+// (structure, property name) -> result of findProperty
+// shared by megamorphic property loads of a VMInstance. colliding entry is overwritten
+// entries keep structures and names alive, so cached addresses cannot be reused by others
+class ObjectStructureLookupCache {
+public:
+    ObjectStructureLookupCache()
+    {
+        clear();
+    }
+
+    size_t findProperty(ObjectStructure* structure, const PropertyName& name)
+    {
+        if (UNLIKELY(!name.hasAtomicString())) {
+            return structure->findProperty(name);
+        }
+
+        String* key = name.plainString();
+        Entry& entry = m_entries[(((size_t)structure >> 4) ^ ((size_t)key >> 4)) & (ESCARGOT_OBJECT_STRUCTURE_LOOKUP_CACHE_SIZE - 1)];
+        if (LIKELY(entry.m_structure == structure && entry.m_name == key)) {
+            return entry.m_index;
+        }
+
+        entry.m_structure = structure;
+        entry.m_name = key;
+        entry.m_index = structure->findProperty(name);
+        return entry.m_index;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < ESCARGOT_OBJECT_STRUCTURE_LOOKUP_CACHE_SIZE; i++) {
+            m_entries[i].m_structure = nullptr;
+            m_entries[i].m_name = nullptr;
+            m_entries[i].m_index = SIZE_MAX;
+        }
+    }
+
+private:
+    struct Entry {
+        ObjectStructure* m_structure;
+        String* m_name;
+        size_t m_index;
+    };
+
+    Entry m_entries[ESCARGOT_OBJECT_STRUCTURE_LOOKUP_CACHE_SIZE];
+};
 }
 
 namespace std {
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotOrderedHashTable__
+#define __EscargotOrderedHashTable__
+
+#include "runtime/SmallValue.h"
+
+namespace Escargot {
+
+// below this size, lookups scan the entries linearly and no hash index is kept
+#ifndef ESCARGOT_ORDERED_HASH_TABLE_INDEX_BUILD_MIN_SIZE
+#define ESCARGOT_ORDERED_HASH_TABLE_INDEX_BUILD_MIN_SIZE 8
+#endif
+
+#ifndef ESCARGOT_ORDERED_HASH_TABLE_COMPACTION_MIN_SIZE
+#define ESCARGOT_ORDERED_HASH_TABLE_COMPACTION_MIN_SIZE 32
+#endif
+
+typedef Vector<size_t, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<size_t>> OrderedHashTablePositionVector;
+
+// Positions removed by one compaction of an OrderedHashTable.
+// Cursors keep the record that was current when they were created,
+// and translate their position through every record completed since then.
+struct OrderedHashTableCompaction : public gc {
+    OrderedHashTableCompaction()
+        : m_next(nullptr)
+        , m_isCleared(false)
+    {
+    }
+
+    bool isCompleted() const
+    {
+        return m_next != nullptr;
+    }
+
+    size_t translate(size_t position) const
+    {
+        if (m_isCleared) {
+            return 0;
+        }
+        const size_t* begin = m_removedPositions.data();
+        const size_t* end = begin + m_removedPositions.size();
+        return position - (std::lower_bound(begin, end, position) - begin);
+    }
+
+    OrderedHashTablePositionVector m_removedPositions;
+    OrderedHashTableCompaction* m_next;
+    bool m_isCleared;
+};
+
+template <typename Entry>
+struct OrderedHashTableEntryTraits {
+};
+
+template <>
+struct OrderedHashTableEntryTraits<SmallValue> {
+    static const SmallValue& key(const SmallValue& e)
+    {
+        return e;
+    }
+
+    static void markAsDeleted(SmallValue& e)
+    {
+        e = Value(Value::EmptyValue);
+    }
+};
+
+template <>
+struct OrderedHashTableEntryTraits<std::pair<SmallValue, SmallValue>> {
+    static const SmallValue& key(const std::pair<SmallValue, SmallValue>& e)
+    {
+        return e.first;
+    }
+
+    static void markAsDeleted(std::pair<SmallValue, SmallValue>& e)
+    {
+        e = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
+    }
+};
+
+// Insertion-ordered hash table keyed by the SameValueZero algorithm.
+// It is the [[MapData]], [[SetData]] storage of Map, Set objects.
+// Deleted entries are left as empty keys so that positions stay stable for iterators,
+// and are dropped by compaction once they outnumber the live entries.
+template <typename Entry>
+class OrderedHashTable : public gc {
+public:
+    typedef OrderedHashTableEntryTraits<Entry> Traits;
+    typedef Vector<Entry, GCUtil::gc_malloc_ignore_off_page_allocator<Entry>> EntryVector;
+
+    OrderedHashTable()
+        : m_liveCount(0)
+        , m_compaction(nullptr)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_liveCount;
+    }
+
+    size_t positionEnd() const
+    {
+        return m_entries.size();
+    }
+
+    Entry& entryAt(size_t position)
+    {
+        return m_entries[position];
+    }
+
+    size_t find(ExecutionState& state, const Value& key)
+    {
+        if (m_buckets.size()) {
+            size_t position = m_buckets[hashKey(key) & (m_buckets.size() - 1)];
+            while (position) {
+                position--;
+                Value existingKey = Traits::key(m_entries[position]);
+                if (!existingKey.isEmpty() && existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
+                    return position;
+                }
+                position = m_chain[position];
+            }
+            return SIZE_MAX;
+        }
+
+        for (size_t i = 0; i < m_entries.size(); i++) {
+            Value existingKey = Traits::key(m_entries[i]);
+            if (!existingKey.isEmpty() && existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
+                return i;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    // caller should check the key is not in the table
+    void append(const Entry& e)
+    {
+        size_t position = m_entries.size();
+        m_entries.pushBack(e);
+        m_liveCount++;
+
+        if (m_buckets.size()) {
+            if (m_entries.size() > m_buckets.size()) {
+                m_hashes.pushBack(hashKey(Traits::key(e)));
+                rebuildIndex(m_buckets.size() * 2);
+            } else {
+                size_t hash = hashKey(Traits::key(e));
+                size_t& head = m_buckets[hash & (m_buckets.size() - 1)];
+                m_hashes.pushBack(hash);
+                m_chain.pushBack(head);
+                head = position + 1;
+            }
+        } else if (m_entries.size() >= ESCARGOT_ORDERED_HASH_TABLE_INDEX_BUILD_MIN_SIZE) {
+            m_hashes.resizeWithUninitializedValues(m_entries.size());
+            for (size_t i = 0; i < m_entries.size(); i++) {
+                Value existingKey = Traits::key(m_entries[i]);
+                m_hashes[i] = existingKey.isEmpty() ? 0 : hashKey(existingKey);
+            }
+            rebuildIndex(ESCARGOT_ORDERED_HASH_TABLE_INDEX_BUILD_MIN_SIZE * 2);
+        }
+    }
+
+    void removeAt(size_t position)
+    {
+        ASSERT(!Traits::key(m_entries[position]).isEmpty());
+        Traits::markAsDeleted(m_entries[position]);
+        m_liveCount--;
+
+        if (m_entries.size() >= ESCARGOT_ORDERED_HASH_TABLE_COMPACTION_MIN_SIZE && m_liveCount * 2 < m_entries.size()) {
+            compact();
+        }
+    }
+
+    void clear()
+    {
+        if (m_compaction) {
+            m_compaction->m_isCleared = true;
+            completeCompaction();
+        }
+
+        m_entries.clear();
+        m_hashes.clear();
+        m_chain.clear();
+        m_buckets.clear();
+        m_liveCount = 0;
+    }
+
+    // Returns the record that cursors created now should start from
+    OrderedHashTableCompaction* currentCompaction()
+    {
+        if (!m_compaction) {
+            m_compaction = new OrderedHashTableCompaction();
+        }
+        return m_compaction;
+    }
+
+    // Moves the cursor to the first live entry at or after its position.
+    // Returns false if there is no such entry
+    bool seekLiveEntry(size_t& position, OrderedHashTableCompaction*& compaction)
+    {
+        while (compaction->isCompleted()) {
+            position = compaction->translate(position);
+            compaction = compaction->m_next;
+        }
+
+        while (position < m_entries.size()) {
+            if (!Traits::key(m_entries[position]).isEmpty()) {
+                return true;
+            }
+            position++;
+        }
+        return false;
+    }
+
+    static size_t hashKey(const Value& key)
+    {
+        if (key.isInt32()) {
+            return mixHash((size_t)key.asInt32());
+        }
+
+        if (key.isNumber()) {
+            double d = key.asNumber();
+            if (std::isnan(d)) {
+                return 0;
+            }
+            // integral doubles should be hashed same as int32 values (this also covers -0)
+            if (d >= std::numeric_limits<int32_t>::min() && d <= std::numeric_limits<int32_t>::max() && d == (int32_t)d) {
+                return mixHash((size_t)(int32_t)d);
+            }
+            uint64_t bits = bitwise_cast<uint64_t>(d);
+            return mixHash((size_t)(bits ^ (bits >> 32)));
+        }
+
+        if (key.isPointerValue()) {
+            PointerValue* p = key.asPointerValue();
+            if (p->isString()) {
+                return p->asString()->hashValue();
+            }
+            return mixHash((size_t)p >> 3);
+        }
+
+        return mixHash((size_t)key.payload());
+    }
+
+private:
+    static size_t mixHash(size_t h)
+    {
+        h ^= h >> 16;
+        h *= 0x45d9f3b;
+        h ^= h >> 16;
+        return h;
+    }
+
+    void rebuildIndex(size_t bucketCount)
+    {
+        ASSERT(m_hashes.size() == m_entries.size());
+        m_buckets.clear();
+        m_buckets.resize(bucketCount, 0);
+        m_chain.resizeWithUninitializedValues(m_entries.size());
+
+        for (size_t i = 0; i < m_entries.size(); i++) {
+            if (Traits::key(m_entries[i]).isEmpty()) {
+                m_chain[i] = 0;
+                continue;
+            }
+            size_t& head = m_buckets[m_hashes[i] & (bucketCount - 1)];
+            m_chain[i] = head;
+            head = i + 1;
+        }
+    }
+
+    void compact()
+    {
+        size_t newSize = 0;
+        for (size_t i = 0; i < m_entries.size(); i++) {
+            if (Traits::key(m_entries[i]).isEmpty()) {
+                if (m_compaction) {
+                    m_compaction->m_removedPositions.pushBack(i);
+                }
+                continue;
+            }
+            if (newSize != i) {
+                m_entries[newSize] = m_entries[i];
+                if (m_buckets.size()) {
+                    m_hashes[newSize] = m_hashes[i];
+                }
+            }
+            newSize++;
+        }
+        ASSERT(newSize == m_liveCount);
+
+        m_entries.resizeWithUninitializedValues(newSize);
+        m_entries.shrinkToFit();
+
+        if (m_buckets.size()) {
+            m_hashes.resizeWithUninitializedValues(newSize);
+            m_hashes.shrinkToFit();
+            size_t bucketCount = ESCARGOT_ORDERED_HASH_TABLE_INDEX_BUILD_MIN_SIZE * 2;
+            while (bucketCount < newSize) {
+                bucketCount *= 2;
+            }
+            rebuildIndex(bucketCount);
+        }
+
+        if (m_compaction) {
+            completeCompaction();
+        }
+    }
+
+    void completeCompaction()
+    {
+        ASSERT(m_compaction && !m_compaction->isCompleted());
+        m_compaction->m_next = new OrderedHashTableCompaction();
+        m_compaction = m_compaction->m_next;
+    }
+
+    EntryVector m_entries;
+    // hash index over m_entries. every chain link and bucket head is (position + 1), 0 means the end of chain
+    OrderedHashTablePositionVector m_hashes;
+    OrderedHashTablePositionVector m_chain;
+    OrderedHashTablePositionVector m_buckets;
+    size_t m_liveCount;
+    OrderedHashTableCompaction* m_compaction;
+};
+}
+
+#endif
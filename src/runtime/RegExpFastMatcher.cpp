@@ -0,0 +1,929 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "RegExpFastMatcher.h"
+#include "RegExpPrefilter.h"
+
+namespace Escargot {
+
+static const uint32_t s_infinite = UINT_MAX;
+
+static ALWAYS_INLINE bool isLineTerminator(char16_t c)
+{
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+static ALWAYS_INLINE bool isWordChar(char16_t c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static bool isHexDigit(char16_t c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static unsigned hexValue(char16_t c)
+{
+    if (c <= '9') {
+        return c - '0';
+    }
+    return (c | 0x20) - 'a' + 10;
+}
+
+typedef std::vector<std::pair<char16_t, char16_t>> CharRanges;
+
+static const char16_t s_digitRanges[][2] = { { '0', '9' } };
+static const char16_t s_wordRanges[][2] = { { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' } };
+static const char16_t s_spaceRanges[][2] = { { 0x09, 0x0D }, { 0x20, 0x20 }, { 0xA0, 0xA0 }, { 0x1680, 0x1680 }, { 0x2000, 0x200A }, { 0x2028, 0x2029 }, { 0x202F, 0x202F }, { 0x205F, 0x205F }, { 0x3000, 0x3000 }, { 0xFEFF, 0xFEFF } };
+
+template <size_t N>
+static void addRanges(CharRanges& ranges, const char16_t (&set)[N][2], bool negated)
+{
+    if (!negated) {
+        for (size_t i = 0; i < N; i++) {
+            ranges.push_back(std::make_pair(set[i][0], set[i][1]));
+        }
+        return;
+    }
+    uint32_t next = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (set[i][0] > next) {
+            ranges.push_back(std::make_pair((char16_t)next, (char16_t)(set[i][0] - 1)));
+        }
+        next = set[i][1] + 1;
+    }
+    if (next <= 0xFFFF) {
+        ranges.push_back(std::make_pair((char16_t)next, (char16_t)0xFFFF));
+    }
+}
+
+class RegExpFastMatcherCompiler {
+public:
+    RegExpFastMatcherCompiler(String* source, bool multiline)
+        : m_source(source->bufferAccessData())
+        , m_index(0)
+        , m_captureCount(0)
+        , m_failed(false)
+        , m_matcher(new RegExpFastMatcher())
+    {
+        m_matcher->m_multiline = multiline;
+    }
+
+    RegExpFastMatcher* compile()
+    {
+        size_t root = parseDisjunction();
+        if (m_failed || !atEnd()) {
+            return nullptr;
+        }
+
+        m_matcher->m_subpatternCount = m_captureCount;
+        m_matcher->m_slotCount = (m_captureCount + 1) * 2;
+        emit(RegExpFastMatcher::Save, 0);
+        emitNode(root);
+        emit(RegExpFastMatcher::Save, 1);
+        emit(RegExpFastMatcher::Match);
+        if (m_failed) {
+            return nullptr;
+        }
+        return m_matcher;
+    }
+
+private:
+    struct Node {
+        enum Type {
+            Empty,
+            Char,
+            Any,
+            Class,
+            Assertion,
+            Group,
+            Alternation,
+            Sequence,
+            Repeat,
+        };
+
+        explicit Node(Type type, uint32_t value = 0)
+            : m_type(type)
+            , m_value(value)
+            , m_min(0)
+            , m_max(0)
+            , m_greedy(true)
+            , m_captureBegin(0)
+            , m_captureEnd(0)
+        {
+        }
+
+        Type m_type;
+        // character, class offset, opcode of assertion, or subpattern index of capturing group (0 for others)
+        uint32_t m_value;
+        uint32_t m_min;
+        uint32_t m_max;
+        bool m_greedy;
+        // subpatterns in child of Repeat are (m_captureBegin, m_captureEnd]
+        uint32_t m_captureBegin;
+        uint32_t m_captureEnd;
+        std::vector<size_t> m_children;
+    };
+
+    bool atEnd()
+    {
+        return m_index >= m_source.length;
+    }
+
+    char16_t peek(size_t offset = 0)
+    {
+        return m_index + offset < m_source.length ? m_source.charAt(m_index + offset) : 0;
+    }
+
+    size_t fail()
+    {
+        m_failed = true;
+        return 0;
+    }
+
+    size_t addNode(const Node& node)
+    {
+        m_nodes.push_back(node);
+        return m_nodes.size() - 1;
+    }
+
+    size_t parseDisjunction()
+    {
+        size_t first = parseAlternative();
+        if (m_failed || peek() != '|' || atEnd()) {
+            return first;
+        }
+        Node alternation(Node::Alternation);
+        alternation.m_children.push_back(first);
+        while (!atEnd() && peek() == '|') {
+            m_index++;
+            alternation.m_children.push_back(parseAlternative());
+            if (m_failed) {
+                return 0;
+            }
+        }
+        return addNode(alternation);
+    }
+
+    size_t parseAlternative()
+    {
+        Node sequence(Node::Sequence);
+        while (!atEnd() && peek() != '|' && peek() != ')') {
+            sequence.m_children.push_back(parseTerm());
+            if (m_failed) {
+                return 0;
+            }
+        }
+        if (sequence.m_children.size() == 1) {
+            return sequence.m_children[0];
+        }
+        return addNode(sequence);
+    }
+
+    size_t parseTerm()
+    {
+        uint32_t captureBegin = m_captureCount;
+        size_t atom;
+        bool isAssertion = false;
+        char16_t c = peek();
+        switch (c) {
+        case '^':
+            m_index++;
+            atom = addNode(Node(Node::Assertion, RegExpFastMatcher::AssertBOL));
+            isAssertion = true;
+            break;
+        case '$':
+            m_index++;
+            atom = addNode(Node(Node::Assertion, RegExpFastMatcher::AssertEOL));
+            isAssertion = true;
+            break;
+        case '\\':
+            if (peek(1) == 'b' || peek(1) == 'B') {
+                atom = addNode(Node(Node::Assertion, peek(1) == 'b' ? RegExpFastMatcher::AssertWordBoundary : RegExpFastMatcher::AssertNotWordBoundary));
+                m_index += 2;
+                isAssertion = true;
+            } else {
+                atom = parseAtomEscape();
+            }
+            break;
+        case '(': {
+            m_index++;
+            uint32_t subpattern = 0;
+            if (peek() == '?') {
+                if (peek(1) != ':') {
+                    // lookahead
+                    return fail();
+                }
+                m_index += 2;
+            } else {
+                subpattern = ++m_captureCount;
+            }
+            Node group(Node::Group, subpattern);
+            group.m_children.push_back(parseDisjunction());
+            if (m_failed || peek() != ')' || atEnd()) {
+                return fail();
+            }
+            m_index++;
+            atom = addNode(group);
+            break;
+        }
+        case '.':
+            m_index++;
+            atom = addNode(Node(Node::Any));
+            break;
+        case '[':
+            atom = parseClass();
+            break;
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        case '}':
+        case ']':
+            return fail();
+        default:
+            m_index++;
+            atom = addNode(Node(Node::Char, c));
+            break;
+        }
+        if (m_failed) {
+            return 0;
+        }
+
+        uint32_t min, max;
+        switch (peek()) {
+        case '*':
+            min = 0;
+            max = s_infinite;
+            break;
+        case '+':
+            min = 1;
+            max = s_infinite;
+            break;
+        case '?':
+            min = 0;
+            max = 1;
+            break;
+        case '{':
+            if (!parseBraceQuantifier(min, max)) {
+                return fail();
+            }
+            break;
+        default:
+            return atom;
+        }
+        if (atEnd() || isAssertion) {
+            return fail();
+        }
+        m_index++;
+
+        Node repeat(Node::Repeat);
+        repeat.m_children.push_back(atom);
+        repeat.m_min = min;
+        repeat.m_max = max;
+        if (peek() == '?' && !atEnd()) {
+            m_index++;
+            repeat.m_greedy = false;
+        }
+        repeat.m_captureBegin = captureBegin;
+        repeat.m_captureEnd = m_captureCount;
+        return addNode(repeat);
+    }
+
+    // leaves m_index at '}'
+    bool parseBraceQuantifier(uint32_t& min, uint32_t& max)
+    {
+        m_index++;
+        if (!parseDecimal(min)) {
+            return false;
+        }
+        max = min;
+        if (peek() == ',') {
+            m_index++;
+            max = s_infinite;
+            if (peek() != '}' && !parseDecimal(max)) {
+                return false;
+            }
+        }
+        return peek() == '}' && !atEnd() && min <= max;
+    }
+
+    bool parseDecimal(uint32_t& result)
+    {
+        if (atEnd() || peek() < '0' || peek() > '9') {
+            return false;
+        }
+        uint64_t value = 0;
+        while (!atEnd() && peek() >= '0' && peek() <= '9') {
+            value = std::min(value * 10 + (peek() - '0'), (uint64_t)s_infinite - 1);
+            m_index++;
+        }
+        result = value;
+        return true;
+    }
+
+    // parses escape after '\\' of a class or of an atom.
+    // returns a character, or -1 after adding a character class escape into ranges
+    int32_t parseEscape(CharRanges& ranges, bool inClass)
+    {
+        m_index++;
+        if (atEnd()) {
+            return fail();
+        }
+        char16_t c = peek();
+        m_index++;
+        switch (c) {
+        case 'd':
+        case 'D':
+            addRanges(ranges, s_digitRanges, c == 'D');
+            return -1;
+        case 'w':
+        case 'W':
+            addRanges(ranges, s_wordRanges, c == 'W');
+            return -1;
+        case 's':
+        case 'S':
+            addRanges(ranges, s_spaceRanges, c == 'S');
+            return -1;
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 't':
+            return '\t';
+        case 'v':
+            return '\v';
+        case 'f':
+            return '\f';
+        case 'b':
+            ASSERT(inClass);
+            return '\b';
+        case '0':
+            if (peek() >= '0' && peek() <= '9' && !atEnd()) {
+                return fail();
+            }
+            return 0;
+        case 'x':
+            if (m_index + 2 <= m_source.length && isHexDigit(peek()) && isHexDigit(peek(1))) {
+                char16_t result = hexValue(peek()) * 16 + hexValue(peek(1));
+                m_index += 2;
+                return result;
+            }
+            return fail();
+        case 'u':
+            if (m_index + 4 <= m_source.length && isHexDigit(peek()) && isHexDigit(peek(1)) && isHexDigit(peek(2)) && isHexDigit(peek(3))) {
+                char16_t result = (hexValue(peek()) << 12) | (hexValue(peek(1)) << 8) | (hexValue(peek(2)) << 4) | hexValue(peek(3));
+                m_index += 4;
+                return result;
+            }
+            return fail();
+        default:
+            // back references, control escapes and identity escapes of letters and digits
+            if (c < 128 && (isWordChar(c) && c != '_')) {
+                return fail();
+            }
+            return c;
+        }
+    }
+
+    size_t parseAtomEscape()
+    {
+        CharRanges ranges;
+        int32_t c = parseEscape(ranges, false);
+        if (m_failed) {
+            return 0;
+        }
+        if (c >= 0) {
+            return addNode(Node(Node::Char, c));
+        }
+        return addNode(Node(Node::Class, addClass(ranges, false)));
+    }
+
+    size_t parseClass()
+    {
+        m_index++;
+        bool negated = false;
+        if (peek() == '^' && !atEnd()) {
+            m_index++;
+            negated = true;
+        }
+
+        CharRanges ranges;
+        while (true) {
+            if (atEnd()) {
+                return fail();
+            }
+            if (peek() == ']') {
+                m_index++;
+                break;
+            }
+            int32_t from = parseClassAtom(ranges);
+            if (m_failed) {
+                return 0;
+            }
+            if (peek() == '-' && peek(1) != ']' && m_index + 1 < m_source.length) {
+                if (from < 0) {
+                    // Annex B: '-' after a class escape
+                    return fail();
+                }
+                m_index++;
+                int32_t to = parseClassAtom(ranges);
+                if (m_failed || to < from) {
+                    return fail();
+                }
+                ranges.push_back(std::make_pair((char16_t)from, (char16_t)to));
+            } else if (from >= 0) {
+                ranges.push_back(std::make_pair((char16_t)from, (char16_t)from));
+            }
+        }
+        return addNode(Node(Node::Class, addClass(ranges, negated)));
+    }
+
+    int32_t parseClassAtom(CharRanges& ranges)
+    {
+        char16_t c = peek();
+        if (c == '\\') {
+            if (peek(1) == '-') {
+                m_index += 2;
+                return '-';
+            }
+            return parseEscape(ranges, true);
+        }
+        m_index++;
+        return c;
+    }
+
+    uint32_t addClass(CharRanges& ranges, bool negated)
+    {
+        std::sort(ranges.begin(), ranges.end());
+        CharRanges merged;
+        for (size_t i = 0; i < ranges.size(); i++) {
+            if (merged.size() && (uint32_t)ranges[i].first <= (uint32_t)merged.back().second + 1) {
+                merged.back().second = std::max(merged.back().second, ranges[i].second);
+            } else {
+                merged.push_back(ranges[i]);
+            }
+        }
+
+        auto& data = m_matcher->m_classData;
+        uint32_t offset = data.size();
+        data.pushBack(negated);
+        data.pushBack(0);
+        for (size_t i = 0; i < 8; i++) {
+            data.pushBack(0);
+        }
+        uint32_t wideRangeCount = 0;
+        for (size_t i = 0; i < merged.size(); i++) {
+            uint32_t from = merged[i].first;
+            uint32_t to = merged[i].second;
+            for (uint32_t c = from; c <= std::min(to, (uint32_t)0xFF); c++) {
+                data[offset + 2 + (c >> 5)] |= 1u << (c & 31);
+            }
+            if (to > 0xFF) {
+                data.pushBack(std::max(from, (uint32_t)0x100));
+                data.pushBack(to);
+                wideRangeCount++;
+            }
+        }
+        data[offset + 1] = wideRangeCount;
+        return offset;
+    }
+
+    size_t emit(RegExpFastMatcher::OpCode op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0)
+    {
+        if (m_matcher->m_program.size() >= REGEXP_FAST_MATCHER_MAX_PROGRAM_SIZE) {
+            m_failed = true;
+            return 0;
+        }
+        RegExpFastMatcher::Instruction inst;
+        inst.m_op = op;
+        inst.m_a = a;
+        inst.m_b = b;
+        inst.m_c = c;
+        m_matcher->m_program.pushBack(inst);
+        return m_matcher->m_program.size() - 1;
+    }
+
+    size_t pc()
+    {
+        return m_matcher->m_program.size();
+    }
+
+    void emitNode(size_t index)
+    {
+        if (m_failed) {
+            return;
+        }
+        const Node& node = m_nodes[index];
+        switch (node.m_type) {
+        case Node::Empty:
+            break;
+        case Node::Char:
+            emit(RegExpFastMatcher::Char, node.m_value);
+            break;
+        case Node::Any:
+            emit(RegExpFastMatcher::Any);
+            break;
+        case Node::Class:
+            emit(RegExpFastMatcher::Class, node.m_value);
+            break;
+        case Node::Assertion:
+            emit((RegExpFastMatcher::OpCode)node.m_value);
+            break;
+        case Node::Group:
+            if (node.m_value) {
+                emit(RegExpFastMatcher::Save, node.m_value * 2);
+            }
+            emitNode(node.m_children[0]);
+            if (node.m_value) {
+                emit(RegExpFastMatcher::Save, node.m_value * 2 + 1);
+            }
+            break;
+        case Node::Sequence:
+            for (size_t i = 0; i < node.m_children.size(); i++) {
+                emitNode(node.m_children[i]);
+            }
+            break;
+        case Node::Alternation: {
+            std::vector<size_t> jumps;
+            for (size_t i = 0; i + 1 < node.m_children.size(); i++) {
+                size_t split = emit(RegExpFastMatcher::Split, pc() + 1);
+                emitNode(node.m_children[i]);
+                jumps.push_back(emit(RegExpFastMatcher::Jump));
+                if (m_failed) {
+                    return;
+                }
+                m_matcher->m_program[split].m_b = pc();
+            }
+            emitNode(node.m_children.back());
+            if (m_failed) {
+                return;
+            }
+            for (size_t i = 0; i < jumps.size(); i++) {
+                m_matcher->m_program[jumps[i]].m_a = pc();
+            }
+            break;
+        }
+        case Node::Repeat:
+            emitRepeat(node);
+            break;
+        }
+    }
+
+    void emitRepeat(const Node& node)
+    {
+        if (node.m_max == 0) {
+            return;
+        }
+        size_t child = node.m_children[0];
+        Node::Type childType = m_nodes[child].m_type;
+        if (childType == Node::Char || childType == Node::Any || childType == Node::Class) {
+            emit(RegExpFastMatcher::RepeatOne, node.m_min, node.m_max, node.m_greedy);
+            emitNode(child);
+            return;
+        }
+
+        // subpatterns in the child are reset at each iteration
+        bool hasCaptures = node.m_captureEnd > node.m_captureBegin;
+        uint32_t resetFrom = (node.m_captureBegin + 1) * 2;
+        uint32_t resetTo = (node.m_captureEnd + 1) * 2;
+        for (uint32_t i = 0; i < node.m_min; i++) {
+            if (hasCaptures) {
+                emit(RegExpFastMatcher::ResetSlots, resetFrom, resetTo);
+            }
+            emitNode(child);
+            if (m_failed) {
+                return;
+            }
+        }
+        if (node.m_min == node.m_max) {
+            return;
+        }
+
+        // iterations after min fail when they match empty string
+        uint32_t progressSlot = m_matcher->m_slotCount++;
+        auto emitOptionalIteration = [&]() -> size_t {
+            size_t split = emit(RegExpFastMatcher::Split);
+            emit(RegExpFastMatcher::Save, progressSlot);
+            if (hasCaptures) {
+                emit(RegExpFastMatcher::ResetSlots, resetFrom, resetTo);
+            }
+            emitNode(child);
+            emit(RegExpFastMatcher::CheckProgress, progressSlot);
+            return split;
+        };
+
+        if (node.m_max == s_infinite) {
+            size_t split = emitOptionalIteration();
+            emit(RegExpFastMatcher::Jump, split);
+            if (!m_failed) {
+                setSplitTargets(split, pc(), node.m_greedy);
+            }
+            return;
+        }
+
+        std::vector<size_t> splits;
+        for (uint32_t i = node.m_min; i < node.m_max && !m_failed; i++) {
+            splits.push_back(emitOptionalIteration());
+        }
+        if (m_failed) {
+            return;
+        }
+        for (size_t i = 0; i < splits.size(); i++) {
+            setSplitTargets(splits[i], pc(), node.m_greedy);
+        }
+    }
+
+    void setSplitTargets(size_t split, size_t exit, bool greedy)
+    {
+        RegExpFastMatcher::Instruction& inst = m_matcher->m_program[split];
+        inst.m_a = greedy ? split + 1 : exit;
+        inst.m_b = greedy ? exit : split + 1;
+    }
+
+    StringBufferAccessData m_source;
+    size_t m_index;
+    uint32_t m_captureCount;
+    bool m_failed;
+    std::vector<Node> m_nodes;
+    RegExpFastMatcher* m_matcher;
+};
+
+void* RegExpFastMatcher::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(RegExpFastMatcher)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpFastMatcher, m_program));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpFastMatcher, m_classData));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(RegExpFastMatcher));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
+RegExpFastMatcher* RegExpFastMatcher::compile(String* source, bool ignoreCase, bool multiline)
+{
+    if (ignoreCase) {
+        return nullptr;
+    }
+    return RegExpFastMatcherCompiler(source, multiline).compile();
+}
+
+bool RegExpFastMatcher::classContains(uint32_t offset, char16_t c) const
+{
+    const uint32_t* data = m_classData.data() + offset;
+    bool contains;
+    if (c <= 0xFF) {
+        contains = data[2 + (c >> 5)] & (1u << (c & 31));
+    } else {
+        // binary search on sorted ranges
+        const uint32_t* ranges = data + 10;
+        size_t low = 0;
+        size_t high = data[1];
+        contains = false;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (c < ranges[mid * 2]) {
+                high = mid;
+            } else if (c > ranges[mid * 2 + 1]) {
+                low = mid + 1;
+            } else {
+                contains = true;
+                break;
+            }
+        }
+    }
+    return contains != (bool)data[0];
+}
+
+ALWAYS_INLINE bool RegExpFastMatcher::matchesOne(const Instruction& inst, char16_t c) const
+{
+    switch (inst.m_op) {
+    case Char:
+        return c == inst.m_a;
+    case Any:
+        return !isLineTerminator(c);
+    default:
+        ASSERT(inst.m_op == Class);
+        return classContains(inst.m_a, c);
+    }
+}
+
+namespace {
+
+struct BacktrackEntry {
+    enum Kind : uint32_t {
+        // resume at m_pc with m_index
+        Choice,
+        // RepeatOne consumed up to m_index. retry continuation (m_pc) with one less, down to m_count
+        GreedyRepeat,
+        // RepeatOne consumed m_count times up to m_index. retry continuation (m_pc) with one more, up to m_limit
+        LazyRepeat,
+    };
+
+    uint32_t m_pc;
+    uint32_t m_index;
+    uint32_t m_slotLogSize;
+    Kind m_kind;
+    uint32_t m_count;
+    uint32_t m_limit;
+};
+
+// old values of slots, to restore them on backtracking
+struct SlotLogEntry {
+    uint32_t m_slot;
+    uint32_t m_value;
+};
+}
+
+template <typename CharType>
+bool RegExpFastMatcher::run(const CharType* input, unsigned length, unsigned index, unsigned* slots)
+{
+    std::vector<BacktrackEntry> backtrack;
+    std::vector<SlotLogEntry> slotLog;
+    const Instruction* program = m_program.data();
+    uint32_t pc = 0;
+
+    while (true) {
+        const Instruction& inst = program[pc];
+        bool ok = true;
+        switch (inst.m_op) {
+        case Char:
+            ok = index < length && input[index] == inst.m_a;
+            index++;
+            pc++;
+            break;
+        case Any:
+            ok = index < length && !isLineTerminator(input[index]);
+            index++;
+            pc++;
+            break;
+        case Class:
+            ok = index < length && classContains(inst.m_a, input[index]);
+            index++;
+            pc++;
+            break;
+        case RepeatOne: {
+            const Instruction& atom = program[pc + 1];
+            uint32_t min = inst.m_a;
+            uint32_t max = inst.m_b;
+            uint32_t limit = std::min(max, length - index);
+            uint32_t count = 0;
+            if (inst.m_c) {
+                while (count < limit && matchesOne(atom, input[index + count])) {
+                    count++;
+                }
+                ok = count >= min;
+                if (ok && count > min) {
+                    backtrack.push_back({ pc + 2, index + count, (uint32_t)slotLog.size(), BacktrackEntry::GreedyRepeat, index + min, 0 });
+                }
+            } else {
+                while (count < min && count < limit && matchesOne(atom, input[index + count])) {
+                    count++;
+                }
+                ok = count == min;
+                if (ok && count < max) {
+                    backtrack.push_back({ pc + 2, index + count, (uint32_t)slotLog.size(), BacktrackEntry::LazyRepeat, count, max });
+                }
+            }
+            index += count;
+            pc += 2;
+            break;
+        }
+        case Split:
+            backtrack.push_back({ inst.m_b, index, (uint32_t)slotLog.size(), BacktrackEntry::Choice, 0, 0 });
+            pc = inst.m_a;
+            break;
+        case Jump:
+            pc = inst.m_a;
+            break;
+        case Save:
+            slotLog.push_back({ inst.m_a, slots[inst.m_a] });
+            slots[inst.m_a] = index;
+            pc++;
+            break;
+        case ResetSlots:
+            for (uint32_t i = inst.m_a; i < inst.m_b; i++) {
+                if (slots[i] != UINT_MAX) {
+                    slotLog.push_back({ i, slots[i] });
+                    slots[i] = UINT_MAX;
+                }
+            }
+            pc++;
+            break;
+        case CheckProgress:
+            ok = slots[inst.m_a] != index;
+            pc++;
+            break;
+        case AssertBOL:
+            ok = index == 0 || (m_multiline && isLineTerminator(input[index - 1]));
+            pc++;
+            break;
+        case AssertEOL:
+            ok = index == length || (m_multiline && isLineTerminator(input[index]));
+            pc++;
+            break;
+        case AssertWordBoundary:
+        case AssertNotWordBoundary: {
+            bool before = index > 0 && isWordChar(input[index - 1]);
+            bool after = index < length && isWordChar(input[index]);
+            ok = (before != after) == (inst.m_op == AssertWordBoundary);
+            pc++;
+            break;
+        }
+        case Match:
+            return true;
+        }
+
+        if (LIKELY(ok)) {
+            continue;
+        }
+
+        while (true) {
+            size_t logSize = backtrack.empty() ? 0 : backtrack.back().m_slotLogSize;
+            while (slotLog.size() > logSize) {
+                slots[slotLog.back().m_slot] = slotLog.back().m_value;
+                slotLog.pop_back();
+            }
+            if (backtrack.empty()) {
+                return false;
+            }
+
+            BacktrackEntry& entry = backtrack.back();
+            if (entry.m_kind == BacktrackEntry::Choice) {
+                pc = entry.m_pc;
+                index = entry.m_index;
+                backtrack.pop_back();
+                break;
+            } else if (entry.m_kind == BacktrackEntry::GreedyRepeat) {
+                pc = entry.m_pc;
+                index = --entry.m_index;
+                if (entry.m_index == entry.m_count) {
+                    backtrack.pop_back();
+                }
+                break;
+            } else {
+                const Instruction& atom = program[entry.m_pc - 1];
+                if (entry.m_count < entry.m_limit && entry.m_index < length && matchesOne(atom, input[entry.m_index])) {
+                    pc = entry.m_pc;
+                    index = ++entry.m_index;
+                    if (++entry.m_count == entry.m_limit) {
+                        backtrack.pop_back();
+                    }
+                    break;
+                }
+                backtrack.pop_back();
+            }
+        }
+    }
+}
+
+template <typename CharType>
+unsigned RegExpFastMatcher::matchImpl(const CharType* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter)
+{
+    std::vector<unsigned> slots(m_slotCount, UINT_MAX);
+    for (size_t index = start; index <= length; index++) {
+        if (prefilter) {
+            index = prefilter->findCandidate(input, length, index);
+            if (index == SIZE_MAX) {
+                break;
+            }
+        }
+        if (run(input, length, index, slots.data())) {
+            memcpy(output, slots.data(), sizeof(unsigned) * 2 * (m_subpatternCount + 1));
+            return index;
+        }
+    }
+    return NoMatch;
+}
+
+unsigned RegExpFastMatcher::match(const LChar* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter)
+{
+    return matchImpl(input, length, start, output, prefilter);
+}
+
+unsigned RegExpFastMatcher::match(const char16_t* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter)
+{
+    return matchImpl(input, length, start, output, prefilter);
+}
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotRegExpFastMatcher__
+#define __EscargotRegExpFastMatcher__
+
+#include "runtime/String.h"
+#include "util/Vector.h"
+
+namespace Escargot {
+
+class RegExpPrefilter;
+
+// patterns which need more instructions than this are left to Yarr
+#ifndef REGEXP_FAST_MATCHER_MAX_PROGRAM_SIZE
+#define REGEXP_FAST_MATCHER_MAX_PROGRAM_SIZE 4096
+#endif
+
+// Matcher for the common subset of patterns, compiled from the source of a pattern into a small program
+// which is run by a backtracking machine specialized for 8-bit and 16-bit input.
+// It supports characters, character classes, '.', greedy and lazy quantifiers, alternation, groups and anchors.
+// Repetition of a single character is run without a backtracking entry per character.
+// Start positions are skipped with RegExpPrefilter when it is given.
+// Patterns with ignoreCase, back references, lookahead or unusual Annex B syntax are not compiled,
+// and they are run by the Yarr interpreter
+class RegExpFastMatcher : public gc {
+public:
+    static const unsigned NoMatch = UINT_MAX;
+
+    // returns nullptr if pattern is not supported
+    static RegExpFastMatcher* compile(String* source, bool ignoreCase, bool multiline);
+
+    unsigned subpatternCount() const
+    {
+        return m_subpatternCount;
+    }
+
+    // same as JSC::Yarr::interpret. searches from start, and returns index of the match or NoMatch.
+    // output is filled with (start, end) of the match and of each subpattern, UINT_MAX for unmatched subpatterns
+    unsigned match(const LChar* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter = nullptr);
+    unsigned match(const char16_t* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter = nullptr);
+
+    enum OpCode : uint8_t {
+        Char,
+        Any,
+        Class,
+        // repeats following Char, Any or Class instruction (a = min, b = max, c = greedy)
+        RepeatOne,
+        // tries a, then b
+        Split,
+        Jump,
+        // slot[a] = index
+        Save,
+        // slot[a...b) = UINT_MAX
+        ResetSlots,
+        // fails if slot[a] == index. used to stop a loop over an empty match
+        CheckProgress,
+        AssertBOL,
+        AssertEOL,
+        AssertWordBoundary,
+        AssertNotWordBoundary,
+        Match,
+    };
+
+    struct Instruction {
+        OpCode m_op;
+        uint32_t m_a;
+        uint32_t m_b;
+        uint32_t m_c;
+    };
+
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+
+private:
+    friend class RegExpFastMatcherCompiler;
+
+    RegExpFastMatcher()
+        : m_subpatternCount(0)
+        , m_slotCount(0)
+        , m_multiline(false)
+    {
+    }
+
+    template <typename CharType>
+    unsigned matchImpl(const CharType* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter);
+    template <typename CharType>
+    bool run(const CharType* input, unsigned length, unsigned index, unsigned* slots);
+    bool matchesOne(const Instruction& inst, char16_t c) const;
+    bool classContains(uint32_t classOffset, char16_t c) const;
+
+    Vector<Instruction, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<Instruction>> m_program;
+    // each class is [isNegated, rangeCount, 256-bit bitmap of 8-bit characters, ranges above 0xFF...]
+    Vector<uint32_t, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<uint32_t>> m_classData;
+    unsigned m_subpatternCount;
+    // subpattern slots, then slots for CheckProgress
+    unsigned m_slotCount;
+    bool m_multiline;
+};
+}
+
+#endif
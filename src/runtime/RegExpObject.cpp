@@ -21,6 +21,8 @@
 #include "RegExpObject.h"
 #include "Context.h"
 #include "ArrayObject.h"
+#include "RegExpFastMatcher.h"
+#include "RegExpPrefilter.h"
 
 #include "Yarr.h"
 
@@ -33,6 +35,8 @@ RegExpObject::RegExpObject(ExecutionState& state, String* source, String* option
     , m_option(None)
     , m_yarrPattern(NULL)
     , m_bytecodePattern(NULL)
+    , m_fastMatcher(NULL)
+    , m_prefilter(NULL)
     , m_lastIndex(Value(0))
     , m_lastExecutedString(NULL)
 {
@@ -47,6 +51,8 @@ RegExpObject::RegExpObject(ExecutionState& state, String* source, unsigned int o
     , m_option(None)
     , m_yarrPattern(NULL)
     , m_bytecodePattern(NULL)
+    , m_fastMatcher(NULL)
+    , m_prefilter(NULL)
     , m_lastIndex(Value(0))
     , m_lastExecutedString(NULL)
 {
@@ -61,6 +67,8 @@ RegExpObject::RegExpObject(ExecutionState& state)
     , m_option(None)
     , m_yarrPattern(NULL)
     , m_bytecodePattern(NULL)
+    , m_fastMatcher(NULL)
+    , m_prefilter(NULL)
     , m_lastIndex(Value(0))
     , m_lastExecutedString(NULL)
 {
@@ -89,6 +97,8 @@ void* RegExpObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_optionString));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_yarrPattern));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_bytecodePattern));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_fastMatcher));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_prefilter));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_lastIndex));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_lastExecutedString));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(RegExpObject));
@@ -169,6 +179,8 @@ void RegExpObject::internalInit(ExecutionState& state, String* source)
 
     m_yarrPattern = entry.m_yarrPattern;
     m_bytecodePattern = entry.m_bytecodePattern;
+    m_fastMatcher = entry.m_fastMatcher;
+    m_prefilter = entry.m_prefilter;
 }
 
 void RegExpObject::init(ExecutionState& state, String* source, String* option)
@@ -257,6 +269,8 @@ void RegExpObject::setOption(const Option& option)
         || ((m_option & Option::IgnoreCase) != (option & Option::IgnoreCase))) {
         ASSERT(!m_yarrPattern);
         m_bytecodePattern = NULL;
+        m_fastMatcher = NULL;
+        m_prefilter = NULL;
     }
     m_option = option;
 }
@@ -264,14 +278,10 @@ void RegExpObject::setOption(const Option& option)
 RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(ExecutionState& state, String* source, const Option& option)
 {
     auto cache = state.context()->regexpCache();
-    auto it = cache->find(RegExpCacheKey(source, option));
-    if (it != cache->end()) {
-        return it->second;
+    RegExpCacheEntry* cached = cache->find(RegExpCacheKey(source, option));
+    if (cached) {
+        return *cached;
     } else {
-        if (cache->size() > 256) {
-            cache->clear();
-        }
-
         const char* yarrError = nullptr;
         JSC::Yarr::YarrPattern* yarrPattern = nullptr;
         try {
@@ -279,7 +289,7 @@ RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(Ex
         } catch (const std::bad_alloc& e) {
             ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "got too complicated RegExp pattern to process");
         }
-        return cache->insert(std::make_pair(RegExpCacheKey(source, option), RegExpCacheEntry(yarrError, yarrPattern))).first->second;
+        return cache->insert(RegExpCacheKey(source, option), RegExpCacheEntry(yarrError, yarrPattern));
     }
 }
 
@@ -314,10 +324,15 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
             JSC::Yarr::OwnPtr<JSC::Yarr::BytecodePattern> ownedBytecode = JSC::Yarr::byteCompile(*m_yarrPattern, bumpAlloc);
             m_bytecodePattern = ownedBytecode.leakPtr();
             entry.m_bytecodePattern = m_bytecodePattern;
+            entry.m_fastMatcher = RegExpFastMatcher::compile(m_source, m_option & Option::IgnoreCase, m_option & Option::MultiLine);
+            entry.m_prefilter = RegExpPrefilter::analyze(m_source, m_option & Option::IgnoreCase, m_option & Option::MultiLine);
         }
+        m_fastMatcher = entry.m_fastMatcher;
+        m_prefilter = entry.m_prefilter;
     }
 
     unsigned subPatternNum = m_bytecodePattern->m_body->m_numSubpatterns;
+    ASSERT(!m_fastMatcher || m_fastMatcher->subpatternCount() == subPatternNum);
     matchResult.m_subPatternNum = (int)subPatternNum;
     size_t length = str->length();
     size_t start = startIndex;
@@ -333,10 +348,31 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
         if (start > length) {
             break;
         }
-        if (LIKELY(str->has8BitContent()))
-            result = JSC::Yarr::interpret(m_bytecodePattern, str->characters8(), length, start, outputBuf);
-        else
-            result = JSC::Yarr::interpret(m_bytecodePattern, (const UChar*)str->characters16(), length, start, outputBuf);
+        if (m_fastMatcher) {
+            if (LIKELY(str->has8BitContent()))
+                result = m_fastMatcher->match(str->characters8(), length, start, outputBuf, m_prefilter);
+            else
+                result = m_fastMatcher->match(str->characters16(), length, start, outputBuf, m_prefilter);
+            if (result == RegExpFastMatcher::NoMatch) {
+                result = JSC::Yarr::offsetNoMatch;
+            }
+        } else {
+            if (m_prefilter) {
+                // Yarr tries every position after this by itself
+                size_t candidate = LIKELY(str->has8BitContent()) ? m_prefilter->findCandidate(str->characters8(), length, start) : m_prefilter->findCandidate(str->characters16(), length, start);
+                if (candidate == SIZE_MAX) {
+                    if (start) {
+                        reachToEnd = true;
+                    }
+                    break;
+                }
+                start = candidate;
+            }
+            if (LIKELY(str->has8BitContent()))
+                result = JSC::Yarr::interpret(m_bytecodePattern, str->characters8(), length, start, outputBuf);
+            else
+                result = JSC::Yarr::interpret(m_bytecodePattern, (const UChar*)str->characters16(), length, start, outputBuf);
+        }
 
         if (result != JSC::Yarr::offsetNoMatch) {
             gotResult = true;
@@ -502,4 +538,75 @@ void RegExpObject::pushBackToRegExpMatchedArray(ExecutionState& state, ArrayObje
         }
     }
 }
+
+RegExpCache::RegExpCache()
+    : m_maxEntryCount(REGEXP_CACHE_MAX_ENTRY_COUNT)
+    , m_maxEstimatedBytes(REGEXP_CACHE_MAX_ESTIMATED_BYTES)
+    , m_estimatedBytes(0)
+    , m_hitCount(0)
+    , m_missCount(0)
+    , m_evictionCount(0)
+{
+}
+
+RegExpObject::RegExpCacheEntry* RegExpCache::find(const RegExpObject::RegExpCacheKey& key)
+{
+    auto it = m_itemMap.find(key);
+    if (it == m_itemMap.end()) {
+        m_missCount++;
+        return nullptr;
+    }
+    m_hitCount++;
+    if (it->second != m_items.begin()) {
+        m_items.splice(m_items.begin(), m_items, it->second);
+    }
+    return &it->second->m_entry;
+}
+
+RegExpObject::RegExpCacheEntry& RegExpCache::insert(const RegExpObject::RegExpCacheKey& key, const RegExpObject::RegExpCacheEntry& entry)
+{
+    ASSERT(m_itemMap.find(key) == m_itemMap.end());
+    size_t estimatedBytes = sizeof(Item) + (key.m_body->length() + 1) * REGEXP_CACHE_ESTIMATED_BYTES_PER_SOURCE_CHARACTER;
+    m_items.emplace_front(key, entry, estimatedBytes);
+    m_itemMap.insert(std::make_pair(key, m_items.begin()));
+    m_estimatedBytes += estimatedBytes;
+    evictIfNeeded();
+    return m_items.front().m_entry;
+}
+
+void RegExpCache::evictIfNeeded()
+{
+    while (m_items.size() > 1 && (m_items.size() > m_maxEntryCount || m_estimatedBytes > m_maxEstimatedBytes)) {
+        Item& last = m_items.back();
+        m_estimatedBytes -= last.m_estimatedBytes;
+        m_itemMap.erase(last.m_key);
+        m_items.pop_back();
+        m_evictionCount++;
+    }
+}
+
+void RegExpCache::clear()
+{
+    m_itemMap.clear();
+    m_items.clear();
+    m_estimatedBytes = 0;
+}
+
+void RegExpCache::setLimit(size_t maxEntryCount, size_t maxEstimatedBytes)
+{
+    m_maxEntryCount = maxEntryCount;
+    m_maxEstimatedBytes = maxEstimatedBytes;
+    evictIfNeeded();
+}
+
+RegExpCache::Statistics RegExpCache::statistics() const
+{
+    Statistics result;
+    result.m_entryCount = m_items.size();
+    result.m_estimatedBytes = m_estimatedBytes;
+    result.m_hitCount = m_hitCount;
+    result.m_missCount = m_missCount;
+    result.m_evictionCount = m_evictionCount;
+    return result;
+}
 }
@@ -32,6 +32,9 @@ struct BytecodePattern;
 
 namespace Escargot {
 
+class RegExpFastMatcher;
+class RegExpPrefilter;
+
 struct RegexMatchResult {
     struct RegexMatchResultPiece {
         unsigned m_start, m_end;
@@ -65,7 +68,7 @@ public:
 
         bool operator==(const RegExpCacheKey& otherKey) const
         {
-            return (m_body == otherKey.m_body) && (m_multiline == otherKey.m_multiline) && (m_ignoreCase == otherKey.m_ignoreCase);
+            return (m_multiline == otherKey.m_multiline) && (m_ignoreCase == otherKey.m_ignoreCase) && (m_body == otherKey.m_body || m_body->equals(otherKey.m_body));
         }
         const String* m_body;
         const bool m_multiline : 1;
@@ -77,12 +80,18 @@ public:
             : m_yarrError(yarrError)
             , m_yarrPattern(yarrPattern)
             , m_bytecodePattern(bytecodePattern)
+            , m_fastMatcher(nullptr)
+            , m_prefilter(nullptr)
         {
         }
 
         const char* m_yarrError;
         JSC::Yarr::YarrPattern* m_yarrPattern;
         JSC::Yarr::BytecodePattern* m_bytecodePattern;
+        // compiled with m_bytecodePattern. nullptr if the pattern is not supported by RegExpFastMatcher
+        RegExpFastMatcher* m_fastMatcher;
+        // compiled with m_bytecodePattern. nullptr if nothing is known about where a match starts
+        RegExpPrefilter* m_prefilter;
     };
 
     explicit RegExpObject(ExecutionState& state);
@@ -176,15 +185,12 @@ private:
     Option m_option;
     JSC::Yarr::YarrPattern* m_yarrPattern;
     JSC::Yarr::BytecodePattern* m_bytecodePattern;
+    RegExpFastMatcher* m_fastMatcher;
+    RegExpPrefilter* m_prefilter;
 
     SmallValue m_lastIndex;
     const String* m_lastExecutedString;
 };
-
-typedef std::unordered_map<RegExpObject::RegExpCacheKey, RegExpObject::RegExpCacheEntry,
-                           std::hash<RegExpObject::RegExpCacheKey>, std::equal_to<RegExpObject::RegExpCacheKey>,
-                           gc_allocator<std::pair<const RegExpObject::RegExpCacheKey, RegExpObject::RegExpCacheEntry>>>
-    RegExpCacheMap;
 }
 
 namespace std {
@@ -206,4 +212,65 @@ struct equal_to<Escargot::RegExpObject::RegExpCacheKey> {
 };
 }
 
+namespace Escargot {
+
+// Compiled patterns shared by RegExp objects which have same source and flags.
+// Least recently used entries are dropped when there are more than maxEntryCount entries
+// or their estimated size is larger than maxEstimatedBytes. The most recently used entry is always kept.
+// The limits cap the cache only. Memory of a dropped pattern is not released by dropping it,
+// because its Yarr bytecode is allocated from the BumpPointerAllocator of Context
+class RegExpCache {
+public:
+    struct Statistics {
+        size_t m_entryCount;
+        size_t m_estimatedBytes; // sum of estimates of entries, not memory in use
+        size_t m_hitCount;
+        size_t m_missCount;
+        size_t m_evictionCount;
+    };
+
+    RegExpCache();
+
+    // returns nullptr if there is no entry for key
+    RegExpObject::RegExpCacheEntry* find(const RegExpObject::RegExpCacheKey& key);
+    RegExpObject::RegExpCacheEntry& insert(const RegExpObject::RegExpCacheKey& key, const RegExpObject::RegExpCacheEntry& entry);
+    void clear();
+
+    void setLimit(size_t maxEntryCount, size_t maxEstimatedBytes);
+    Statistics statistics() const;
+
+private:
+    struct Item {
+        Item(const RegExpObject::RegExpCacheKey& key, const RegExpObject::RegExpCacheEntry& entry, size_t estimatedBytes)
+            : m_key(key)
+            , m_entry(entry)
+            , m_estimatedBytes(estimatedBytes)
+        {
+        }
+
+        RegExpObject::RegExpCacheKey m_key;
+        RegExpObject::RegExpCacheEntry m_entry;
+        size_t m_estimatedBytes;
+    };
+
+    // most recently used item first
+    typedef std::list<Item, gc_allocator<Item>> ItemList;
+    typedef std::unordered_map<RegExpObject::RegExpCacheKey, ItemList::iterator,
+                               std::hash<RegExpObject::RegExpCacheKey>, std::equal_to<RegExpObject::RegExpCacheKey>,
+                               gc_allocator<std::pair<const RegExpObject::RegExpCacheKey, ItemList::iterator>>>
+        ItemMap;
+
+    void evictIfNeeded();
+
+    ItemList m_items;
+    ItemMap m_itemMap;
+    size_t m_maxEntryCount;
+    size_t m_maxEstimatedBytes;
+    size_t m_estimatedBytes;
+    size_t m_hitCount;
+    size_t m_missCount;
+    size_t m_evictionCount;
+};
+}
+
 #endif
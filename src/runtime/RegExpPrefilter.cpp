@@ -0,0 +1,680 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "RegExpPrefilter.h"
+#include "StringSearch.h"
+
+namespace Escargot {
+
+static ALWAYS_INLINE bool isLineTerminator(char16_t c)
+{
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+static bool isHexDigit(char16_t c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static unsigned hexValue(char16_t c)
+{
+    if (c <= '9') {
+        return c - '0';
+    }
+    return (c | 0x20) - 'a' + 10;
+}
+
+static bool isASCIIAlpha(char16_t c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// Scans a pattern validated by Yarr. Each term is reduced to the set of characters it can start with,
+// and whether it can match empty string. Anything not understood makes the set contain every character
+class RegExpPrefilterAnalyzer {
+public:
+    RegExpPrefilterAnalyzer(String* source, bool ignoreCase)
+        : m_source(source->bufferAccessData())
+        , m_index(0)
+        , m_ignoreCase(ignoreCase)
+        , m_failed(false)
+        , m_topLevelAlternativeCount(0)
+        , m_startsWithBOL(false)
+    {
+    }
+
+    RegExpPrefilter* analyze(bool multiline)
+    {
+        FirstChars first = parseDisjunction(true);
+        if (m_failed || !atEnd()) {
+            return nullptr;
+        }
+
+        RegExpPrefilter* prefilter = new RegExpPrefilter();
+        bool hasInformation = false;
+        if (m_topLevelAlternativeCount == 1 && m_startsWithBOL) {
+            prefilter->m_anchoredAtStart = !multiline;
+            prefilter->m_anchoredAtLineStart = multiline;
+            hasInformation = true;
+        }
+        if (m_topLevelAlternativeCount == 1 && m_literalPrefix.size()) {
+            if (isAllLatin1(m_literalPrefix.data(), m_literalPrefix.size())) {
+                prefilter->m_literalPrefix = new Latin1String(m_literalPrefix.data(), m_literalPrefix.size());
+            } else {
+                prefilter->m_literalPrefix = new UTF16String(m_literalPrefix.data(), m_literalPrefix.size());
+            }
+            hasInformation = true;
+        } else if (!first.m_nullable && !first.m_set.isAll()) {
+            prefilter->m_hasFirstCharSet = true;
+            prefilter->m_firstCharMayBeWide = first.m_set.m_wide;
+            memcpy(prefilter->m_firstCharBitmap, first.m_set.m_bitmap, sizeof(first.m_set.m_bitmap));
+            prefilter->m_singleFirstChar = first.m_set.singleChar();
+            hasInformation = true;
+        }
+        return hasInformation ? prefilter : nullptr;
+    }
+
+private:
+    struct CharSet {
+        CharSet()
+            : m_wide(false)
+        {
+            memset(m_bitmap, 0, sizeof(m_bitmap));
+        }
+
+        void add(char16_t c)
+        {
+            if (c <= 0xFF) {
+                m_bitmap[c >> 5] |= 1u << (c & 31);
+            } else {
+                m_wide = true;
+            }
+        }
+
+        void addRange(char16_t from, char16_t to)
+        {
+            for (uint32_t c = from; c <= std::min((uint32_t)to, (uint32_t)0xFF); c++) {
+                add(c);
+            }
+            if (to > 0xFF) {
+                m_wide = true;
+            }
+        }
+
+        void addAll()
+        {
+            memset(m_bitmap, 0xFF, sizeof(m_bitmap));
+            m_wide = true;
+        }
+
+        void merge(const CharSet& other)
+        {
+            for (size_t i = 0; i < 8; i++) {
+                m_bitmap[i] |= other.m_bitmap[i];
+            }
+            m_wide |= other.m_wide;
+        }
+
+        // every wide character is assumed to be in a set which has one,
+        // so complement of a set keeps wide characters
+        void invert()
+        {
+            for (size_t i = 0; i < 8; i++) {
+                m_bitmap[i] = ~m_bitmap[i];
+            }
+            m_wide = true;
+        }
+
+        bool isAll() const
+        {
+            for (size_t i = 0; i < 8; i++) {
+                if (m_bitmap[i] != UINT32_MAX) {
+                    return false;
+                }
+            }
+            return m_wide;
+        }
+
+        int32_t singleChar() const
+        {
+            if (m_wide) {
+                return -1;
+            }
+            int32_t result = -1;
+            for (uint32_t i = 0; i < 8; i++) {
+                if (!m_bitmap[i]) {
+                    continue;
+                }
+                if (result >= 0 || (m_bitmap[i] & (m_bitmap[i] - 1))) {
+                    return -1;
+                }
+                result = i * 32 + __builtin_ctz(m_bitmap[i]);
+            }
+            return result;
+        }
+
+        uint32_t m_bitmap[8];
+        bool m_wide;
+    };
+
+    struct FirstChars {
+        FirstChars()
+            : m_nullable(true)
+        {
+        }
+
+        CharSet m_set;
+        bool m_nullable;
+    };
+
+    struct Term {
+        Term()
+            : m_char(-1)
+            , m_min(1)
+            , m_quantified(false)
+            , m_isAssertion(false)
+            , m_isBOL(false)
+        {
+        }
+
+        FirstChars m_first;
+        // the character if the atom is a literal character
+        int32_t m_char;
+        uint32_t m_min;
+        bool m_quantified;
+        bool m_isAssertion;
+        bool m_isBOL;
+    };
+
+    bool atEnd()
+    {
+        return m_index >= m_source.length;
+    }
+
+    char16_t peek(size_t offset = 0)
+    {
+        return m_index + offset < m_source.length ? m_source.charAt(m_index + offset) : 0;
+    }
+
+    bool isDigit(size_t offset = 0)
+    {
+        return m_index + offset < m_source.length && peek(offset) >= '0' && peek(offset) <= '9';
+    }
+
+    // with ignoreCase, only ASCII characters are folded. other characters give up the set.
+    // wide characters like U+212A KELVIN SIGN may be folded into ASCII letters too
+    void addChar(CharSet& set, char16_t c)
+    {
+        if (!m_ignoreCase) {
+            set.add(c);
+        } else if (c >= 0x80) {
+            set.addAll();
+        } else {
+            set.add(c);
+            if (isASCIIAlpha(c)) {
+                set.add(c ^ 0x20);
+                set.m_wide = true;
+            }
+        }
+    }
+
+    void addRange(CharSet& set, char16_t from, char16_t to)
+    {
+        if (!m_ignoreCase) {
+            set.addRange(from, to);
+        } else if (to >= 0x80) {
+            set.addAll();
+        } else {
+            for (char16_t c = from; c <= to; c++) {
+                addChar(set, c);
+            }
+        }
+    }
+
+    FirstChars parseDisjunction(bool topLevel)
+    {
+        FirstChars result = parseAlternative(topLevel);
+        size_t alternativeCount = 1;
+        while (!m_failed && !atEnd() && peek() == '|') {
+            m_index++;
+            FirstChars alternative = parseAlternative(false);
+            result.m_set.merge(alternative.m_set);
+            result.m_nullable |= alternative.m_nullable;
+            alternativeCount++;
+        }
+        if (topLevel) {
+            m_topLevelAlternativeCount = alternativeCount;
+        }
+        return result;
+    }
+
+    FirstChars parseAlternative(bool topLevel)
+    {
+        FirstChars result;
+        bool collectingPrefix = topLevel && !m_ignoreCase;
+        bool isFirstTerm = true;
+        while (!m_failed && !atEnd() && peek() != '|' && peek() != ')') {
+            Term term = parseTerm();
+            if (topLevel && isFirstTerm) {
+                m_startsWithBOL = term.m_isBOL;
+            }
+            isFirstTerm = false;
+
+            if (collectingPrefix) {
+                if (term.m_isAssertion && m_literalPrefix.empty()) {
+                    // assertions before the literal do not consume characters
+                } else if (term.m_char >= 0 && term.m_min) {
+                    m_literalPrefix.push_back(term.m_char);
+                    collectingPrefix = !term.m_quantified;
+                } else {
+                    collectingPrefix = false;
+                }
+            }
+            if (result.m_nullable) {
+                result.m_set.merge(term.m_first.m_set);
+                result.m_nullable = term.m_first.m_nullable;
+            }
+        }
+        return result;
+    }
+
+    Term parseTerm()
+    {
+        Term term;
+        char16_t c = peek();
+        m_index++;
+        switch (c) {
+        case '^':
+            term.m_isAssertion = true;
+            term.m_isBOL = true;
+            break;
+        case '$':
+            term.m_isAssertion = true;
+            break;
+        case '(':
+            if (peek() == '?' && (peek(1) == '=' || peek(1) == '!')) {
+                m_index += 2;
+                parseDisjunction(false);
+                term.m_isAssertion = true;
+            } else {
+                if (peek() == '?') {
+                    if (peek(1) != ':') {
+                        m_failed = true;
+                        return term;
+                    }
+                    m_index += 2;
+                }
+                term.m_first = parseDisjunction(false);
+            }
+            if (m_failed || atEnd() || peek() != ')') {
+                m_failed = true;
+                return term;
+            }
+            m_index++;
+            break;
+        case '[':
+            parseClass(term.m_first.m_set);
+            term.m_first.m_nullable = false;
+            break;
+        case '.':
+            term.m_first.m_set.addAll();
+            term.m_first.m_nullable = false;
+            break;
+        case '\\':
+            if (peek() == 'b' || peek() == 'B') {
+                m_index++;
+                term.m_isAssertion = true;
+            } else {
+                parseAtomEscape(term);
+            }
+            break;
+        case '*':
+        case '+':
+        case '?':
+            m_failed = true;
+            return term;
+        default:
+            // including '{', '}' and ']' which are literal when they are not a quantifier in Annex B
+            term.m_char = c;
+            addChar(term.m_first.m_set, c);
+            term.m_first.m_nullable = false;
+            break;
+        }
+
+        if (m_failed || !parseQuantifier(term.m_min)) {
+            return term;
+        }
+        if (peek() == '?' && !atEnd()) {
+            m_index++;
+        }
+        term.m_quantified = true;
+        term.m_first.m_nullable |= !term.m_min;
+        if (term.m_isAssertion) {
+            // quantified lookahead
+            term.m_char = -1;
+        }
+        return term;
+    }
+
+    bool parseQuantifier(uint32_t& min)
+    {
+        if (atEnd()) {
+            return false;
+        }
+        switch (peek()) {
+        case '*':
+        case '?':
+            m_index++;
+            min = 0;
+            return true;
+        case '+':
+            m_index++;
+            return true;
+        case '{': {
+            size_t i = 1;
+            if (!isDigit(i)) {
+                return false;
+            }
+            uint32_t value = 0;
+            while (isDigit(i)) {
+                value = std::min(value * 10 + (peek(i) - '0'), (uint32_t)100000);
+                i++;
+            }
+            if (peek(i) == ',' && m_index + i < m_source.length) {
+                i++;
+                while (isDigit(i)) {
+                    i++;
+                }
+            }
+            if (peek(i) != '}' || m_index + i >= m_source.length) {
+                return false;
+            }
+            m_index += i + 1;
+            min = value;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    // parses after '\\'. back references and octal escapes may match anything
+    void parseAtomEscape(Term& term)
+    {
+        term.m_first.m_nullable = false;
+        if (atEnd()) {
+            m_failed = true;
+            return;
+        }
+        if (peek() >= '1' && peek() <= '9') {
+            while (isDigit()) {
+                m_index++;
+            }
+            term.m_first.m_set.addAll();
+            term.m_first.m_nullable = true;
+            return;
+        }
+        if (peek() == 'k') {
+            m_index++;
+            term.m_first.m_set.addAll();
+            term.m_first.m_nullable = true;
+            return;
+        }
+        int32_t c = parseCharacterEscape(term.m_first.m_set);
+        if (c >= 0) {
+            term.m_char = c;
+            addChar(term.m_first.m_set, c);
+        }
+    }
+
+    // parses after '\\' and returns a character, or -1 after adding a character class escape into the set
+    int32_t parseCharacterEscape(CharSet& set)
+    {
+        char16_t c = peek();
+        m_index++;
+        switch (c) {
+        case 'd':
+        case 'D':
+        case 'w':
+        case 'W':
+        case 's':
+        case 'S': {
+            CharSet escape;
+            if (c == 'd' || c == 'D') {
+                escape.addRange('0', '9');
+            } else if (c == 'w' || c == 'W') {
+                escape.addRange('0', '9');
+                escape.addRange('A', 'Z');
+                escape.addRange('a', 'z');
+                escape.add('_');
+            } else {
+                escape.addRange(0x09, 0x0D);
+                escape.add(0x20);
+                escape.add(0xA0);
+                escape.m_wide = true;
+            }
+            if (c == 'D' || c == 'W' || c == 'S') {
+                escape.invert();
+            }
+            set.merge(escape);
+            return -1;
+        }
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 't':
+            return '\t';
+        case 'v':
+            return '\v';
+        case 'f':
+            return '\f';
+        case 'x':
+            if (isHexDigit(peek()) && isHexDigit(peek(1)) && m_index + 2 <= m_source.length) {
+                char16_t result = hexValue(peek()) * 16 + hexValue(peek(1));
+                m_index += 2;
+                return result;
+            }
+            return 'x';
+        case 'u':
+            if (isHexDigit(peek()) && isHexDigit(peek(1)) && isHexDigit(peek(2)) && isHexDigit(peek(3)) && m_index + 4 <= m_source.length) {
+                char16_t result = (hexValue(peek()) << 12) | (hexValue(peek(1)) << 8) | (hexValue(peek(2)) << 4) | hexValue(peek(3));
+                m_index += 4;
+                return result;
+            }
+            return 'u';
+        case '0':
+            if (!isDigit()) {
+                return 0;
+            }
+        // fall through
+        case 'c':
+            // octal and control escapes have several Annex B forms
+            while (isDigit()) {
+                m_index++;
+            }
+            set.addAll();
+            return -1;
+        default:
+            return c;
+        }
+    }
+
+    void parseClass(CharSet& set)
+    {
+        bool negated = false;
+        if (peek() == '^' && !atEnd()) {
+            m_index++;
+            negated = true;
+        }
+
+        CharSet members;
+        bool unknown = false;
+        while (true) {
+            if (atEnd()) {
+                m_failed = true;
+                return;
+            }
+            if (peek() == ']') {
+                m_index++;
+                break;
+            }
+            CharSet escapeSet;
+            int32_t from = parseClassAtom(escapeSet);
+            if (from < 0) {
+                // class escape or an escape this scan does not know in a class
+                unknown |= escapeSet.isAll();
+                members.merge(escapeSet);
+                continue;
+            }
+            if (peek() == '-' && peek(1) != ']' && m_index + 1 < m_source.length) {
+                m_index++;
+                int32_t to = parseClassAtom(escapeSet);
+                if (to < 0) {
+                    // Annex B: '-' between a class escape and something
+                    unknown |= escapeSet.isAll();
+                    members.merge(escapeSet);
+                    addChar(members, from);
+                    addChar(members, '-');
+                } else if (from <= to) {
+                    addRange(members, from, to);
+                }
+            } else {
+                addChar(members, from);
+            }
+        }
+
+        if (unknown || (m_ignoreCase && members.isAll())) {
+            set.addAll();
+            return;
+        }
+        if (negated) {
+            members.invert();
+        }
+        set.merge(members);
+    }
+
+    int32_t parseClassAtom(CharSet& set)
+    {
+        char16_t c = peek();
+        m_index++;
+        if (c != '\\') {
+            return c;
+        }
+        if (atEnd()) {
+            m_failed = true;
+            return -1;
+        }
+        if (peek() == 'b') {
+            m_index++;
+            return '\b';
+        }
+        if (peek() == '-') {
+            m_index++;
+            return '-';
+        }
+        if (isDigit()) {
+            while (isDigit()) {
+                m_index++;
+            }
+            set.addAll();
+            return -1;
+        }
+        return parseCharacterEscape(set);
+    }
+
+    StringBufferAccessData m_source;
+    size_t m_index;
+    bool m_ignoreCase;
+    bool m_failed;
+    size_t m_topLevelAlternativeCount;
+    bool m_startsWithBOL;
+    std::vector<char16_t> m_literalPrefix;
+};
+
+void* RegExpPrefilter::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(RegExpPrefilter)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpPrefilter, m_literalPrefix));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(RegExpPrefilter));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
+RegExpPrefilter* RegExpPrefilter::analyze(String* source, bool ignoreCase, bool multiline)
+{
+    return RegExpPrefilterAnalyzer(source, ignoreCase).analyze(multiline);
+}
+
+template <typename CharType>
+size_t RegExpPrefilter::findCandidateImpl(const CharType* input, size_t length, size_t start) const
+{
+    if (m_anchoredAtStart) {
+        return start == 0 ? 0 : SIZE_MAX;
+    }
+
+    StringBufferAccessData inputData;
+    inputData.has8BitContent = sizeof(CharType) == 1;
+    inputData.hasSpecialImpl = false;
+    inputData.hash = 0;
+    inputData.length = length;
+    inputData.buffer = input;
+
+    while (start <= length) {
+        if (m_literalPrefix) {
+            start = StringSearch::find(inputData, m_literalPrefix->bufferAccessData(), start);
+        } else if (m_singleFirstChar >= 0) {
+            start = StringSearch::findChar(inputData, m_singleFirstChar, start);
+        } else if (m_hasFirstCharSet) {
+            while (start < length && !firstCharMayBe(input[start])) {
+                start++;
+            }
+            if (start == length) {
+                return SIZE_MAX;
+            }
+        }
+
+        if (start == SIZE_MAX || !m_anchoredAtLineStart || start == 0 || isLineTerminator(input[start - 1])) {
+            return start;
+        }
+        start++;
+        if (!m_literalPrefix && !m_hasFirstCharSet) {
+            while (start <= length && !isLineTerminator(input[start - 1])) {
+                start++;
+            }
+        }
+    }
+    return SIZE_MAX;
+}
+
+size_t RegExpPrefilter::findCandidate(const LChar* input, size_t length, size_t start) const
+{
+    return findCandidateImpl(input, length, start);
+}
+
+size_t RegExpPrefilter::findCandidate(const char16_t* input, size_t length, size_t start) const
+{
+    return findCandidateImpl(input, length, start);
+}
+}
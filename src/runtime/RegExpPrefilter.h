@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotRegExpPrefilter__
+#define __EscargotRegExpPrefilter__
+
+#include "runtime/String.h"
+
+namespace Escargot {
+
+// What is known about where a match of a pattern can start, found by scanning the source of the pattern:
+// a literal every match starts with, a set of characters every match starts with, and ^ anchoring.
+// Matchers skip to candidate positions with StringSearch instead of trying every position
+class RegExpPrefilter : public gc {
+public:
+    // returns nullptr if nothing is known. source should be a valid pattern
+    static RegExpPrefilter* analyze(String* source, bool ignoreCase, bool multiline);
+
+    // first index in [start, length] where a match can start, or SIZE_MAX
+    size_t findCandidate(const LChar* input, size_t length, size_t start) const;
+    size_t findCandidate(const char16_t* input, size_t length, size_t start) const;
+
+    String* literalPrefix() const
+    {
+        return m_literalPrefix;
+    }
+
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+
+private:
+    friend class RegExpPrefilterAnalyzer;
+
+    RegExpPrefilter()
+        : m_literalPrefix(nullptr)
+        , m_anchoredAtStart(false)
+        , m_anchoredAtLineStart(false)
+        , m_hasFirstCharSet(false)
+        , m_firstCharMayBeWide(false)
+        , m_singleFirstChar(-1)
+    {
+        memset(m_firstCharBitmap, 0, sizeof(m_firstCharBitmap));
+    }
+
+    template <typename CharType>
+    size_t findCandidateImpl(const CharType* input, size_t length, size_t start) const;
+
+    ALWAYS_INLINE bool firstCharMayBe(char16_t c) const
+    {
+        if (c <= 0xFF) {
+            return m_firstCharBitmap[c >> 5] & (1u << (c & 31));
+        }
+        return m_firstCharMayBeWide;
+    }
+
+    String* m_literalPrefix;
+    // every match starts at 0 (^ without multiline)
+    bool m_anchoredAtStart;
+    // every match starts at a line start (^ with multiline)
+    bool m_anchoredAtLineStart;
+    bool m_hasFirstCharSet;
+    bool m_firstCharMayBeWide;
+    // the only member of first character set, or -1
+    int32_t m_singleFirstChar;
+    uint32_t m_firstCharBitmap[8];
+};
+}
+
+#endif
@@ -26,6 +26,7 @@ namespace Escargot {
 
 SetObject::SetObject(ExecutionState& state)
     : Object(state)
+    , m_storage(new SetObjectData())
 {
     Object::setPrototype(state, state.context()->globalObject()->setPrototype());
 }
@@ -48,71 +49,41 @@ void* SetObject::operator new(size_t size)
 
 void SetObject::clear(ExecutionState& state)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        m_storage[i] = Value(Value::EmptyValue);
-    }
+    m_storage->clear();
 }
 
 bool SetObject::deleteOperation(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i] = Value(Value::EmptyValue);
-            return true;
-        }
+    size_t position = m_storage->find(state, key);
+    if (position == SIZE_MAX) {
+        return false;
     }
-    return false;
+    m_storage->removeAt(position);
+    return true;
 }
 
 void SetObject::add(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return;
-        }
+    if (m_storage->find(state, key) != SIZE_MAX) {
+        return;
     }
 
     // If key is -0, let key be +0.
     if (key.isNumber() && key.asNumber() == 0 && std::signbit(key.asNumber()) == true) {
-        m_storage.pushBack(Value(0));
+        m_storage->append(Value(0));
     } else {
-        m_storage.pushBack(key);
+        m_storage->append(key);
     }
 }
 
 bool SetObject::has(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage->find(state, key) != SIZE_MAX;
 }
 
 size_t SetObject::size(ExecutionState& state)
 {
-    size_t siz = 0;
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        siz++;
-    }
-    return siz;
+    return m_storage->size();
 }
 
 SetIteratorObject* SetObject::values(ExecutionState& state)
@@ -134,6 +105,7 @@ SetIteratorObject::SetIteratorObject(ExecutionState& state, SetObject* set, Type
     : IteratorObject(state)
     , m_set(set)
     , m_iteratorIndex(0)
+    , m_compaction(set->m_storage->currentCompaction())
     , m_type(type)
 {
     Object::setPrototype(state, state.context()->globalObject()->setIteratorPrototype());
@@ -149,6 +121,7 @@ void* SetIteratorObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_values));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_set));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_compaction));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(SetIteratorObject));
         typeInited = true;
     }
@@ -171,18 +144,15 @@ std::pair<Value, bool> SetIteratorObject::advance(ExecutionState& state)
 
     // Let entries be the List that is the value of the [[SetData]] internal slot of s.
     // Repeat while index is less than the total number of elements of entries. The number of elements must be redetermined each time this method is evaluated.
-    while (index < s->m_storage.size()) {
+    // NOTE: [[SetData]] drops deleted entries while compacting, so index is translated to follow the compacted entries
+    if (s->m_storage->seekLiveEntry(index, m_compaction)) {
         // Let e be entries[index].
-        Value e = s->m_storage[index];
+        Value e = s->m_storage->entryAt(index);
         // Set index to index+1.
         index++;
         // Set the [[SetNextIndex]] internal slot of O to index.
         m_iteratorIndex = index;
 
-        if (e.isEmpty()) {
-            continue;
-        }
-
         Value result;
         if (itemKind == Type::TypeKeyValue) {
             ArrayObject* arr = new ArrayObject(state);
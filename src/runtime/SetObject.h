@@ -22,6 +22,7 @@
 
 #include "runtime/Object.h"
 #include "runtime/IteratorObject.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -31,7 +32,7 @@ class SetObject : public Object {
     friend class SetIteratorObject;
 
 public:
-    typedef TightVector<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>> SetObjectData;
+    typedef OrderedHashTable<SmallValue> SetObjectData;
     explicit SetObject(ExecutionState& state);
 
     virtual bool isSetObject() const override
@@ -58,13 +59,13 @@ public:
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
-    const SetObjectData& storage()
+    SetObjectData& storage()
     {
-        return m_storage;
+        return *m_storage;
     }
 
 private:
-    SetObjectData m_storage;
+    SetObjectData* m_storage;
 };
 
 class SetIteratorObject : public IteratorObject {
@@ -92,6 +93,7 @@ public:
 private:
     SetObject* m_set;
     size_t m_iteratorIndex;
+    OrderedHashTableCompaction* m_compaction;
     Type m_type;
 };
 }
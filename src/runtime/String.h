@@ -68,6 +68,9 @@ class StringView;
 struct StringBufferAccessData {
     bool has8BitContent;
     bool hasSpecialImpl;
+    // cached result of String::hashValue. 0 means not computed yet
+    // (on 64-bit, this fits into the padding after the flags)
+    uint32_t hash;
     size_t length;
     const void* buffer;
 
@@ -156,6 +159,7 @@ public:
     {
         m_tag = POINTER_VALUE_STRING_SYMBOL_TAG_IN_DATA;
         m_bufferAccessData.hasSpecialImpl = false;
+        m_bufferAccessData.hash = 0;
     }
 
     virtual bool isString() const
@@ -233,24 +237,15 @@ public:
         return hash;
     }
 
-    size_t hashValue() const
+    // string contents never change, so the hash is computed once and kept in m_bufferAccessData.
+    // rope strings get the hash of their flattened string along with its buffer
+    ALWAYS_INLINE size_t hashValue() const
     {
         const auto& data = bufferAccessData();
-        size_t len = data.length;
-        size_t hash;
-        if (LIKELY(data.has8BitContent)) {
-            auto ptr = (const LChar*)data.buffer;
-            hash = stringHash(ptr, len);
-        } else {
-            auto ptr = (const char16_t*)data.buffer;
-            hash = stringHash(ptr, len);
+        if (LIKELY(data.hash)) {
+            return data.hash;
         }
-
-        if (UNLIKELY((hash % sizeof(size_t)) == 0)) {
-            hash++;
-        }
-
-        return hash;
+        return computeHashValue();
     }
 
     bool operator==(const String& src) const
@@ -305,6 +300,29 @@ private:
     size_t m_tag;
 
 protected:
+    size_t computeHashValue() const
+    {
+        const auto& data = m_bufferAccessData;
+        size_t len = data.length;
+        size_t hash;
+        if (LIKELY(data.has8BitContent)) {
+            auto ptr = (const LChar*)data.buffer;
+            hash = stringHash(ptr, len);
+        } else {
+            auto ptr = (const char16_t*)data.buffer;
+            hash = stringHash(ptr, len);
+        }
+
+        if (UNLIKELY((hash % sizeof(size_t)) == 0)) {
+            hash++;
+        }
+
+        // low bits are kept, so the truncated hash is never 0
+        uint32_t truncatedHash = (uint32_t)hash;
+        const_cast<String*>(this)->m_bufferAccessData.hash = truncatedHash;
+        return truncatedHash;
+    }
+
     StringBufferAccessData m_bufferAccessData;
     static int stringCompare(size_t l1, size_t l2, const String* c1, const String* c2);
 
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "StringSearch.h"
+
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define STRING_SEARCH_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define STRING_SEARCH_USE_NEON
+#endif
+#endif
+
+namespace Escargot {
+
+template <typename A, typename B>
+static ALWAYS_INLINE bool charsEqual(const A* a, const B* b, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename A>
+static ALWAYS_INLINE bool charsEqual(const A* a, const A* b, size_t length)
+{
+    return memcmp(a, b, sizeof(A) * length) == 0;
+}
+
+template <typename CharType>
+static ALWAYS_INLINE bool fitsIn(char16_t ch)
+{
+    return sizeof(CharType) == 2 || ch <= 0xFF;
+}
+
+#if defined(STRING_SEARCH_USE_SSE2) || defined(STRING_SEARCH_USE_NEON)
+#define STRING_SEARCH_USE_SIMD
+
+// match(a, b) returns a mask of lanes i where a[i] == first && b[i] == last.
+// each lane takes bitsPerLane bits of the mask
+template <typename CharType>
+struct SIMDCandidateFilter;
+
+#if defined(STRING_SEARCH_USE_SSE2)
+template <>
+struct SIMDCandidateFilter<LChar> {
+    static const size_t laneCount = 16;
+    static const size_t bitsPerLane = 1;
+
+    SIMDCandidateFilter(LChar first, LChar last)
+        : m_first(_mm_set1_epi8((char)first))
+        , m_last(_mm_set1_epi8((char)last))
+    {
+    }
+
+    ALWAYS_INLINE uint64_t match(const LChar* a, const LChar* b) const
+    {
+        __m128i eqFirst = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)a), m_first);
+        __m128i eqLast = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)b), m_last);
+        return (uint32_t)_mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast));
+    }
+
+    __m128i m_first;
+    __m128i m_last;
+};
+
+template <>
+struct SIMDCandidateFilter<char16_t> {
+    static const size_t laneCount = 8;
+    static const size_t bitsPerLane = 1;
+
+    SIMDCandidateFilter(char16_t first, char16_t last)
+        : m_first(_mm_set1_epi16((short)first))
+        , m_last(_mm_set1_epi16((short)last))
+    {
+    }
+
+    ALWAYS_INLINE uint64_t match(const char16_t* a, const char16_t* b) const
+    {
+        __m128i eqFirst = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)a), m_first);
+        __m128i eqLast = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)b), m_last);
+        // narrow 16-bit lanes into bytes so movemask gives a bit per lane
+        return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(_mm_and_si128(eqFirst, eqLast), _mm_setzero_si128()));
+    }
+
+    __m128i m_first;
+    __m128i m_last;
+};
+#else
+template <>
+struct SIMDCandidateFilter<LChar> {
+    static const size_t laneCount = 16;
+    static const size_t bitsPerLane = 4;
+
+    SIMDCandidateFilter(LChar first, LChar last)
+        : m_first(vdupq_n_u8(first))
+        , m_last(vdupq_n_u8(last))
+    {
+    }
+
+    ALWAYS_INLINE uint64_t match(const LChar* a, const LChar* b) const
+    {
+        uint8x16_t eq = vandq_u8(vceqq_u8(vld1q_u8(a), m_first), vceqq_u8(vld1q_u8(b), m_last));
+        // shift-right-narrow leaves 4 bits per lane
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+    }
+
+    uint8x16_t m_first;
+    uint8x16_t m_last;
+};
+
+template <>
+struct SIMDCandidateFilter<char16_t> {
+    static const size_t laneCount = 8;
+    static const size_t bitsPerLane = 8;
+
+    SIMDCandidateFilter(char16_t first, char16_t last)
+        : m_first(vdupq_n_u16(first))
+        , m_last(vdupq_n_u16(last))
+    {
+    }
+
+    ALWAYS_INLINE uint64_t match(const char16_t* a, const char16_t* b) const
+    {
+        uint16x8_t eq = vandq_u16(vceqq_u16(vld1q_u16((const uint16_t*)a), m_first), vceqq_u16(vld1q_u16((const uint16_t*)b), m_last));
+        return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(eq)), 0);
+    }
+
+    uint16x8_t m_first;
+    uint16x8_t m_last;
+};
+#endif
+
+template <typename Filter>
+static ALWAYS_INLINE uint64_t clearLane(uint64_t mask, size_t lane)
+{
+    const uint64_t laneBits = (1ULL << Filter::bitsPerLane) - 1;
+    return mask & ~(laneBits << (lane * Filter::bitsPerLane));
+}
+#endif
+
+// shift table is indexed by the low byte of characters.
+// colliding characters keep the smaller shift, which never skips a match
+template <typename HaystackChar, typename NeedleChar>
+static size_t horspoolFind(const HaystackChar* haystack, size_t haystackLength, const NeedleChar* needle, size_t needleLength, size_t pos)
+{
+    size_t shift[256];
+    for (size_t i = 0; i < 256; i++) {
+        shift[i] = needleLength;
+    }
+    for (size_t i = 0; i + 1 < needleLength; i++) {
+        shift[needle[i] & 0xFF] = needleLength - 1 - i;
+    }
+
+    const NeedleChar last = needle[needleLength - 1];
+    while (pos + needleLength <= haystackLength) {
+        HaystackChar c = haystack[pos + needleLength - 1];
+        if (c == last && charsEqual(haystack + pos, needle, needleLength - 1)) {
+            return pos;
+        }
+        pos += shift[c & 0xFF];
+    }
+    return SIZE_MAX;
+}
+
+// caller should ensure 0 < needleLength and pos + needleLength <= haystackLength
+template <typename HaystackChar, typename NeedleChar>
+static size_t findImpl(const HaystackChar* haystack, size_t haystackLength, const NeedleChar* needle, size_t needleLength, size_t pos)
+{
+    const char16_t first = needle[0];
+    const char16_t last = needle[needleLength - 1];
+    if (!fitsIn<HaystackChar>(first) || !fitsIn<HaystackChar>(last)) {
+        return SIZE_MAX;
+    }
+
+    if (needleLength == 1 && sizeof(HaystackChar) == 1) {
+        const void* found = memchr(haystack + pos, first, haystackLength - pos);
+        return found ? (const HaystackChar*)found - haystack : SIZE_MAX;
+    }
+
+    if (needleLength >= STRING_SEARCH_HORSPOOL_MIN_NEEDLE_LENGTH && haystackLength - pos >= STRING_SEARCH_HORSPOOL_MIN_HAYSTACK_LENGTH) {
+        return horspoolFind(haystack, haystackLength, needle, needleLength, pos);
+    }
+
+    // index of the last possible match
+    const size_t end = haystackLength - needleLength;
+    size_t i = pos;
+#if defined(STRING_SEARCH_USE_SIMD)
+    typedef SIMDCandidateFilter<HaystackChar> Filter;
+    Filter filter((HaystackChar)first, (HaystackChar)last);
+    while (i + Filter::laneCount <= end + 1) {
+        uint64_t mask = filter.match(haystack + i, haystack + i + needleLength - 1);
+        while (mask) {
+            size_t lane = __builtin_ctzll(mask) / Filter::bitsPerLane;
+            if (needleLength <= 2 || charsEqual(haystack + i + lane + 1, needle + 1, needleLength - 2)) {
+                return i + lane;
+            }
+            mask = clearLane<Filter>(mask, lane);
+        }
+        i += Filter::laneCount;
+    }
+#endif
+    for (; i <= end; i++) {
+        if (haystack[i] == first && haystack[i + needleLength - 1] == last
+            && (needleLength <= 2 || charsEqual(haystack + i + 1, needle + 1, needleLength - 2))) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+// caller should ensure 0 < needleLength and pos + needleLength <= haystackLength
+template <typename HaystackChar, typename NeedleChar>
+static size_t rfindImpl(const HaystackChar* haystack, size_t haystackLength, const NeedleChar* needle, size_t needleLength, size_t pos)
+{
+    const char16_t first = needle[0];
+    const char16_t last = needle[needleLength - 1];
+    if (!fitsIn<HaystackChar>(first) || !fitsIn<HaystackChar>(last)) {
+        return SIZE_MAX;
+    }
+
+    // candidates are indexes below i
+    size_t i = pos + 1;
+#if defined(STRING_SEARCH_USE_SIMD)
+    typedef SIMDCandidateFilter<HaystackChar> Filter;
+    Filter filter((HaystackChar)first, (HaystackChar)last);
+    while (i >= Filter::laneCount) {
+        size_t base = i - Filter::laneCount;
+        uint64_t mask = filter.match(haystack + base, haystack + base + needleLength - 1);
+        while (mask) {
+            size_t lane = (63 - __builtin_clzll(mask)) / Filter::bitsPerLane;
+            if (needleLength <= 2 || charsEqual(haystack + base + lane + 1, needle + 1, needleLength - 2)) {
+                return base + lane;
+            }
+            mask = clearLane<Filter>(mask, lane);
+        }
+        i = base;
+    }
+#endif
+    while (i-- > 0) {
+        if (haystack[i] == first && haystack[i + needleLength - 1] == last
+            && (needleLength <= 2 || charsEqual(haystack + i + 1, needle + 1, needleLength - 2))) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+size_t StringSearch::find(const StringBufferAccessData& haystack, const StringBufferAccessData& needle, size_t pos)
+{
+    const size_t haystackLength = haystack.length;
+    const size_t needleLength = needle.length;
+    if (needleLength == 0) {
+        return pos <= haystackLength ? pos : SIZE_MAX;
+    }
+    if (needleLength > haystackLength || pos > haystackLength - needleLength) {
+        return SIZE_MAX;
+    }
+
+    if (haystack.has8BitContent) {
+        if (needle.has8BitContent) {
+            return findImpl((const LChar*)haystack.buffer, haystackLength, (const LChar*)needle.buffer, needleLength, pos);
+        }
+        return findImpl((const LChar*)haystack.buffer, haystackLength, (const char16_t*)needle.buffer, needleLength, pos);
+    }
+    if (needle.has8BitContent) {
+        return findImpl((const char16_t*)haystack.buffer, haystackLength, (const LChar*)needle.buffer, needleLength, pos);
+    }
+    return findImpl((const char16_t*)haystack.buffer, haystackLength, (const char16_t*)needle.buffer, needleLength, pos);
+}
+
+size_t StringSearch::rfind(const StringBufferAccessData& haystack, const StringBufferAccessData& needle, size_t pos)
+{
+    const size_t haystackLength = haystack.length;
+    const size_t needleLength = needle.length;
+    if (needleLength == 0) {
+        return pos <= haystackLength ? pos : SIZE_MAX;
+    }
+    if (needleLength > haystackLength) {
+        return SIZE_MAX;
+    }
+    pos = std::min(pos, haystackLength - needleLength);
+
+    if (haystack.has8BitContent) {
+        if (needle.has8BitContent) {
+            return rfindImpl((const LChar*)haystack.buffer, haystackLength, (const LChar*)needle.buffer, needleLength, pos);
+        }
+        return rfindImpl((const LChar*)haystack.buffer, haystackLength, (const char16_t*)needle.buffer, needleLength, pos);
+    }
+    if (needle.has8BitContent) {
+        return rfindImpl((const char16_t*)haystack.buffer, haystackLength, (const LChar*)needle.buffer, needleLength, pos);
+    }
+    return rfindImpl((const char16_t*)haystack.buffer, haystackLength, (const char16_t*)needle.buffer, needleLength, pos);
+}
+
+size_t StringSearch::findChar(const StringBufferAccessData& haystack, char16_t ch, size_t pos)
+{
+    if (pos >= haystack.length) {
+        return SIZE_MAX;
+    }
+    if (haystack.has8BitContent) {
+        return findImpl((const LChar*)haystack.buffer, haystack.length, &ch, 1, pos);
+    }
+    return findImpl((const char16_t*)haystack.buffer, haystack.length, &ch, 1, pos);
+}
+
+bool StringSearch::matchesAt(const StringBufferAccessData& haystack, const StringBufferAccessData& needle, size_t pos)
+{
+    const size_t needleLength = needle.length;
+    if (pos > haystack.length || needleLength > haystack.length - pos) {
+        return false;
+    }
+
+    if (haystack.has8BitContent) {
+        if (needle.has8BitContent) {
+            return charsEqual((const LChar*)haystack.buffer + pos, (const LChar*)needle.buffer, needleLength);
+        }
+        return charsEqual((const LChar*)haystack.buffer + pos, (const char16_t*)needle.buffer, needleLength);
+    }
+    if (needle.has8BitContent) {
+        return charsEqual((const char16_t*)haystack.buffer + pos, (const LChar*)needle.buffer, needleLength);
+    }
+    return charsEqual((const char16_t*)haystack.buffer + pos, (const char16_t*)needle.buffer, needleLength);
+}
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2019-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotStringSearch__
+#define __EscargotStringSearch__
+
+#include "runtime/String.h"
+
+namespace Escargot {
+
+// needles longer than this are searched with Boyer-Moore-Horspool
+// when the searched range is long enough to amortize its skip table
+#ifndef STRING_SEARCH_HORSPOOL_MIN_NEEDLE_LENGTH
+#define STRING_SEARCH_HORSPOOL_MIN_NEEDLE_LENGTH 32
+#endif
+
+#ifndef STRING_SEARCH_HORSPOOL_MIN_HAYSTACK_LENGTH
+#define STRING_SEARCH_HORSPOOL_MIN_HAYSTACK_LENGTH 1024
+#endif
+
+// Search kernels over the buffers of strings, for every 8-bit/16-bit haystack/needle combination.
+// Candidates are filtered by comparing the first and the last character of the needle
+// 16 bytes at a time with SSE2 or NEON when available.
+// Functions return SIZE_MAX when there is no match
+class StringSearch {
+public:
+    // first index >= pos where needle occurs
+    static size_t find(const StringBufferAccessData& haystack, const StringBufferAccessData& needle, size_t pos = 0);
+    // last index <= pos where needle occurs
+    static size_t rfind(const StringBufferAccessData& haystack, const StringBufferAccessData& needle, size_t pos);
+    // first index >= pos of ch
+    static size_t findChar(const StringBufferAccessData& haystack, char16_t ch, size_t pos = 0);
+    // true if needle occurs at pos
+    static bool matchesAt(const StringBufferAccessData& haystack, const StringBufferAccessData& needle, size_t pos);
+};
+}
+
+#endif
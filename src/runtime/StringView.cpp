@@ -35,6 +35,149 @@ void* StringView::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+// views of a parent whose buffer is not copied yet.
+// CompactableStringViewLink::m_view is registered as a disappearing link
+struct CompactableStringViewLink : public gc {
+    CompactableStringView* m_view;
+    CompactableStringViewLink* m_next;
+
+    void* operator new(size_t size)
+    {
+        static bool typeInited = false;
+        static GC_descr descr;
+        if (!typeInited) {
+            GC_word obj_bitmap[GC_BITMAP_SIZE(CompactableStringViewLink)] = { 0 };
+            GC_set_bit(obj_bitmap, GC_WORD_OFFSET(CompactableStringViewLink, m_next));
+            descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(CompactableStringViewLink));
+            typeInited = true;
+        }
+        return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    }
+};
+
+struct CompactableStringViewList : public gc {
+    CompactableStringViewList(GC_finalization_proc chainedFinalizer, void* chainedFinalizerData)
+        : m_first(nullptr)
+        , m_count(0)
+        , m_sweepThreshold(8)
+        , m_chainedFinalizer(chainedFinalizer)
+        , m_chainedFinalizerData(chainedFinalizerData)
+    {
+    }
+
+    void add(CompactableStringView* view)
+    {
+        if (m_count >= m_sweepThreshold) {
+            // unlink collected views
+            CompactableStringViewLink** link = &m_first;
+            while (CompactableStringViewLink* item = *link) {
+                if (!item->m_view) {
+                    *link = item->m_next;
+                    m_count--;
+                } else {
+                    link = &item->m_next;
+                }
+            }
+            m_sweepThreshold = std::max(m_count * 2, (size_t)8);
+        }
+
+        CompactableStringViewLink* item = new CompactableStringViewLink();
+        item->m_view = view;
+        GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(item->m_view), view);
+        item->m_next = m_first;
+        m_first = item;
+        m_count++;
+    }
+
+    CompactableStringViewLink* m_first;
+    size_t m_count;
+    size_t m_sweepThreshold;
+    // finalizer which was registered on the parent before its first view
+    GC_finalization_proc m_chainedFinalizer;
+    void* m_chainedFinalizerData;
+};
+
+CompactableStringView::CompactableStringView(String* str, const size_t s, const size_t e)
+    : String()
+    , m_flatString(nullptr)
+{
+    ASSERT(s <= e);
+    ASSERT(e <= str->length());
+    const auto& srcData = str->bufferAccessData();
+    m_bufferAccessData.has8BitContent = srcData.has8BitContent;
+    m_bufferAccessData.length = e - s;
+    if (srcData.has8BitContent) {
+        m_bufferAccessData.buffer = ((LChar*)srcData.buffer) + s;
+    } else {
+        m_bufferAccessData.buffer = ((char16_t*)srcData.buffer) + s;
+    }
+    m_bufferAccessData.hasSpecialImpl = true;
+
+    // parent keeps the list of its views as the client data of its finalizer
+    GC_finalization_proc oldFn;
+    void* oldList;
+    GC_REGISTER_FINALIZER_NO_ORDER(str, compactViews, nullptr, &oldFn, &oldList);
+    CompactableStringViewList* list;
+    if (oldFn == compactViews) {
+        list = (CompactableStringViewList*)oldList;
+    } else {
+        // other finalizer of the parent is called after its views are compacted
+        list = new CompactableStringViewList(oldFn, oldList);
+    }
+    list->add(this);
+    GC_REGISTER_FINALIZER_NO_ORDER(str, compactViews, list, nullptr, nullptr);
+}
+
+void CompactableStringView::flatten()
+{
+    ASSERT(m_bufferAccessData.hasSpecialImpl);
+    const void* buffer = m_bufferAccessData.buffer;
+    size_t length = m_bufferAccessData.length;
+    String* flat;
+    if (m_bufferAccessData.has8BitContent) {
+        flat = new Latin1String((const LChar*)buffer, length);
+    } else {
+        flat = new UTF16String((const char16_t*)buffer, length);
+    }
+    // the collector can flatten this view while allocating `flat`. both copies are same
+    m_flatString = flat;
+    m_bufferAccessData = flat->bufferAccessData();
+}
+
+void CompactableStringView::compactViews(void* parent, void* list)
+{
+    CompactableStringViewList* viewList = (CompactableStringViewList*)list;
+    CompactableStringViewLink* item = viewList->m_first;
+    while (item) {
+        CompactableStringView* view = item->m_view;
+        if (view) {
+            if (view->m_bufferAccessData.hasSpecialImpl) {
+                view->flatten();
+            }
+            GC_unregister_disappearing_link((void**)&(item->m_view));
+            item->m_view = nullptr;
+        }
+        item = item->m_next;
+    }
+
+    if (viewList->m_chainedFinalizer) {
+        viewList->m_chainedFinalizer(parent, viewList->m_chainedFinalizerData);
+    }
+}
+
+void* CompactableStringView::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(CompactableStringView)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(CompactableStringView, m_flatString));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(CompactableStringView));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
 void* SourceStringView::operator new(size_t size)
 {
     static bool typeInited = false;
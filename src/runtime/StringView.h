@@ -134,6 +134,10 @@ public:
     }
 
     void* operator new(size_t size);
+    void* operator new(size_t, void* ptr)
+    {
+        return ptr;
+    }
     void* operator new[](size_t size) = delete;
 
     String* string() const
@@ -175,6 +179,83 @@ private:
     String* m_string;
 };
 
+// View of a short part of a large string, created by String::substring.
+// Unlike StringView, it does not keep the parent alive. Its characters are copied into a flat string
+// when its buffer is requested (like RopeString), or when the collector finds the parent unreachable
+class CompactableStringView : public String {
+public:
+    CompactableStringView(String* str, const size_t s, const size_t e);
+
+    static bool canCreate(String* str, size_t length)
+    {
+        size_t parentLength = str->length();
+        return parentLength >= STRING_SUB_STRING_COMPACTABLE_VIEW_MIN_PARENT_LENGTH && length * STRING_SUB_STRING_COMPACTABLE_VIEW_MAX_LENGTH_RATE <= parentLength;
+    }
+
+    virtual char16_t charAt(const size_t idx) const
+    {
+        // m_bufferAccessData is valid before flattening too
+        if (m_bufferAccessData.has8BitContent) {
+            return ((const LChar*)m_bufferAccessData.buffer)[idx];
+        } else {
+            return ((const char16_t*)m_bufferAccessData.buffer)[idx];
+        }
+    }
+
+    virtual size_t length() const
+    {
+        return m_bufferAccessData.length;
+    }
+
+    virtual UTF16StringData toUTF16StringData() const
+    {
+        return flatString()->toUTF16StringData();
+    }
+
+    virtual UTF8StringData toUTF8StringData() const
+    {
+        return flatString()->toUTF8StringData();
+    }
+
+    virtual UTF8StringDataNonGCStd toNonGCUTF8StringData() const
+    {
+        return flatString()->toNonGCUTF8StringData();
+    }
+
+    virtual const LChar* characters8() const
+    {
+        return flatString()->characters8();
+    }
+
+    virtual const char16_t* characters16() const
+    {
+        return flatString()->characters16();
+    }
+
+    virtual void bufferAccessDataSpecialImpl()
+    {
+        flatten();
+    }
+
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+
+private:
+    String* flatString() const
+    {
+        if (m_bufferAccessData.hasSpecialImpl) {
+            const_cast<CompactableStringView*>(this)->flatten();
+        }
+        return m_flatString;
+    }
+
+    void flatten();
+    static void compactViews(void* parent, void* list);
+
+    // null until flattened. buffer of m_bufferAccessData points into the parent before that
+    String* m_flatString;
+};
+
 class SourceStringView : public String {
 public:
     ALWAYS_INLINE explicit SourceStringView(const StringView& str)
@@ -25,6 +25,239 @@
 
 namespace Escargot {
 
+#define DEFINE_TYPEDARRAY_TAG(Type, type, siz) \
+    size_t g_##type##ArrayObjectTag;
+FOR_EACH_TYPEDARRAY_TYPES(DEFINE_TYPEDARRAY_TAG)
+#undef DEFINE_TYPEDARRAY_TAG
+
+template <typename TargetAdaptor, typename SourceType, bool isIntegralConversion = std::is_integral<typename TargetAdaptor::Type>::value && std::is_integral<SourceType>::value, bool isFromFloat = std::is_floating_point<SourceType>::value && std::is_integral<typename TargetAdaptor::Type>::value>
+struct TypedArrayElementConverter {
+    // integer to integer wraps around like ToInt32, and anything to float is a plain conversion
+    static ALWAYS_INLINE typename TargetAdaptor::Type convert(ExecutionState& state, SourceType value)
+    {
+        return static_cast<typename TargetAdaptor::Type>(value);
+    }
+};
+
+template <typename TargetAdaptor, typename SourceType>
+struct TypedArrayElementConverter<TargetAdaptor, SourceType, false, true> {
+    static ALWAYS_INLINE typename TargetAdaptor::Type convert(ExecutionState& state, SourceType value)
+    {
+        return TargetAdaptor::toNativeFromDouble(state, value);
+    }
+};
+
+// plain loops without calls, so compiler can vectorize most of them
+template <typename TargetAdaptor, typename SourceType>
+static void convertElements(ExecutionState& state, typename TargetAdaptor::Type* target, const SourceType* source, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        target[i] = TypedArrayElementConverter<TargetAdaptor, SourceType>::convert(state, source[i]);
+    }
+}
+
+template <typename TargetAdaptor>
+static void convertElementsFrom(ExecutionState& state, typename TargetAdaptor::Type* target, TypedArrayType sourceType, const uint8_t* source, size_t count)
+{
+    switch (sourceType) {
+#define CONVERT_FROM(Name, name, siz)                                                                       \
+    case TypedArrayType::Name:                                                                              \
+        convertElements<TargetAdaptor>(state, target, (const typename Name##Adaptor::Type*)source, count); \
+        break;
+        FOR_EACH_TYPEDARRAY_TYPES(CONVERT_FROM)
+#undef CONVERT_FROM
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+void ArrayBufferView::copyElementsFrom(ExecutionState& state, size_t targetIndex, ArrayBufferView* source, size_t sourceIndex, size_t count)
+{
+    ASSERT(!buffer()->isDetachedBuffer() && !source->buffer()->isDetachedBuffer());
+    ASSERT(targetIndex + count <= arraylength() && sourceIndex + count <= source->arraylength());
+    TypedArrayType targetType = typedArrayType();
+    TypedArrayType sourceType = source->typedArrayType();
+    size_t targetElementSize = getElementSize(targetType);
+    size_t sourceElementSize = getElementSize(sourceType);
+    uint8_t* target = rawBuffer() + targetIndex * targetElementSize;
+    const uint8_t* sourceStart = source->rawBuffer() + sourceIndex * sourceElementSize;
+
+    if (targetType == sourceType) {
+        memmove(target, sourceStart, count * targetElementSize);
+        return;
+    }
+
+    // element sizes differ or conversions are done in place, so overlapped source is copied first
+    uint8_t* temporary = nullptr;
+    if (sourceStart < target + count * targetElementSize && target < sourceStart + count * sourceElementSize) {
+        temporary = (uint8_t*)malloc(count * sourceElementSize);
+        memcpy(temporary, sourceStart, count * sourceElementSize);
+        sourceStart = temporary;
+    }
+
+    switch (targetType) {
+#define CONVERT_TO(Name, name, siz)                                                                                           \
+    case TypedArrayType::Name:                                                                                                \
+        convertElementsFrom<Name##Adaptor>(state, (typename Name##Adaptor::Type*)target, sourceType, sourceStart, count); \
+        break;
+        FOR_EACH_TYPEDARRAY_TYPES(CONVERT_TO)
+#undef CONVERT_TO
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+
+    free(temporary);
+}
+
+template <typename TypeAdaptor>
+static size_t copyFastModeDoubleElements(ExecutionState& state, typename TypeAdaptor::Type* target, const double* source, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (UNLIKELY(bitwise_cast<uint64_t>(source[i]) == ESCARGOT_ARRAY_DOUBLE_HOLE_BITS)) {
+            return i;
+        }
+        target[i] = TypedArrayElementConverter<TypeAdaptor, double>::convert(state, source[i]);
+    }
+    return count;
+}
+
+template <typename TypeAdaptor>
+static size_t copyFastModeValueElements(ExecutionState& state, typename TypeAdaptor::Type* target, const SmallValue* source, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        Value value(source[i]);
+        if (LIKELY(value.isInt32())) {
+            target[i] = TypeAdaptor::toNativeFromInt32(state, value.asInt32());
+        } else if (value.isDouble()) {
+            target[i] = TypeAdaptor::toNativeFromDouble(state, value.asDouble());
+        } else {
+            return i;
+        }
+    }
+    return count;
+}
+
+size_t ArrayBufferView::copyElementsFromFastModeArray(ExecutionState& state, size_t targetIndex, ArrayObject* source, size_t count)
+{
+    ASSERT(!buffer()->isDetachedBuffer());
+    ASSERT(targetIndex + count <= arraylength());
+    if (!source->isFastModeArray()) {
+        return 0;
+    }
+    count = std::min(count, (size_t)source->getArrayLength(state));
+    uint8_t* target = rawBuffer() + targetIndex * getElementSize(typedArrayType());
+
+    switch (typedArrayType()) {
+#define COPY_FROM_ARRAY(Name, name, siz)                                                                                             \
+    case TypedArrayType::Name:                                                                                                       \
+        if (source->hasFastModeDoubleData()) {                                                                                       \
+            return copyFastModeDoubleElements<Name##Adaptor>(state, (typename Name##Adaptor::Type*)target, source->m_fastModeDoubleData.data(), count); \
+        }                                                                                                                            \
+        return copyFastModeValueElements<Name##Adaptor>(state, (typename Name##Adaptor::Type*)target, source->m_fastModeData.data(), count);
+        FOR_EACH_TYPEDARRAY_TYPES(COPY_FROM_ARRAY)
+#undef COPY_FROM_ARRAY
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+void ArrayBufferView::fillElements(ExecutionState& state, size_t start, size_t end, double value)
+{
+    ASSERT(!buffer()->isDetachedBuffer());
+    ASSERT(start <= end && end <= arraylength());
+    switch (typedArrayType()) {
+#define FILL(Name, name, siz)                                                                    \
+    case TypedArrayType::Name: {                                                                 \
+        typename Name##Adaptor::Type* data = (typename Name##Adaptor::Type*)rawBuffer();         \
+        std::fill(data + start, data + end, Name##Adaptor::toNativeFromDouble(state, value));    \
+        break;                                                                                   \
+    }
+        FOR_EACH_TYPEDARRAY_TYPES(FILL)
+#undef FILL
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+// returns false if no element of Type can be equal to value
+template <typename Type>
+static ALWAYS_INLINE bool toSearchElement(double value, Type& result, std::true_type isIntegral)
+{
+    if (!(value >= std::numeric_limits<Type>::min() && value <= std::numeric_limits<Type>::max())) {
+        return false;
+    }
+    result = static_cast<Type>(value);
+    return static_cast<double>(result) == value;
+}
+
+template <typename Type>
+static ALWAYS_INLINE bool toSearchElement(double value, Type& result, std::false_type isIntegral)
+{
+    if (std::abs(value) > std::numeric_limits<Type>::max() && !std::isinf(value)) {
+        return false;
+    }
+    result = static_cast<Type>(value);
+    return static_cast<double>(result) == value;
+}
+
+template <typename Type>
+static size_t indexOfElementImpl(const Type* data, size_t start, size_t end, double value)
+{
+    Type element;
+    if (toSearchElement(value, element, std::is_integral<Type>())) {
+        for (size_t i = start; i < end; i++) {
+            if (data[i] == element) {
+                return i;
+            }
+        }
+    }
+    return SIZE_MAX;
+}
+
+template <typename Type>
+static size_t lastIndexOfElementImpl(const Type* data, size_t start, double value)
+{
+    Type element;
+    if (toSearchElement(value, element, std::is_integral<Type>())) {
+        for (size_t i = start + 1; i > 0; i--) {
+            if (data[i - 1] == element) {
+                return i - 1;
+            }
+        }
+    }
+    return SIZE_MAX;
+}
+
+size_t ArrayBufferView::indexOfElement(double value, size_t start, size_t end)
+{
+    ASSERT(!buffer()->isDetachedBuffer());
+    ASSERT(end <= arraylength());
+    switch (typedArrayType()) {
+#define INDEX_OF(Name, name, siz) \
+    case TypedArrayType::Name:    \
+        return indexOfElementImpl((const typename Name##Adaptor::Type*)rawBuffer(), start, end, value);
+        FOR_EACH_TYPEDARRAY_TYPES(INDEX_OF)
+#undef INDEX_OF
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+size_t ArrayBufferView::lastIndexOfElement(double value, size_t start)
+{
+    ASSERT(!buffer()->isDetachedBuffer());
+    ASSERT(start < arraylength());
+    switch (typedArrayType()) {
+#define LAST_INDEX_OF(Name, name, siz) \
+    case TypedArrayType::Name:         \
+        return lastIndexOfElementImpl((const typename Name##Adaptor::Type*)rawBuffer(), start, value);
+        FOR_EACH_TYPEDARRAY_TYPES(LAST_INDEX_OF)
+#undef LAST_INDEX_OF
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
 #define DEFINE_FN(Type, type, siz)                                                                    \
     template <>                                                                                       \
     void TypedArrayObject<Type##Adaptor, siz>::typedArrayObjectPrototypeFiller(ExecutionState& state) \
@@ -137,6 +137,19 @@ public:
         }
     }
 
+    // Bulk element operations working on the raw buffer. Buffers should not be detached,
+    // and indexes should be in bounds of arraylength()
+    // copies count elements of source starting at sourceIndex, converting them when types differ. views may overlap
+    void copyElementsFrom(ExecutionState& state, size_t targetIndex, ArrayBufferView* source, size_t sourceIndex, size_t count);
+    // copies leading number elements of fast-mode array, and returns the number of copied elements.
+    // it stops at a hole or a non-number element, which need [[Get]] or ToNumber
+    size_t copyElementsFromFastModeArray(ExecutionState& state, size_t targetIndex, ArrayObject* source, size_t count);
+    void fillElements(ExecutionState& state, size_t start, size_t end, double value);
+    // index of first element in [start, end) which is equal to value, or SIZE_MAX
+    size_t indexOfElement(double value, size_t start, size_t end);
+    // index of last element in [0, start] which is equal to value, or SIZE_MAX
+    size_t lastIndexOfElement(double value, size_t start);
+
     void* operator new(size_t size)
     {
         static bool typeInited = false;
@@ -163,7 +176,7 @@ private:
 };
 
 template <typename Adapter>
-struct TypedArrayAdaptor {
+struct TypedArrayAdaptor : public Adapter {
     typedef typename Adapter::Type Type;
     static Type toNative(ExecutionState& state, const Value& val)
     {
@@ -355,12 +368,30 @@ public:
 protected:
 };
 
+#define FOR_EACH_TYPEDARRAY_TYPES(F) \
+    F(Int8, int8, 1)                 \
+    F(Int16, int16, 2)               \
+    F(Int32, int32, 4)               \
+    F(Uint8, uint8, 1)               \
+    F(Uint8Clamped, uint8Clamped, 1) \
+    F(Uint16, uint16, 2)             \
+    F(Uint32, uint32, 4)             \
+    F(Float32, float32, 4)           \
+    F(Float64, float64, 8)
+
+#define DECLARE_TYPEDARRAY_TAG(Type, type, siz) \
+    extern size_t g_##type##ArrayObjectTag;
+// vtables of each typed array class. they are set when the first object of each class is created
+FOR_EACH_TYPEDARRAY_TYPES(DECLARE_TYPEDARRAY_TAG)
+#undef DECLARE_TYPEDARRAY_TAG
+
 typedef TypedArrayObject<Int8Adaptor, 1> Int8ArrayObjectWrapper;
 class Int8ArrayObject : public Int8ArrayObjectWrapper {
 public:
     explicit Int8ArrayObject(ExecutionState& state)
         : Int8ArrayObjectWrapper(state)
     {
+        g_int8ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -373,6 +404,7 @@ public:
     explicit Int16ArrayObject(ExecutionState& state)
         : Int16ArrayObjectWrapper(state)
     {
+        g_int16ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -385,6 +417,7 @@ public:
     explicit Int32ArrayObject(ExecutionState& state)
         : Int32ArrayObjectWrapper(state)
     {
+        g_int32ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -397,6 +430,7 @@ public:
     explicit Uint8ArrayObject(ExecutionState& state)
         : Uint8ArrayObjectWrapper(state)
     {
+        g_uint8ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -409,6 +443,7 @@ public:
     explicit Uint16ArrayObject(ExecutionState& state)
         : Uint16ArrayObjectWrapper(state)
     {
+        g_uint16ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -421,6 +456,7 @@ public:
     explicit Uint32ArrayObject(ExecutionState& state)
         : Uint32ArrayObjectWrapper(state)
     {
+        g_uint32ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -433,6 +469,7 @@ public:
     explicit Uint8ClampedArrayObject(ExecutionState& state)
         : Uint8ClampedArrayObjectWrapper(state)
     {
+        g_uint8ClampedArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -445,6 +482,7 @@ public:
     explicit Float32ArrayObject(ExecutionState& state)
         : Float32ArrayObjectWrapper(state)
     {
+        g_float32ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
@@ -457,12 +495,79 @@ public:
     explicit Float64ArrayObject(ExecutionState& state)
         : Float64ArrayObjectWrapper(state)
     {
+        g_float64ArrayObjectTag = *((size_t*)this);
     }
     virtual TypedArrayType typedArrayType()
     {
         return TypedArrayType::Float64;
     }
 };
+
+// Element access for GetObject and SetObjectOperation of the interpreter, without virtual calls.
+// They return false if object is not a typed array, property is not an in-bounds index or the buffer is detached.
+// the caller should fall back to getIndexedProperty or setIndexedProperty then
+class TypedArrayFastAccess {
+public:
+    static ALWAYS_INLINE bool getElement(PointerValue* object, const Value& property, Value& result)
+    {
+        size_t tag = object->getTag();
+#define GET_ELEMENT(Type, type, siz)                                                                   \
+    if (tag == g_##type##ArrayObjectTag) {                                                             \
+        return loadElement<Type##Adaptor>((ArrayBufferView*)object->asObject(), property, result); \
+    }
+        FOR_EACH_TYPEDARRAY_TYPES(GET_ELEMENT)
+#undef GET_ELEMENT
+        return false;
+    }
+
+    // only numbers are stored here, because converting other values can run user code which detaches the buffer
+    static ALWAYS_INLINE bool setElement(ExecutionState& state, PointerValue* object, const Value& property, const Value& value)
+    {
+        if (UNLIKELY(!value.isNumber())) {
+            return false;
+        }
+        size_t tag = object->getTag();
+#define SET_ELEMENT(Type, type, siz)                                                                      \
+    if (tag == g_##type##ArrayObjectTag) {                                                                \
+        return storeElement<Type##Adaptor>(state, (ArrayBufferView*)object->asObject(), property, value); \
+    }
+        FOR_EACH_TYPEDARRAY_TYPES(SET_ELEMENT)
+#undef SET_ELEMENT
+        return false;
+    }
+
+private:
+    template <typename TypeAdaptor>
+    static ALWAYS_INLINE typename TypeAdaptor::Type* elementAddress(ArrayBufferView* view, const Value& property)
+    {
+        if (LIKELY(property.isUInt32()) && LIKELY(property.asUInt32() < view->arraylength()) && LIKELY(!view->buffer()->isDetachedBuffer())) {
+            return (typename TypeAdaptor::Type*)view->rawBuffer() + property.asUInt32();
+        }
+        return nullptr;
+    }
+
+    template <typename TypeAdaptor>
+    static ALWAYS_INLINE bool loadElement(ArrayBufferView* view, const Value& property, Value& result)
+    {
+        typename TypeAdaptor::Type* address = elementAddress<TypeAdaptor>(view, property);
+        if (LIKELY(address != nullptr)) {
+            result = Value(*address);
+            return true;
+        }
+        return false;
+    }
+
+    template <typename TypeAdaptor>
+    static ALWAYS_INLINE bool storeElement(ExecutionState& state, ArrayBufferView* view, const Value& property, const Value& value)
+    {
+        typename TypeAdaptor::Type* address = elementAddress<TypeAdaptor>(view, property);
+        if (LIKELY(address != nullptr)) {
+            *address = TypeAdaptor::toNative(state, value);
+            return true;
+        }
+        return false;
+    }
+};
 }
 
 #endif
@@ -23,6 +23,8 @@
 #include "ArrayObject.h"
 #include "StringObject.h"
 #include "JobQueue.h"
+#include "SandBox.h"
+#include "util/Util.h"
 
 namespace Escargot {
 
@@ -341,6 +343,7 @@ void VMInstance::clearCaches()
 {
     m_compiledCodeBlocks.clear();
     m_regexpCache.clear();
+    m_structureLookupCache.clear();
     m_cachedUTC = nullptr;
     globalSymbolRegistry().clear();
 }
@@ -362,7 +365,7 @@ void VMInstance::somePrototypeObjectDefineIndexedProperty(ExecutionState& state)
     GC_enable();
 
     for (size_t i = 0; i < allOfArrayRooted.size(); i++) {
-        allOfArrayRooted[i]->convertIntoNonFastMode(state);
+        allOfArrayRooted[i]->convertIntoSparseMode(state);
     }
 }
 
@@ -391,16 +394,49 @@ bool VMInstance::removeRoot(void* ptr)
 }
 
 Value VMInstance::drainJobQueue()
+{
+    return drainJobQueue(0, 0).error;
+}
+
+VMInstance::DrainJobQueueResult VMInstance::drainJobQueue(size_t maxJobCount, uint64_t timeBudget)
 {
     ASSERT(!m_jobQueueListener);
 
+    DrainJobQueueResult result;
     DefaultJobQueue* jobQueue = DefaultJobQueue::get(this->jobQueue());
+    uint64_t startTime = longTickCount();
+    auto budgetRemains = [&]() -> bool {
+        if (maxJobCount && result.executedJobCount >= maxJobCount) {
+            return false;
+        }
+        return !timeBudget || longTickCount() - startTime < timeBudget;
+    };
+
     while (jobQueue->hasNextJob()) {
-        auto jobResult = jobQueue->nextJob()->run();
-        if (!jobResult.error.isEmpty())
-            return jobResult.error;
+        // consecutive jobs of a context share one SandBox instead of creating one per job
+        Context* context = jobQueue->peekJob()->relatedContext();
+        SandBox sandbox(context);
+        ExecutionState state(context);
+        auto sandBoxResult = sandbox.run([&]() -> Value {
+            do {
+                Job* job = jobQueue->nextJob();
+                result.executedJobCount++;
+                job->runInSandBox(state);
+            } while (jobQueue->hasNextJob() && jobQueue->peekJob()->relatedContext() == context && budgetRemains());
+            return Value();
+        });
+        if (!sandBoxResult.error.isEmpty()) {
+            result.error = sandBoxResult.error;
+            break;
+        }
+        if (!budgetRemains()) {
+            break;
+        }
     }
-    return Value(Value::EmptyValue);
+
+    result.remainingJobCount = jobQueue->jobCount();
+    result.elapsedTime = longTickCount() - startTime;
+    return result;
 }
 
 void VMInstance::setNewPromiseJobListener(NewPromiseJobListener l)
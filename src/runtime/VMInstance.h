@@ -187,6 +187,23 @@ public:
     // if thres is no job or no error, returns EmptyValue
     Value drainJobQueue();
 
+    struct DrainJobQueueResult {
+        Value error; // EmptyValue if there was no error
+        size_t executedJobCount;
+        size_t remainingJobCount;
+        uint64_t elapsedTime; // in microseconds
+        DrainJobQueueResult()
+            : error(Value::EmptyValue)
+            , executedJobCount(0)
+            , remainingJobCount(0)
+            , elapsedTime(0)
+        {
+        }
+    };
+    // runs jobs until the queue is empty, an error occurs, maxJobCount jobs are executed or timeBudget(microseconds) is spent.
+    // 0 means no limit. at least one job is executed if there is
+    DrainJobQueueResult drainJobQueue(size_t maxJobCount, uint64_t timeBudget);
+
     typedef void (*NewPromiseJobListener)(ExecutionState& state, Job* job);
     void setNewPromiseJobListener(NewPromiseJobListener l);
 #endif
@@ -214,6 +231,11 @@ public:
         return m_randEngine;
     }
 
+    ObjectStructureLookupCache& structureLookupCache()
+    {
+        return m_structureLookupCache;
+    }
+
 private:
     StaticStrings m_staticStrings;
     AtomicStringMap m_atomicStringMap;
@@ -245,6 +267,7 @@ private:
     ObjectStructure* m_defaultStructureForRegExpObject;
     ObjectStructure* m_defaultStructureForArgumentsObject;
     ObjectStructure* m_defaultStructureForArgumentsObjectInStrictMode;
+    ObjectStructureLookupCache m_structureLookupCache;
 
     Vector<String*, GCUtil::gc_malloc_ignore_off_page_allocator<String*>> m_parsedSourceCodes;
     Vector<CodeBlock*, GCUtil::gc_malloc_ignore_off_page_allocator<CodeBlock*>> m_compiledCodeBlocks;
@@ -254,7 +277,7 @@ private:
 
     // regexp object data
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
-    RegExpCacheMap m_regexpCache;
+    RegExpCache m_regexpCache;
 
 // date object data
 #ifdef ENABLE_ICU
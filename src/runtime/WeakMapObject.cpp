@@ -36,6 +36,7 @@ void* WeakMapObject::WeakMapObjectDataItem::operator new(size_t size)
     static GC_descr descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(WeakMapObject::WeakMapObjectDataItem)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject::WeakMapObjectDataItem, next));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject::WeakMapObjectDataItem, data));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(WeakMapObject::WeakMapObjectDataItem));
         typeInited = true;
@@ -61,54 +62,29 @@ void* WeakMapObject::operator new(size_t size)
 
 bool WeakMapObject::deleteOperation(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            m_storage[i]->key = nullptr;
-            m_storage[i]->data = SmallValue(nullptr);
-            return true;
-        }
-    }
-    return false;
+    return m_storage.remove(key);
 }
 
 Value WeakMapObject::get(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            return m_storage[i]->data;
-        }
+    WeakMapObjectDataItem* item = m_storage.find(key);
+    if (item) {
+        return item->data;
     }
     return Value();
 }
 
 bool WeakMapObject::has(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage.find(key) != nullptr;
 }
 
-
 void WeakMapObject::set(ExecutionState& state, Object* key, const Value& value)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            m_storage[i]->data = value;
-            return;
-        }
+    WeakMapObjectDataItem* item = m_storage.find(key);
+    if (!item) {
+        item = m_storage.add(key);
     }
-
-    auto newData = new WeakMapObjectDataItem();
-    newData->key = key;
-    newData->data = value;
-    GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(newData->key), newData->key);
-    m_storage.pushBack(newData);
+    item->data = value;
 }
 }
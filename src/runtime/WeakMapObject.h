@@ -21,6 +21,7 @@
 #define __EscargotWeakMapObject__
 
 #include "runtime/Object.h"
+#include "runtime/WeakObjectHashTable.h"
 
 namespace Escargot {
 
@@ -28,12 +29,13 @@ class WeakMapObject : public Object {
 public:
     struct WeakMapObjectDataItem : public gc {
         Object* key;
+        WeakMapObjectDataItem* next;
         SmallValue data;
 
         void* operator new(size_t size);
         void* operator new[](size_t size) = delete;
     };
-    typedef TightVector<WeakMapObjectDataItem*, GCUtil::gc_malloc_ignore_off_page_allocator<WeakMapObjectDataItem*>> WeakMapObjectData;
+    typedef WeakObjectHashTable<WeakMapObjectDataItem> WeakMapObjectData;
     explicit WeakMapObject(ExecutionState& state);
 
     virtual bool isWeakMapObject() const
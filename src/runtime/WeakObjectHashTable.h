@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotWeakObjectHashTable__
+#define __EscargotWeakObjectHashTable__
+
+namespace Escargot {
+
+class Object;
+
+#ifndef ESCARGOT_WEAK_OBJECT_HASH_TABLE_INITIAL_BUCKET_SIZE
+#define ESCARGOT_WEAK_OBJECT_HASH_TABLE_INITIAL_BUCKET_SIZE 8
+#endif
+
+// Hash table keyed by object identity, used as the storage of WeakMap, WeakSet.
+// Item::key is registered as a disappearing link, so the collector clears it when the key dies.
+// Cleared items are unlinked while walking their chain, and the whole table is swept
+// before growing if a collection happened since the last sweep.
+// Item should have `Object* key` and `Item* next` fields. key should not be traced by the collector
+template <typename Item>
+class WeakObjectHashTable : public gc {
+public:
+    WeakObjectHashTable()
+        : m_count(0)
+        , m_lastSweptGCCount(0)
+    {
+    }
+
+    Item* find(Object* key)
+    {
+        if (!m_count) {
+            return nullptr;
+        }
+
+        Item** link = &m_buckets[bucketIndex(key)];
+        while (Item* item = *link) {
+            Object* existingKey = item->key;
+            if (existingKey == key) {
+                return item;
+            }
+            if (!existingKey) {
+                // key of this item is collected
+                *link = item->next;
+                m_count--;
+                continue;
+            }
+            link = &item->next;
+        }
+        return nullptr;
+    }
+
+    // caller should check the key is not in the table
+    Item* add(Object* key)
+    {
+        if (m_count >= m_buckets.size()) {
+            if (GC_get_gc_no() != m_lastSweptGCCount) {
+                sweep();
+            }
+            if (m_count >= m_buckets.size()) {
+                rehash(std::max(m_buckets.size() * 2, (size_t)ESCARGOT_WEAK_OBJECT_HASH_TABLE_INITIAL_BUCKET_SIZE));
+            }
+        }
+
+        Item* item = new Item();
+        item->key = key;
+        GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(item->key), key);
+
+        Item*& head = m_buckets[bucketIndex(key)];
+        item->next = head;
+        head = item;
+        m_count++;
+        return item;
+    }
+
+    bool remove(Object* key)
+    {
+        if (!m_count) {
+            return false;
+        }
+
+        Item** link = &m_buckets[bucketIndex(key)];
+        while (Item* item = *link) {
+            Object* existingKey = item->key;
+            if (existingKey == key || !existingKey) {
+                *link = item->next;
+                m_count--;
+                if (existingKey) {
+                    GC_unregister_disappearing_link((void**)&(item->key));
+                    item->key = nullptr;
+                    return true;
+                }
+                continue;
+            }
+            link = &item->next;
+        }
+        return false;
+    }
+
+private:
+    size_t bucketIndex(Object* key)
+    {
+        size_t h = (size_t)key >> 3;
+        h ^= h >> 16;
+        h *= 0x45d9f3b;
+        h ^= h >> 16;
+        return h & (m_buckets.size() - 1);
+    }
+
+    void sweep()
+    {
+        for (size_t i = 0; i < m_buckets.size(); i++) {
+            Item** link = &m_buckets[i];
+            while (Item* item = *link) {
+                if (!item->key) {
+                    *link = item->next;
+                    m_count--;
+                } else {
+                    link = &item->next;
+                }
+            }
+        }
+        m_lastSweptGCCount = GC_get_gc_no();
+    }
+
+    void rehash(size_t bucketCount)
+    {
+        Vector<Item*, GCUtil::gc_malloc_ignore_off_page_allocator<Item*>> oldBuckets(std::move(m_buckets));
+        m_buckets.resize(bucketCount, nullptr);
+        m_count = 0;
+
+        for (size_t i = 0; i < oldBuckets.size(); i++) {
+            Item* item = oldBuckets[i];
+            while (item) {
+                Item* next = item->next;
+                if (item->key) {
+                    Item*& head = m_buckets[bucketIndex(item->key)];
+                    item->next = head;
+                    head = item;
+                    m_count++;
+                }
+                item = next;
+            }
+        }
+    }
+
+    Vector<Item*, GCUtil::gc_malloc_ignore_off_page_allocator<Item*>> m_buckets;
+    // number of linked items, including items whose key is collected but not unlinked yet
+    size_t m_count;
+    GC_word m_lastSweptGCCount;
+};
+}
+
+#endif
@@ -30,6 +30,19 @@ WeakSetObject::WeakSetObject(ExecutionState& state)
     Object::setPrototype(state, state.context()->globalObject()->weakSetPrototype());
 }
 
+void* WeakSetObject::WeakSetObjectDataItem::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(WeakSetObject::WeakSetObjectDataItem)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakSetObject::WeakSetObjectDataItem, next));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(WeakSetObject::WeakSetObjectDataItem));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
 void* WeakSetObject::operator new(size_t size)
 {
     static bool typeInited = false;
@@ -48,45 +61,18 @@ void* WeakSetObject::operator new(size_t size)
 
 bool WeakSetObject::deleteOperation(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                m_storage[i] = nullptr;
-                return true;
-            }
-        }
-    }
-    return false;
+    return m_storage.remove(key);
 }
 
 void WeakSetObject::add(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                return;
-            }
-        }
+    if (!m_storage.find(key)) {
+        m_storage.add(key);
     }
-
-    auto newData = new WeakSetObjectDataItem();
-    newData->key = key;
-    GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(newData->key), newData->key);
-    m_storage.pushBack(newData);
 }
 
 bool WeakSetObject::has(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return m_storage.find(key) != nullptr;
 }
 }
@@ -21,6 +21,7 @@
 #define __EscargotWeakSetObject__
 
 #include "runtime/Object.h"
+#include "runtime/WeakObjectHashTable.h"
 
 namespace Escargot {
 
@@ -28,14 +29,13 @@ class WeakSetObject : public Object {
 public:
     struct WeakSetObjectDataItem : public gc {
         Object* key;
-        void* operator new(size_t size)
-        {
-            return GC_MALLOC_ATOMIC(size);
-        }
+        WeakSetObjectDataItem* next;
+
+        void* operator new(size_t size);
         void* operator new[](size_t size) = delete;
     };
 
-    typedef TightVector<WeakSetObjectDataItem*, GCUtil::gc_malloc_ignore_off_page_allocator<WeakSetObjectDataItem*>> WeakSetObjectData;
+    typedef WeakObjectHashTable<WeakSetObjectDataItem> WeakSetObjectData;
     explicit WeakSetObject(ExecutionState& state);
 
     virtual bool isWeakSetObject() const
@@ -16,6 +16,7 @@
 
 #include <EscargotPublic.h>
 #include <string.h>
+#include <string>
 
 #define CHECK(name, cond) \
     printf(name" | %s\n", (cond) ? "pass" : "fail");
@@ -173,6 +174,207 @@ int main(int argc, char* argv[])
         sb->destroy();
     }
 
+    // code cache test
+    {
+        const char* script = "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); } var s = 'c' + 'ache'; for (var i = 0; i < 3; i++) { try { if (i == 1) continue; } finally { s += i; } } s + fib(10) + /ab+/.test('abb');";
+        const char* filename = "CodeCache.js";
+        const char* cacheFile = "testapi_codecache.bin";
+        remove(cacheFile);
+
+        std::string results[2];
+        for (int i = 0; i < 2; i++) {
+            Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parseWithCodeCache(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII(filename, strlen(filename)), cacheFile).m_script;
+            Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+            auto sandBoxResult = sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+                return scriptRef->execute(state);
+            });
+            if (sandBoxResult.result) {
+                results[i] = sandBoxResult.result->toString(es)->toStdUTF8String();
+            }
+            sb->destroy();
+
+            if (i == 0) {
+                FILE* fp = fopen(cacheFile, "rb");
+                CHECK("Code cache file is written", fp);
+                if (fp) {
+                    fclose(fp);
+                }
+            }
+        }
+
+        CHECK("Code cache result 1", results[0] == "cache01255true");
+        CHECK("Code cache result 2", results[0] == results[1]);
+        remove(cacheFile);
+    }
+
+    // batched code cache test
+    {
+        // '/' of the last script is guessed wrong by pre-scanning, so parser falls back to Scanner there
+        const char* scripts[4] = {
+            "var a = 1; /* comment\n */ a += 0x10 + 1.5e1 + .5; a",
+            "var b = `x${ { y: 2 }.y }z` + /[/}]+/g.exec('a/}')[0]; // comment\nb",
+            "var c = [1, 2, 3].map(function(v) { return v / 2 / 1; }).join(); c + (typeof a) + (typeof b)",
+            "var x = 1, y = 'are', r = ''; if (x) /re/.test(y) && (r += 't'); var n = 8; r += n++ / 2 / 2; r",
+        };
+        const char* cacheFiles[4] = { "testapi_batch0.bin", nullptr, "testapi_batch2.bin", nullptr };
+        const char* expected[4] = { "32.5", "x2z/}", "0.5,1,1.5numberstring", "t2" };
+
+        bool passed[2] = { true, true };
+        Escargot::ScriptParserRef::CodeCacheStatistics statistics[2];
+        for (int i = 0; i < 2; i++) {
+            Escargot::ScriptParserRef::CodeCacheSourceVector sources;
+            for (int j = 0; j < 4; j++) {
+                Escargot::ScriptParserRef::CodeCacheSource source;
+                source.script = Escargot::StringRef::fromASCII(scripts[j], strlen(scripts[j]));
+                source.fileName = Escargot::StringRef::fromASCII("Batch.js");
+                source.cacheFilePath = cacheFiles[j];
+                sources.push_back(source);
+                if (i == 0 && cacheFiles[j]) {
+                    remove(cacheFiles[j]);
+                }
+            }
+
+            Escargot::ScriptParserRef::ScriptParserResultVector results = ctx->scriptParser()->parseWithCodeCache(sources, 2, &statistics[i]);
+            passed[i] = results.size() == 4;
+            for (size_t j = 0; passed[i] && j < results.size(); j++) {
+                Escargot::ScriptRef* scriptRef = results[j].m_script;
+                if (!scriptRef) {
+                    passed[i] = false;
+                    break;
+                }
+                Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+                std::string result;
+                sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+                    Escargot::ValueRef* value = scriptRef->execute(state);
+                    result = value->toString(state)->toStdUTF8String();
+                    return value;
+                });
+                sb->destroy();
+                passed[i] = result == expected[j];
+            }
+        }
+
+        CHECK("Batched code cache 1", passed[0]);
+        CHECK("Batched code cache 2", passed[1]);
+        // sources without valid caches are parsed with pre-scanned tokens in both passes
+        for (int i = 0; i < 2; i++) {
+            CHECK("Batched code cache pre-scan", statistics[i].preScannedTokenCount > 0);
+            CHECK("Batched code cache replay", statistics[i].replayedTokenCount > 0 && statistics[i].replayedTokenCount <= statistics[i].preScannedTokenCount);
+            CHECK("Batched code cache fallback", statistics[i].missedTokenCount > 0);
+        }
+        // sources with valid caches are not pre-scanned
+        CHECK("Batched code cache loaded", statistics[1].preScannedTokenCount < statistics[0].preScannedTokenCount);
+        remove(cacheFiles[0]);
+        remove(cacheFiles[2]);
+    }
+
+    // RegExp cache test
+    {
+        const char* script = "for (var i = 0; i < 3; i++) { new RegExp('a' + i); new RegExp('a' + i, 'g'); } new RegExp('a' + 2).test('a2')";
+        Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII("RegExpCache.js")).m_script;
+        vm->setRegExpCacheLimit(2, 1024 * 1024);
+        Escargot::VMInstanceRef::RegExpCacheStatistics before = vm->regexpCacheStatistics();
+        Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+        sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+            return scriptRef->execute(state);
+        });
+        sb->destroy();
+        Escargot::VMInstanceRef::RegExpCacheStatistics after = vm->regexpCacheStatistics();
+
+        CHECK("RegExp cache limit", after.entryCount <= 2);
+        CHECK("RegExp cache hit", after.hitCount - before.hitCount >= 4);
+        CHECK("RegExp cache eviction", after.evictionCount > before.evictionCount);
+        vm->setRegExpCacheLimit(256, 1024 * 1024 * 2);
+    }
+
+    // JSON to UTF-8 test
+    {
+        const char* script = "var o = { a: [1, 2.5, 'x\\n', null], b: { c: '\\u00e9\\u4e2d\\ud83d\\ude00' } }; o";
+        Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII("JSON.js")).m_script;
+        Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+        std::string fast, generic, undefined;
+        sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+            Escargot::GlobalObjectRef* global = ctx->globalObject();
+            Escargot::ValueRef* value = scriptRef->execute(state);
+            fast = global->jsonStringifyToUTF8(state, value);
+            generic = global->jsonStringify()->call(state, Escargot::ValueRef::create(global), 1, &value)->toString(state)->toStdUTF8String();
+            undefined = global->jsonStringifyToUTF8(state, Escargot::ValueRef::createUndefined());
+            return value;
+        });
+        sb->destroy();
+
+        CHECK("JSON to UTF-8 1", fast == "{\"a\":[1,2.5,\"x\\n\",null],\"b\":{\"c\":\"\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80\"}}");
+        CHECK("JSON to UTF-8 2", fast == generic);
+        CHECK("JSON to UTF-8 3", undefined.empty());
+    }
+
+#ifdef ESCARGOT_ENABLE_PROMISE
+    // job queue drain test
+    {
+        const char* script = "var log = []; for (var i = 0; i < 5; i++) { Promise.resolve(i).then(function(v) { log.push(v); }); } log.length";
+        Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII("JobQueue.js")).m_script;
+        Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+        std::string queued;
+        sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+            Escargot::ValueRef* value = scriptRef->execute(state);
+            queued = value->toString(state)->toStdUTF8String();
+            return value;
+        });
+        sb->destroy();
+
+        Escargot::VMInstanceRef::DrainJobQueueResult first = vm->drainJobQueue(2, 0);
+        Escargot::VMInstanceRef::DrainJobQueueResult second = vm->drainJobQueue(2, 0);
+        Escargot::VMInstanceRef::DrainJobQueueResult rest = vm->drainJobQueue(0, 0);
+        Escargot::ValueRef* log = globalObject->get(es, Escargot::ValueRef::create(Escargot::StringRef::fromASCII("log")));
+        std::string order = log->toString(es)->toStdUTF8String();
+
+        CHECK("Job queue drain 1", queued == "0");
+        CHECK("Job queue drain 2", first.error == Escargot::ValueRef::createEmpty() && first.executedJobCount == 2 && first.remainingJobCount == 3);
+        CHECK("Job queue drain 3", second.error == Escargot::ValueRef::createEmpty() && second.executedJobCount == 2 && second.remainingJobCount == 1);
+        CHECK("Job queue drain 4", rest.error == Escargot::ValueRef::createEmpty() && rest.executedJobCount == 1 && rest.remainingJobCount == 0);
+        CHECK("Job queue drain 5", order == "0,1,2,3,4");
+    }
+#endif
+
+    // context snapshot test
+    {
+        auto evalInContext = [](Escargot::ContextRef* context, const char* script) -> std::string {
+            Escargot::ScriptRef* scriptRef = context->scriptParser()->parse(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII("ContextSnapshot.js")).m_script;
+            Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(context);
+            std::string result;
+            auto sandBoxResult = sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+                Escargot::ValueRef* value = scriptRef->execute(state);
+                result = value->toString(state)->toStdUTF8String();
+                return value;
+            });
+            sb->destroy();
+            return result;
+        };
+
+        Escargot::ContextSnapshotRef* snapshot = Escargot::ContextSnapshotRef::create(vm);
+        CHECK("ContextSnapshot is created", snapshot);
+        if (snapshot) {
+            Escargot::ContextRef* ctx1 = Escargot::ContextRef::create(vm, snapshot);
+            Escargot::ContextRef* ctx2 = Escargot::ContextRef::create(vm, snapshot);
+            Escargot::ContextRef* ctx3 = Escargot::ContextRef::create(vm);
+
+            const char* builtinScript = "[1, 2, 3].map(function(x) { return x * 2 }).join() + JSON.stringify({ a: /(b)/.test('abc') }) + RegExp.$1 + (new TypeError('e') instanceof Error) + (Object.getPrototypeOf(Array.prototype) === Object.prototype)";
+            CHECK("ContextSnapshot builtins 1", evalInContext(ctx1, builtinScript) == "2,4,6{\"a\":true}btruetrue");
+            CHECK("ContextSnapshot builtins 2", evalInContext(ctx2, builtinScript) == "2,4,6{\"a\":true}btruetrue");
+
+            CHECK("ContextSnapshot isolation 1", evalInContext(ctx1, "Array.prototype.foo = 1; Math.bar = 2; [].foo + Math.bar") == "3");
+            CHECK("ContextSnapshot isolation 2", evalInContext(ctx2, "typeof [].foo + typeof Math.bar") == "undefinedundefined");
+
+            const char* namesScript = "Object.getOwnPropertyNames(this).join() + Object.getOwnPropertyNames(Object.prototype).join() + Object.getOwnPropertyNames(Array.prototype).join()";
+            CHECK("ContextSnapshot global properties", evalInContext(ctx2, namesScript) == evalInContext(ctx3, namesScript));
+
+            ctx1->destroy();
+            ctx2->destroy();
+            ctx3->destroy();
+            snapshot->destroy();
+        }
+    }
+
     es->destroy();
     ctx->destroy();
     vm->destroy();
@@ -0,0 +1,65 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var arr = [1.5, 2, -0, NaN, , Infinity];
+assert(arr.length === 6);
+assert(arr[0] === 1.5);
+assert(arr[1] === 2);
+assert(1 / arr[2] === -Infinity);
+assert(arr[3] !== arr[3]);
+assert(!(4 in arr));
+assert(arr[4] === undefined);
+assert(arr[5] === Infinity);
+
+var f64 = new Float64Array([NaN]);
+new Uint32Array(f64.buffer)[0] = 0xDEAD;
+new Uint32Array(f64.buffer)[1] = 0x7FFC0000;
+arr[4] = f64[0];
+assert(4 in arr);
+assert(arr[4] !== arr[4]);
+
+delete arr[0];
+assert(!(0 in arr));
+assert(Object.keys(arr).join() === "1,2,3,4,5");
+
+arr.length = 10;
+arr[8] = 0.25;
+assert(arr[7] === undefined);
+assert(arr[8] === 0.25);
+
+// storing a non-number value keeps every element
+var o = {};
+arr[9] = o;
+assert(arr[9] === o);
+assert(arr[1] === 2);
+assert(1 / arr[2] === -Infinity);
+assert(!(0 in arr));
+assert(arr[8] === 0.25);
+
+var sorted = [3.5, 1.25, 2, 0.5].sort();
+assert(sorted.join() === "0.5,1.25,2,3.5");
+
+var sum = 0;
+var numbers = new Array(100);
+for (var i = 0; i < numbers.length; i++)
+  numbers[i] = i / 2;
+for (var i = 0; i < numbers.length; i++)
+  sum += numbers[i];
+assert(sum === 2475);
+numbers.length = 0;
+numbers.push("str");
+assert(numbers[0] === "str");
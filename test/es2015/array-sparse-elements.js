@@ -0,0 +1,91 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var arr = [1, 2, 3];
+arr[4000000000] = "far";
+assert(arr.length === 4000000001);
+assert(arr[4000000000] === "far");
+assert(arr[1] === 2);
+assert(arr[5] === undefined);
+assert(Object.keys(arr).join() === "0,1,2,4000000000");
+
+arr[2] = "three";
+assert(arr[2] === "three");
+assert(delete arr[1]);
+assert(!(1 in arr));
+assert(Object.keys(arr).join() === "0,2,4000000000");
+
+arr.length = 3;
+assert(arr.length === 3);
+assert(!(4000000000 in arr));
+assert(Object.keys(arr).join() === "0,2");
+
+var sparse = [];
+sparse[3000000] = 1;
+sparse[2000000] = 3;
+sparse[1000000] = 2;
+sparse.sort();
+assert(sparse.length === 3000001);
+assert(sparse[0] === 1 && sparse[1] === 2 && sparse[2] === 3);
+assert(!(1000000 in sparse));
+assert(Object.keys(sparse).join() === "0,1,2");
+
+// elements with non-default attributes are kept as ordinary properties
+Object.defineProperty(sparse, 5000000, { value: "fixed", writable: false, enumerable: true, configurable: false });
+assert(sparse.length === 5000001);
+assert(sparse[5000000] === "fixed");
+assertThrows(function() { sparse[5000000] = "changed"; });
+assert(sparse[5000000] === "fixed");
+assert(Object.keys(sparse).join() === "0,1,2,5000000");
+
+var frozen = [];
+frozen[2000000] = 1;
+Object.freeze(frozen);
+assertThrows(function() { frozen[2000000] = 2; });
+assertThrows(function() { frozen[1] = 1; });
+assert(frozen[2000000] === 1);
+assert(!(1 in frozen));
+
+var fixedLength = [];
+fixedLength[2000000] = 1;
+Object.defineProperty(fixedLength, "length", { writable: false });
+assertThrows(function() { fixedLength[2000001] = 1; });
+assert(fixedLength.length === 2000001);
+assert(!(2000001 in fixedLength));
+
+var nonExtensible = [];
+nonExtensible[2000000] = 1;
+Object.preventExtensions(nonExtensible);
+assertThrows(function() { nonExtensible[0] = 1; });
+assert(!(0 in nonExtensible) && nonExtensible.length === 2000001);
+nonExtensible[2000000] = 2;
+assert(nonExtensible[2000000] === 2);
+
+var sealed = [];
+sealed[2000000] = 1;
+Object.seal(sealed);
+assertThrows(function() { sealed[0] = 1; });
+assert(!(0 in sealed) && sealed.length === 2000001);
+sealed[2000000] = 2;
+assert(sealed[2000000] === 2);
+
+var frozenNoAdd = [];
+frozenNoAdd[2000000] = 1;
+Object.freeze(frozenNoAdd);
+assertThrows(function() { frozenNoAdd[0] = 1; });
+assert(!(0 in frozenNoAdd) && frozenNoAdd.length === 2000001);
+assert(frozenNoAdd[2000000] === 1);
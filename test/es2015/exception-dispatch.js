@@ -0,0 +1,183 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var count = 0;
+for (var i = 0; i < 1000; i++) {
+  try {
+    if (i % 2)
+      throw i;
+  } catch (e) {
+    count += e;
+  }
+}
+assert(count === 250000);
+
+function rethrow() {
+  var log = '';
+  try {
+    try {
+      throw new Error('inner');
+    } finally {
+      log += 'f';
+    }
+  } catch (e) {
+    log += e.message;
+    try {
+      throw e;
+    } catch (e2) {
+      log += (e2 === e);
+    }
+  }
+  return log;
+}
+assert(rethrow() === 'finnertrue');
+
+function throwFromCatch() {
+  try {
+    try {
+      throw 1;
+    } catch (e) {
+      throw e + 1;
+    }
+  } catch (e) {
+    return e;
+  }
+}
+assert(throwFromCatch() === 2);
+
+function callee() {
+  throw new TypeError('callee');
+}
+function fromCallee() {
+  try {
+    callee();
+  } catch (e) {
+    return e instanceof TypeError && typeof e.stack === 'string';
+  }
+}
+assert(fromCallee());
+
+function capture() {
+  var fns = [];
+  for (var i = 0; i < 3; i++) {
+    try {
+      throw i;
+    } catch (e) {
+      fns.push(function () { return e; });
+    }
+  }
+  return fns[0]() + fns[1]() + fns[2]();
+}
+assert(capture() === 3);
+
+function finallyReturn() {
+  try {
+    throw 1;
+  } finally {
+    return 'f';
+  }
+}
+assert(finallyReturn() === 'f');
+
+var thrown = false;
+try {
+  (function () {
+    try {
+      throw 'escape';
+    } finally {
+      count = 0;
+    }
+  })();
+} catch (e) {
+  thrown = e === 'escape' && count === 0;
+}
+assert(thrown);
+
+function depth(n) {
+  if (n === 0)
+    throw new RangeError('deep');
+  return depth(n - 1) + 1;
+}
+function fromDeepCallee() {
+  try {
+    depth(20);
+  } catch (e) {
+    return e instanceof RangeError && e.message === 'deep';
+  }
+}
+assert(fromDeepCallee());
+
+var obj = {
+  log: '',
+  method: function () {
+    try {
+      throw 'inner';
+    } catch (e) {
+      this.log += e;
+    } finally {
+      this.log += 'f';
+    }
+    throw 'outer';
+  }
+};
+function fromMethod() {
+  try {
+    obj.method();
+  } catch (e) {
+    obj.log += e;
+  }
+  return obj.log;
+}
+assert(fromMethod() === 'innerfouter');
+
+function fromCatchCallee() {
+  try {
+    try {
+      throw 1;
+    } catch (e) {
+      callee();
+    }
+  } catch (e) {
+    return e.message;
+  }
+}
+assert(fromCatchCallee() === 'callee');
+
+function fromNativeCallback() {
+  try {
+    [1].forEach(function () { throw 'cb'; });
+  } catch (e) {
+    return e;
+  }
+}
+assert(fromNativeCallback() === 'cb');
+
+function noThrow(a) {
+  return a + 1;
+}
+function callInTry() {
+  var sum = 0;
+  for (var i = 0; i < 100; i++) {
+    try {
+      sum += noThrow(i);
+    } catch (e) {
+      sum = -1;
+    }
+  }
+  return sum;
+}
+assert(callInTry() === 5050);
@@ -0,0 +1,83 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+function keys(o) {
+  var result = [];
+  for (var k in o)
+    result.push(k);
+  return result.join();
+}
+
+var records = [];
+for (var i = 0; i < 10; i++)
+  records.push({ id: i, name: 'n' + i, value: i * 2 });
+for (var i = 0; i < records.length; i++)
+  assert(keys(records[i]) === 'id,name,value');
+
+var proto = { inherited: 1 };
+var a = Object.create(proto);
+a.x = 1;
+var b = { x: 1 };
+assert(keys(a) === 'x,inherited');
+assert(keys(b) === 'x');
+assert(keys(a) === 'x,inherited');
+
+proto.more = 2;
+assert(keys(a) === 'x,inherited,more');
+Object.defineProperty(proto, 'inherited', { enumerable: false });
+assert(keys(a) === 'x,more');
+
+var c = { x: 1 };
+Object.setPrototypeOf(c, proto);
+assert(keys(b) === 'x');
+assert(keys(c) === 'x,more');
+
+Object.defineProperty(b, 'x', { enumerable: false });
+assert(keys(b) === '');
+assert(keys({ x: 1 }) === 'x');
+
+Object.prototype.polluted = 1;
+assert(keys({ x: 1 }) === 'x,polluted');
+delete Object.prototype.polluted;
+assert(keys({ x: 1 }) === 'x');
+
+var d = { p: 1, q: 2, r: 3 };
+var visited = [];
+for (var k in d) {
+  visited.push(k);
+  if (k === 'p')
+    delete d.q;
+}
+assert(visited.join() === 'p,r');
+assert(keys({ p: 1, q: 2, r: 3 }) === 'p,q,r');
+
+// different prototype objects with same shape share cached keys
+var protoA = { shared: 1 };
+var protoB = { shared: 2 };
+var e = Object.create(protoA);
+e.own = 1;
+var f = Object.create(protoB);
+f.own = 1;
+assert(keys(e) === 'own,shared');
+assert(keys(f) === 'own,shared');
+var g = Object.create({ other: 1 });
+g.own = 1;
+assert(keys(g) === 'own,other');
+var h = Object.create([7]);
+h.own = 1;
+assert(keys(h) === 'own,0');
+assert(keys(f) === 'own,shared');
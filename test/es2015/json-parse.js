@@ -0,0 +1,71 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+function throwsSyntaxError(text) {
+    try {
+        JSON.parse(text);
+    } catch (e) {
+        return e instanceof SyntaxError;
+    }
+    return false;
+}
+
+var records = JSON.parse('[{"id":1,"name":"a","tags":["x"]},{"id":2,"name":"b","tags":[]},{"name":"c","id":3},{"id":4,"name":"d","tags":null,"extra":true}]');
+assert(records.length === 4);
+assert(records[0].id === 1 && records[0].name === "a" && records[0].tags[0] === "x");
+assert(records[1].id === 2 && records[1].tags.length === 0);
+assert(Object.keys(records[2]).join() === "name,id");
+assert(Object.keys(records[3]).join() === "id,name,tags,extra");
+assert(records[3].tags === null && records[3].extra === true);
+records[0].id = 10;
+assert(records[1].id === 2);
+records[1].added = 1;
+assert(records[0].added === undefined);
+
+var duplicated = JSON.parse('[{"a":1,"b":2},{"a":3,"a":4}]');
+assert(Object.keys(duplicated[1]).join() === "a" && duplicated[1].a === 4);
+
+assert(JSON.parse('"\\u0041\\n\\t\\"\\\\\\/"') === "A\n\t\"\\/");
+assert(JSON.parse('"caf\u00e9"') === "caf\u00e9");
+assert(JSON.parse('"\u3042\\u3044"') === "\u3042\u3044");
+assert(JSON.parse('{"\u00e9":1,"\\u00e9x":2}')["\u00e9x"] === 2);
+assert(JSON.parse('"\\ud800"').charCodeAt(0) === 0xd800);
+
+assert(JSON.parse("0") === 0);
+assert(1 / JSON.parse("-0") === -Infinity);
+assert(JSON.parse("-123") === -123);
+assert(JSON.parse("1.5e3") === 1500);
+assert(JSON.parse("123456789012345678901") === 123456789012345678901);
+assert(JSON.parse("0.1") === 0.1);
+assert(JSON.parse(" \t\r\n[ 1 , 2 ]\n ").length === 2);
+
+["", " ", "01", "1.", "1e", "-", "[1,]", "{\"a\":1,}", "{a:1}", "[1 2]", "\"\\x\"", "\"\\u12G4\"", "\"abc", "tru", "nul", "1 2", "\"\t\""].forEach(function (text) {
+    assert(throwsSyntaxError(text));
+});
+
+var big = [];
+for (var i = 0; i < 1000; i++) {
+    big.push({ index: i, label: "item" + i, value: i / 2 });
+}
+var parsed = JSON.parse(JSON.stringify(big));
+assert(parsed.length === 1000);
+assert(parsed[999].index === 999 && parsed[999].label === "item999" && parsed[999].value === 499.5);
+
+var revived = JSON.parse('{"a":[1,2],"b":{"c":3}}', function (key, value) {
+    return typeof value === "number" ? value * 2 : value;
+});
+assert(revived.a[1] === 4 && revived.b.c === 6);
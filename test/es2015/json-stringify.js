@@ -0,0 +1,82 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+// objects of same shape share the cached keys
+var list = [];
+for (var i = 0; i < 3; i++) {
+  list.push({ id: i, name: 'n' + i, ok: i % 2 == 0, none: null });
+}
+assert(JSON.stringify(list) === '[{"id":0,"name":"n0","ok":true,"none":null},{"id":1,"name":"n1","ok":false,"none":null},{"id":2,"name":"n2","ok":true,"none":null}]');
+
+// skipped values and numbers
+assert(JSON.stringify({ a: undefined, b: function() {}, c: Symbol('c'), d: 1 }) === '{"d":1}');
+assert(JSON.stringify([undefined, Symbol('s'), NaN, -Infinity, -0, 1.5, -7, 1e21]) === '[null,null,null,null,0,1.5,-7,1e+21]');
+assert(JSON.stringify([1.25, 2.5, 3.75]) === '[1.25,2.5,3.75]');
+assert(JSON.stringify({}) === '{}');
+assert(JSON.stringify([]) === '[]');
+
+// escapes and wide characters in keys and values
+assert(JSON.stringify({ 'k"\\\n': 'a\tb\u0001é' }) === '{"k\\"\\\\\\n":"a\\tb\\u0001é"}');
+assert(JSON.stringify(['中', 'x']) === '["中","x"]');
+
+// non-enumerable and symbol keys
+var o = { a: 1 };
+Object.defineProperty(o, 'hidden', { value: 2, enumerable: false });
+o[Symbol('s')] = 3;
+assert(JSON.stringify(o) === '{"a":1}');
+
+// gap
+assert(JSON.stringify({ a: [1, { b: 2 }], c: {} }, null, 2) === '{\n  "a": [\n    1,\n    {\n      "b": 2\n    }\n  ],\n  "c": {}\n}');
+assert(JSON.stringify([[]], null, '--') === '[\n--[]\n]');
+
+// getters, toJSON, holes and replacers go through the generic algorithm
+var getterCalled = 0;
+assert(JSON.stringify({ a: 1, get b() { getterCalled++; return 2; } }) === '{"a":1,"b":2}');
+assert(getterCalled === 1);
+assert(JSON.stringify({ a: { toJSON: function(key) { return key + '!'; } } }) === '{"a":"a!"}');
+assert(JSON.stringify([1, , 3]) === '[1,null,3]');
+assert(JSON.stringify({ a: 1, b: 2 }, ['b']) === '{"b":2}');
+assert(JSON.stringify({ a: 1, b: 2 }, function(k, v) { return k === 'a' ? undefined : v; }) === '{"b":2}');
+assert(JSON.stringify({ a: new Number(3), b: new String('s'), c: new Boolean(false) }) === '{"a":3,"b":"s","c":false}');
+assert(JSON.stringify(Object.create(null)) === '{}');
+
+Object.prototype.toJSON = function() { return 'proto'; };
+assert(JSON.stringify({ a: 1 }) === '"proto"');
+delete Object.prototype.toJSON;
+Array.prototype.toJSON = function() { return 'array'; };
+assert(JSON.stringify({ a: [1] }) === '{"a":"array"}');
+delete Array.prototype.toJSON;
+assert(JSON.stringify({ a: [1] }) === '{"a":[1]}');
+
+// cycles
+var cyclic = { a: [] };
+cyclic.a.push(cyclic);
+var thrown = false;
+try {
+  JSON.stringify(cyclic);
+} catch (e) {
+  thrown = e instanceof TypeError;
+}
+assert(thrown);
+
+// shapes changed after they are stringified
+var p = { x: 1, y: 2 };
+assert(JSON.stringify(p) === '{"x":1,"y":2}');
+Object.defineProperty(p, 'y', { enumerable: false });
+assert(JSON.stringify(p) === '{"x":1}');
+p.z = 3;
+assert(JSON.stringify(p) === '{"x":1,"z":3}');
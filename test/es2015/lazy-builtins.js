@@ -0,0 +1,44 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var global = this;
+var names = Object.getOwnPropertyNames(global);
+assert(names.indexOf("WeakMap") !== -1);
+assert(names.indexOf("Int8Array") !== -1);
+assert(names.indexOf("DataView") !== -1);
+
+var desc = Object.getOwnPropertyDescriptor(global, "WeakSet");
+assert(typeof desc.value === "function");
+assert(desc.writable && !desc.enumerable && desc.configurable);
+assert(new WeakSet() instanceof WeakSet);
+
+// deleting one builtin of a family should not affect the others
+assert(delete global.Uint16Array);
+assert(!("Uint16Array" in global));
+assert(new Int8Array(2).length === 2);
+assert(!("Uint16Array" in global));
+assert(Object.getPrototypeOf(Int8Array.prototype) === Object.getPrototypeOf(Float64Array.prototype));
+
+// assignment before the first access
+Reflect = 1;
+assert(Reflect === 1);
+assert(typeof Proxy === "function");
+
+Object.defineProperty(global, "WeakMap", { value: 2, writable: false });
+assert(WeakMap === 2);
+assert(typeof Promise === "function");
+assert(Promise.resolve(1) instanceof Promise);
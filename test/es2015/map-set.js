@@ -126,3 +126,47 @@ assert(set.has(-1 / Infinity));
   assert(iter === iter[Symbol.iterator]());
   assert(iter[Symbol.iterator].name === '[Symbol.iterator]');
 })();
+
+(function TestLargeMapWithDeletesDuringIteration() {
+  var map = new Map();
+  for (var i = 0; i < 1000; i++) {
+    map.set(i, i * 2);
+    map.set('key' + i, i);
+  }
+  assert(map.size === 2000);
+  assert(map.get(999) === 1998);
+  assert(map.get('key' + 500) === 500);
+  assert(map.get(1000.5) === undefined);
+
+  var iter = map.keys();
+  assert(iter.next().value === 0);
+  for (var i = 1; i < 1000; i++) {
+    map.delete('key' + i);
+    map.delete(i);
+  }
+  assert(map.size === 1);
+  assert(iter.next().value === 'key0');
+  map.set(-0, 'zero');
+  map.set('fresh', 1);
+  var step = iter.next();
+  assert(step.value === 'fresh' && !step.done);
+  assert(map.get(0) === 'zero');
+  assert(iter.next().done);
+
+  var set = new Set();
+  for (var i = 0; i < 100; i++) {
+    set.add(i + 0.5);
+  }
+  var visited = 0;
+  set.forEach(function (v) {
+    visited++;
+    if (v === 0.5) {
+      for (var i = 1; i < 99; i++) {
+        set.delete(i + 0.5);
+      }
+    }
+  });
+  assert(visited === 2);
+  set.clear();
+  assert(set.size === 0 && !set.has(99.5));
+})();
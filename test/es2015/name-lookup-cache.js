@@ -0,0 +1,78 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+var x = "global";
+
+function outer(addVar) {
+    if (addVar)
+        eval("var x = 'eval'");
+    return function(v) {
+        if (v !== undefined)
+            x = v;
+        return x;
+    };
+}
+
+var f1 = outer(false);
+var f2 = outer(true);
+for (var i = 0; i < 3; i++) {
+    assert(f1() === "global");
+    assert(f2() === "eval");
+}
+
+var f3 = outer(true);
+var f4 = outer(false);
+for (var i = 0; i < 3; i++) {
+    assert(f3() === "eval");
+    assert(f4() === "global");
+}
+
+assert(f3("changed") === "changed");
+assert(f2() === "eval");
+assert(x === "global");
+assert(f4("changed") === "changed");
+assert(x === "changed");
+x = "global";
+
+function withScope(obj) {
+    eval("");
+    var y = "local";
+    return function() {
+        with (obj) {
+            return y;
+        }
+    };
+}
+
+var o = {};
+var g = withScope(o);
+assert(g() === "local");
+o.y = "object";
+assert(g() === "object");
+delete o.y;
+assert(g() === "local");
+
+function lateEval() {
+    var f = function() { return x; };
+    var results = [f()];
+    eval("var x = 'late'");
+    results.push(f());
+    eval("delete x");
+    results.push(f());
+    return results.join();
+}
+
+for (var i = 0; i < 3; i++)
+    assert(lateEval() === "global,late,global");
@@ -0,0 +1,75 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+function getX(o) {
+    return o.x;
+}
+
+// monomorphic, polymorphic and megamorphic sites
+var shapes = [];
+for (var i = 0; i < 12; i++) {
+    var o = {};
+    o["p" + i] = i;
+    o.x = i;
+    shapes.push(o);
+}
+for (var round = 0; round < 4; round++) {
+    for (var i = 0; i < shapes.length; i++)
+        assert(getX(shapes[i]) === i);
+}
+
+// property on prototype, then shadowed by own property
+var proto = { x: "proto" };
+var child = Object.create(proto);
+for (var i = 0; i < 5; i++)
+    assert(getX(child) === "proto");
+proto.x = "changed";
+assert(getX(child) === "changed");
+child.x = "own";
+assert(getX(child) === "own");
+
+// same structure with different prototypes
+var a = Object.create({ x: 1 });
+var b = Object.create({ x: 2 });
+for (var i = 0; i < 5; i++) {
+    assert(getX(a) === 1);
+    assert(getX(b) === 2);
+}
+
+// absent property becomes present on the prototype chain
+var base = {};
+var derived = Object.create(Object.create(base));
+for (var i = 0; i < 5; i++)
+    assert(getX(derived) === undefined);
+base.x = "base";
+assert(getX(derived) === "base");
+
+var empty = Object.create(null);
+for (var i = 0; i < 5; i++)
+    assert(getX(empty) === undefined);
+Object.setPrototypeOf(empty, { x: "late" });
+assert(getX(empty) === "late");
+
+// getters and proxies in the chain
+var withGetter = Object.create({ get x() { return this.y; } });
+withGetter.y = 42;
+var viaProxy = Object.create(new Proxy({}, { get: function(t, k, r) { return k === "x" ? "proxy" : undefined; } }));
+for (var i = 0; i < 5; i++) {
+    assert(getX(withGetter) === 42);
+    assert(getX(viaProxy) === "proxy");
+    assert(getX("str") === undefined);
+}
@@ -0,0 +1,96 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+function same(a, b) {
+    if (a === null || b === null)
+        return a === b;
+    if (a.length !== b.length || a.index !== b.index)
+        return false;
+    for (var i = 0; i < a.length; i++) {
+        if (a[i] !== b[i])
+            return false;
+    }
+    return true;
+}
+
+function check(re, input, expected, index) {
+    var result = re.exec(input);
+    if (expected !== null)
+        expected.index = index;
+    assert(same(result, expected));
+}
+
+// captures and quantifiers
+check(/(a+)(b*)c/, "xaabbc", ["aabbc", "aa", "bb"], 1);
+check(/(a*)*b/, "aaab", ["aaab", "aaa"], 0);
+check(/(a|ab)(c|bcd)(d*)/, "abcd", ["abcd", "a", "bcd", ""], 0);
+check(/a{2,3}/, "aaaa", ["aaa"], 0);
+check(/a{2,3}?/, "aaaa", ["aa"], 0);
+check(/(.*?)bar/, "foobarbar", ["foobar", "foo"], 0);
+check(/(.*)bar/, "foobarbar", ["foobarbar", "foobar"], 0);
+check(/x{2,}/, "xxyxxx", ["xx"], 0);
+check(/(?:ab){2}/, "abababx", ["abab"], 0);
+
+// captures inside repetition are reset on each iteration
+check(/(z)((a+)?(b+)?(c))*/, "zaacbbbcac", ["zaacbbbcac", "z", "ac", "a", undefined, "c"], 0);
+check(/(?:(a)|b)+/, "ab", ["ab", undefined], 0);
+
+// empty iterations
+check(/()+/, "x", ["", ""], 0);
+check(/(a?)+?b/, "ab", ["ab", "a"], 0);
+check(/(?:a*)*/, "b", [""], 0);
+
+// anchors and word boundaries
+check(/^b/, "a\nb", null);
+check(/^b/m, "a\nb", ["b"], 2);
+check(/a$/m, "a\nb", ["a"], 0);
+check(/^(?:a|b)+$/, "abab", ["abab"], 0);
+check(/\bfoo\b/, "a foo b", ["foo"], 2);
+check(/\Boo\B/, "a foo", null);
+check(/\Bo/, "a fool", ["o"], 3);
+
+// character classes
+check(/[a-c]+/, "xxbcay", ["bca"], 2);
+check(/[^a-c]+/, "abxyc", ["xy"], 2);
+check(/[\d\s]+/, "ab1 2c", ["1 2"], 2);
+check(/[-a]+/, "b-a-", ["-a-"], 1);
+check(/[]/, "a", null);
+check(/[^]+/, "a\nb", ["a\nb"], 0);
+check(/.+/, "a\nb", ["a"], 0);
+check(/\w+/, "  hello_1 ", ["hello_1"], 2);
+check(/a\x62/, "cab", ["ab"], 1);
+check(/[\b]/, "a\bb", ["\b"], 1);
+
+// 16-bit input
+check(/あ+(\w)/, "ぁああx", ["ああx", "x"], 1);
+check(/[぀-ぐ]+/, "aぁあb", ["ぁあ"], 1);
+check(/\s/, "a　b", ["　"], 1);
+
+// patterns which are left to the interpreter
+check(/(a)\1/, "baa", ["aa", "a"], 1);
+check(/a(?=b)/, "acab", ["a"], 2);
+check(/A+/i, "baA", ["aA"], 1);
+
+// global matching keeps lastIndex
+var re = /(\d+)-/g;
+var all = [];
+var m;
+while ((m = re.exec("1-22-333-")) !== null)
+    all.push(m[1]);
+assert(all.join() === "1,22,333");
+assert("a1b22c".replace(/\d+/g, "#") === "a#b#c");
+assert("a,b;;c".split(/[,;]+/).join() === "a,b,c");
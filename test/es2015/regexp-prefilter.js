@@ -0,0 +1,58 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var long = "";
+for (var i = 0; i < 200; i++)
+    long += "xxxxxxxx";
+
+// literal prefixes
+assert((long + "foo12" + long + "foo" + long + "foo3").match(/foo\d+/g).join() === "foo12,foo3");
+assert("a-foo1-foo-foo22".replace(/foo(\d+)/g, "<$1>") === "a-<1>-foo-<22>");
+assert("afoobfoo".split(/foo/).join() === "a,b,");
+assert(/\bbar/.exec("foobar bar").index === 7);
+assert(/(?=ab)abc/.exec("abxabc").index === 3);
+assert(/fo+x/.exec("fofoox").index === 2);
+assert(/ab{0,2}c/.exec("abbbcac").index === 5);
+
+// first character sets
+assert("x1y22z".replace(/\d+/g, "#") === "x#y#z");
+assert(/[yz]w/.exec("ywzw".slice(1)).index === 1);
+assert(/(?:b|c)d/.exec("abacd").index === 3);
+assert(/(a)\1x/.exec("aaaax").index === 2);
+assert(/\W\w/.exec("ab-cd").index === 2);
+assert(/[^a]b/.exec("aabab") === null);
+assert(/[^a]b/.exec("aababxb").index === 5);
+
+// ignoreCase
+assert("Foo fOO foo".match(/foo/gi).length === 3);
+assert(/[a-c]x/i.exec("zzBX").index === 2);
+assert(/é/i.exec("aÉ").index === 1);
+
+// anchors
+assert(/^ab/.exec("xab") === null);
+assert("ab\nab\r\nab".match(/^ab/gm).length === 3);
+assert("ab\nab".replace(/^/gm, "#") === "#ab\n#ab");
+assert(/^\d/m.exec("a\nb\n1").index === 4);
+
+// patterns which can match empty string are not filtered
+assert("abc".replace(/x*/g, "-") === "-a-b-c-");
+assert("abc".split(/(?:)/).join() === "a,b,c");
+
+// 16-bit input and prefixes
+assert(/あい+/.exec("ああいい").index === 1);
+assert("がぎぐ".replace(/ぎ/g, "x") === "がxぐ");
+assert(/ab/.exec("あab").index === 1);
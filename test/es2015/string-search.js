@@ -0,0 +1,70 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+function naiveIndexOf(s, t, pos) {
+    for (var i = Math.max(pos, 0); i + t.length <= s.length; i++) {
+        if (s.substr(i, t.length) === t)
+            return i;
+    }
+    return t.length === 0 ? Math.min(Math.max(pos, 0), s.length) : -1;
+}
+
+function naiveLastIndexOf(s, t, pos) {
+    for (var i = Math.min(pos, s.length - t.length); i >= 0; i--) {
+        if (s.substr(i, t.length) === t)
+            return i;
+    }
+    return -1;
+}
+
+var haystacks = [
+    "abababababababababababababababababababcabababababababab",
+    "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab",
+    "あaあbあaあbあaあbあaあbあaあbあcあb",
+    "xéyéxéyéxéyéxéyéxéyéxéz",
+];
+var needles = ["", "a", "b", "c", "ab", "abc", "bab", "aab", "あ", "あb", "あcあ", "é", "éz", "ā", "xéy"];
+
+haystacks.forEach(function (s) {
+    needles.forEach(function (t) {
+        for (var pos = -1; pos <= s.length + 1; pos += 3) {
+            assert(s.indexOf(t, pos) === naiveIndexOf(s, t, pos));
+            assert(s.includes(t, pos) === (naiveIndexOf(s, t, pos) !== -1));
+            assert(s.lastIndexOf(t, pos) === naiveLastIndexOf(s, t, Math.max(pos, 0)));
+        }
+        assert(s.startsWith(t) === (s.substr(0, t.length) === t));
+        assert(s.endsWith(t) === (s.substr(s.length - t.length) === t));
+    });
+});
+
+var longNeedle = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEF";
+var longHaystack = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEE".repeat(100) + longNeedle + "tail";
+assert(longHaystack.indexOf(longNeedle) === 4200);
+assert(longHaystack.lastIndexOf(longNeedle) === 4200);
+assert(longHaystack.indexOf(longNeedle, 4201) === -1);
+assert(("あ" + longHaystack).indexOf(longNeedle) === 4201);
+
+assert("a,b,,c".split(",").join("|") === "a|b||c");
+assert("a, b, c".split(", ", 2).join("|") === "a|b");
+assert("abc".split("").join("|") === "a|b|c");
+assert("".split("").length === 0);
+assert("".split(",").length === 1);
+assert("あ--い--".split("--").join("|") === "あ|い|");
+assert("x--y".split("あ").join("|") === "x--y");
+
+assert("a-b-c".replace("-", "+") === "a+b-c");
+assert("あ-b".replace("b", "c") === "あ-c");
@@ -0,0 +1,80 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var unit = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ-_";
+
+function collect() {
+    for (var i = 0; i < 100; i++) {
+        new Array(10000).fill("garbage" + i);
+    }
+    gc();
+    gc();
+}
+
+// views are not touched until their parent is dropped and collected,
+// so they are still unflattened when the parent is found unreachable
+var text = unit.repeat(4096);
+var views = [];
+for (var i = 0; i < 1000; i++) {
+    var start = (i * 37) % (text.length - 100);
+    views.push(text.substring(start, start + 40 + (i % 20)));
+}
+text = null;
+collect();
+
+for (var i = 0; i < 1000; i++) {
+    var start = (i * 37) % (unit.length * 4096 - 100);
+    var view = views[i];
+    assert(view.length === 40 + (i % 20));
+    for (var j = 0; j < view.length; j++) {
+        assert(view.charCodeAt(j) === unit.charCodeAt((start + j) % unit.length));
+    }
+}
+
+var pattern = unit.repeat(4096);
+for (var i = 0; i < 1000; i++) {
+    var start = (i * 37) % (pattern.length - 100);
+    assert(views[i] === pattern.substring(start, start + 40 + (i % 20)));
+}
+pattern = null;
+
+// hashing a view flattens it before its parent is dropped
+text = unit.repeat(4096);
+var keys = new Map();
+for (var i = 0; i < 1000; i++) {
+    var start = (i * 37) % (text.length - 100);
+    keys.set(text.substring(start, start + 40 + (i % 20)), i);
+}
+text = null;
+collect();
+
+pattern = unit.repeat(4096);
+for (var i = 0; i < 1000; i++) {
+    var start = (i * 37) % (pattern.length - 100);
+    var expected = pattern.substring(start, start + 40 + (i % 20));
+    assert(keys.has(expected));
+}
+
+var wide = "あいうえお".repeat(20000);
+var part = wide.substring(100, 160);
+wide = null;
+collect();
+assert(part.length === 60);
+assert(part.charCodeAt(0) === 0x3042);
+assert(part.charAt(59) === "お");
+assert(part.indexOf("う") === 2);
+assert(part + "" === "あいうえお".repeat(12));
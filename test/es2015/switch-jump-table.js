@@ -0,0 +1,104 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+function dense(v) {
+  switch (v) {
+    case 0: return 'zero';
+    case 1: return 'one';
+    case 2:
+    case 3: return 'two or three';
+    case 5: return 'five';
+    case 1: return 'duplicate';
+    default: return 'default';
+  }
+}
+assert(dense(0) === 'zero');
+assert(dense(1) === 'one');
+assert(dense(2) === 'two or three');
+assert(dense(3) === 'two or three');
+assert(dense(4) === 'default');
+assert(dense(5) === 'five');
+assert(dense(-0) === 'zero');
+assert(dense(1.0) === 'one');
+assert(dense(1.5) === 'default');
+assert(dense('1') === 'default');
+assert(dense(NaN) === 'default');
+assert(dense(undefined) === 'default');
+assert(dense(2147483647) === 'default');
+assert(dense(-2147483648) === 'default');
+
+function fallthrough(v) {
+  var log = '';
+  switch (v) {
+    case 10: log += 'a';
+    default: log += 'd';
+    case 11: log += 'b';
+    case 12: log += 'c'; break;
+    case 13: log += 'e';
+  }
+  return log;
+}
+assert(fallthrough(10) === 'adbc');
+assert(fallthrough(11) === 'bc');
+assert(fallthrough(13) === 'e');
+assert(fallthrough(0) === 'dbc');
+
+function strings(v) {
+  switch (v) {
+    case 'add': return 1;
+    case 'sub': return 2;
+    case 'mul': return 3;
+    case 'div': return 4;
+    case '': return 5;
+    case 'add': return 6;
+  }
+  return 0;
+}
+assert(strings('add') === 1);
+assert(strings('su' + 'b') === 2);
+assert(strings('mul') === 3);
+assert(strings('div') === 4);
+assert(strings('') === 5);
+assert(strings('mod') === 0);
+assert(strings(1) === 0);
+assert(strings(new String('add')) === 0);
+
+function sparse(v) {
+  switch (v) {
+    case 1: return 'a';
+    case 100: return 'b';
+    case 10000: return 'c';
+    case 1000000: return 'd';
+  }
+  return 'e';
+}
+assert(sparse(100) === 'b');
+assert(sparse(1000000) === 'd');
+assert(sparse(2) === 'e');
+
+function mixed(v) {
+  switch (v) {
+    case 1: return 'a';
+    case 2: return 'b';
+    case '3': return 'c';
+    case 4: return 'd';
+  }
+  return 'e';
+}
+assert(mixed('3') === 'c');
+assert(mixed(3) === 'e');
+assert(mixed(4) === 'd');
@@ -0,0 +1,108 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+function same(a, b) {
+    if (a.length !== b.length)
+        return false;
+    for (var i = 0; i < a.length; i++) {
+        if (a[i] !== b[i] || 1 / a[i] !== 1 / b[i])
+            return false;
+    }
+    return true;
+}
+
+// set from typed arrays of same and different types
+var i16 = new Int16Array([1, -2, 300, -32768]);
+var u8 = new Uint8Array(6);
+u8.set(i16, 1);
+assert(same(u8, [0, 1, 254, 44, 0, 0]));
+var f32 = new Float32Array(4);
+f32.set(i16);
+assert(same(f32, [1, -2, 300, -32768]));
+var f64 = new Float64Array([1.5, -1.5, NaN, Infinity, 4294967297, -0]);
+var i32 = new Int32Array(6);
+i32.set(f64);
+assert(same(i32, [1, -1, 0, 0, 1, 0]));
+var u32 = new Uint32Array([4294967295, 2147483648]);
+var i8 = new Int8Array(2);
+i8.set(u32);
+assert(same(i8, [-1, 0]));
+new Float64Array(2).set(u32);
+assert(same(new Float64Array(u32), [4294967295, 2147483648]));
+
+// overlapping views of one buffer
+var buffer = new ArrayBuffer(16);
+var bytes = new Uint8Array(buffer);
+for (var i = 0; i < 16; i++)
+    bytes[i] = i;
+new Uint8Array(buffer, 2, 8).set(new Uint8Array(buffer, 0, 8));
+assert(same(bytes.subarray(0, 10), [0, 1, 0, 1, 2, 3, 4, 5, 6, 7]));
+var words = new Uint16Array(buffer, 0, 4);
+words.set(new Uint8Array(buffer, 0, 4));
+assert(same(words, [0, 1, 0, 1]));
+
+// set from arrays
+var arr = [1, 2.5, -3, 70000];
+var target = new Int16Array(5);
+target.set(arr, 1);
+assert(same(target, [0, 1, 2, -3, 4464]));
+target.set([9, "8", { valueOf: function() { return 7; } }]);
+assert(same(target, [9, 8, 7, -3, 4464]));
+var holes = [1, , 3];
+Array.prototype[1] = 42;
+target.set(holes);
+delete Array.prototype[1];
+assert(same(target, [1, 42, 3, -3, 4464]));
+assert(same(new Float32Array([0.5, 1, 2]), [0.5, 1, 2]));
+assert(same(new Uint8Array([1, "x", 3]), [1, 0, 3]));
+
+// constructors from other typed arrays
+assert(same(new Int8Array(new Float64Array([127.9, 128, -129])), [127, -128, 127]));
+assert(same(new Float64Array(new Int16Array([-1, 2])), [-1, 2]));
+assert(same(new Uint16Array(new Uint16Array([65535, 1]).subarray(1)), [1]));
+
+// slice
+var source = new Int32Array([1, 2, 3, 4, 5]);
+assert(same(source.slice(1, 4), [2, 3, 4]));
+assert(same(source.slice(-2), [4, 5]));
+assert(source.slice(3, 1).length === 0);
+
+// copyWithin
+assert(same(new Int16Array([1, 2, 3, 4, 5]).copyWithin(1, 0, 3), [1, 1, 2, 3, 5]));
+assert(same(new Float64Array([1, 2, 3, 4, 5]).copyWithin(0, 2), [3, 4, 5, 4, 5]));
+
+// fill
+assert(same(new Uint8Array(4).fill(257, 1, 3), [0, 1, 1, 0]));
+assert(same(new Float32Array(3).fill(0.5), [0.5, 0.5, 0.5]));
+assert(same(new Int32Array(3).fill(-1.9, -1), [0, 0, -1]));
+assert(same(new Int8Array(3).fill("3"), [3, 3, 3]));
+
+// indexOf and lastIndexOf
+var haystack = new Int8Array([1, -1, 0, 5, -1, 0]);
+assert(haystack.indexOf(-1) === 1);
+assert(haystack.indexOf(-1, 2) === 4);
+assert(haystack.indexOf(-0) === 2);
+assert(haystack.indexOf(255) === -1);
+assert(haystack.indexOf(0.5) === -1);
+assert(haystack.lastIndexOf(-1) === 4);
+assert(haystack.lastIndexOf(-1, 3) === 1);
+assert(haystack.lastIndexOf(1, -7) === -1);
+var floats = new Float32Array([0.5, NaN, 0.1]);
+assert(floats.indexOf(NaN) === -1);
+assert(floats.indexOf(0.1) === -1);
+assert(floats.indexOf(Math.fround(0.1)) === 2);
+assert(new Float64Array([Infinity]).lastIndexOf(Infinity) === 0);
@@ -0,0 +1,104 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var i8 = new Int8Array(4);
+var u8 = new Uint8Array(4);
+var i16 = new Int16Array(4);
+var u16 = new Uint16Array(4);
+var i32 = new Int32Array(4);
+var u32 = new Uint32Array(4);
+var f32 = new Float32Array(4);
+var f64 = new Float64Array(4);
+var c8 = new Uint8ClampedArray(4);
+
+// element conversions
+for (var i = 0; i < 4; i++) {
+    i8[i] = 130 + i;
+    u8[i] = -1 - i;
+    i16[i] = 32768 + i;
+    u16[i] = 65536 + i;
+    i32[i] = 2147483648 + i;
+    u32[i] = -1;
+    f32[i] = 0.1;
+    f64[i] = 0.1 * i;
+    c8[i] = i * 10;
+}
+assert(i8[0] === -126 && i8[3] === -123);
+assert(u8[0] === 255 && u8[3] === 252);
+assert(i16[1] === -32767);
+assert(u16[2] === 2);
+assert(i32[0] === -2147483648);
+assert(u32[3] === 4294967295);
+assert(f32[0] === Math.fround(0.1));
+assert(f64[3] === 0.1 * 3);
+assert(c8[2] === 20);
+
+u8[0] = 1.9;
+assert(u8[0] === 1);
+i32[0] = NaN;
+assert(i32[0] === 0);
+f64[0] = NaN;
+assert(isNaN(f64[0]));
+f64[1] = -0;
+assert(1 / f64[1] === -Infinity);
+
+// loops over elements
+var sum = 0;
+var data = new Uint8Array(256);
+for (var i = 0; i < data.length; i++)
+    data[i] = i;
+for (var i = 0; i < data.length; i++)
+    sum += data[i];
+assert(sum === 255 * 128);
+
+// out of bounds and non-index properties
+assert(u8[4] === undefined);
+u8[4] = 1;
+assert(u8[4] === undefined && u8.length === 4);
+assert(u8[-1] === undefined);
+u8[1.5] = 3;
+assert(u8[1.5] === undefined);
+u8["2"] = 7;
+assert(u8[2] === 7 && u8["2"] === 7);
+u8.foo = 1;
+assert(u8.foo === 1);
+
+// values which are not numbers
+var called = 0;
+u16[1] = { valueOf: function() { called++; return 42; } };
+assert(u16[1] === 42 && called === 1);
+u16[2] = "12";
+assert(u16[2] === 12);
+u16[3] = true;
+assert(u16[3] === 1);
+i16[0] = undefined;
+assert(i16[0] === 0);
+
+// views share a buffer
+var buffer = new ArrayBuffer(8);
+var bytes = new Uint8Array(buffer);
+var words = new Uint32Array(buffer, 4, 1);
+words[0] = 0x01020304;
+assert(bytes[4] + bytes[5] + bytes[6] + bytes[7] === 10);
+assert(words[1] === undefined);
+
+// subclasses
+class Bytes extends Uint8Array {
+}
+var b = new Bytes(2);
+b[1] = 300;
+assert(b[1] === 44 && b[2] === undefined);
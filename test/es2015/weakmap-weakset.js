@@ -0,0 +1,54 @@
+/* Copyright 2019-present Samsung Electronics Co., Ltd. and other contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+var weakMap = new WeakMap();
+var weakSet = new WeakSet();
+var keys = [];
+
+for (var i = 0; i < 1000; i++) {
+  var key = {};
+  keys.push(key);
+  weakMap.set(key, i);
+  weakSet.add(key);
+  // these keys are dropped right away
+  weakMap.set({}, i);
+  weakSet.add({});
+}
+
+for (var i = 0; i < 1000; i++) {
+  assert(weakMap.get(keys[i]) === i);
+  assert(weakSet.has(keys[i]));
+}
+
+assert(!weakMap.has({}));
+assert(!weakSet.has({}));
+
+for (var i = 0; i < 1000; i += 2) {
+  assert(weakMap.delete(keys[i]));
+  assert(weakSet.delete(keys[i]));
+}
+
+for (var i = 0; i < 1000; i++) {
+  assert(weakMap.has(keys[i]) === (i % 2 === 1));
+  assert(weakSet.has(keys[i]) === (i % 2 === 1));
+}
+
+assert(!weakMap.delete(keys[0]));
+weakMap.set(keys[0], 'again');
+assert(weakMap.get(keys[0]) === 'again');
+weakMap.set(keys[1], 'updated');
+assert(weakMap.get(keys[1]) === 'updated');